@@ -64,6 +64,7 @@
 #define IPX_ERR_BAYER_INVALID_ARGUMENT IPX_ERR(IPX_CMP_BAYER_DEMOSAICING, IPX_ERR_INVALID_ARGUMENT)
 #define IPX_ERR_BAYER_UNKNOWN          IPX_ERR(IPX_CMP_BAYER_DEMOSAICING, IPX_ERR_UNKNOWN)
 #define IPX_ERR_BAYER_NO_MEMORY        IPX_ERR(IPX_CMP_BAYER_DEMOSAICING, IPX_ERR_NOT_ENOUGH_MEMORY)
+#define IPX_ERR_BAYER_NOT_SUPPORTED    IPX_ERR(IPX_CMP_BAYER_DEMOSAICING, IPX_ERR_NOT_SUPPORTED)
 
 /**
 \defgroup ipxdemosaicing Imperx Demosaicing SDK Overview
@@ -88,12 +89,28 @@ RGB or BGR bitmaps with respectively 8 and 16 bits color depth.
 <table>
         <caption id="bayer_params">DeBayer Parameters</caption>
 		<tr><th>Macro<th>Parameter Name<th>Type and Range<th>Description
-		<tr><td rowspan="1"><b>DEBAYER_ALGO_TYPE</b><td>"BayerAlgType"<td>[int: 0,4]<td>Bayer Algorithm Type
+		<tr><td rowspan="1"><b>DEBAYER_ALGO_TYPE</b><td>"BayerAlgType"<td>[int: 0,5]<td>Bayer Algorithm Type
 		<tr><td rowspan="1"><b>DEBAYER_NOREALLOCT</b><td>"NoRealloc"<td>[int: 0,1]<td>No Realloc enabled
+		<tr><td rowspan="1"><b>DEBAYER_THREADS_NUM</b><td>"threads_num"<td>[int: 0-32]<td>Quantity of threads used by one conversion including the calling thread. Default value is 0, it means maximum number of available threads. IpxBayerCpu only
+		<tr><td rowspan="1"><b>DEBAYER_SHARED_POOL</b><td>"shared_pool"<td>[int: 0,1]<td>Use the worker threads shared by all the components of the process instead of the own threads. IpxBayerCpu only
+		<tr><td rowspan="1"><b>DEBAYER_FORCE_ISA</b><td>"ForceIsa"<td>[int: 0,4]<td>Instruction set of the CPU kernels, 0 - automatic. IpxBayerCpu only
+		<tr><td rowspan="1"><b>DEBAYER_ACTIVE_ISA</b><td>"ActiveIsa"<td>[int: 1,4]<td>Instruction set used by the CPU kernels, read-only. IpxBayerCpu only
+		<tr><td rowspan="1"><b>DEBAYER_PYRAMID_LEVELS</b><td>"PyramidLevels"<td>[int: 1,4]<td>Number of the levels 1/2, 1/4, 1/8, 1/16 of the source. IpxBayerPyramid only
+		<tr><td rowspan="1"><b>DEBAYER_OUTPUT_LAYOUT</b><td>"OutputLayout"<td>[int: 0,3]<td>Layout of the output data, one of BAYER_LAYOUT_INTERLEAVED ... BAYER_LAYOUT_NV12. IpxBayerCpu only
+		<tr><td rowspan="1"><b>DEBAYER_NORM_MEAN</b><td>"NormMean"<td>[array: 3 float]<td>Per-channel R, G, B mean of BAYER_LAYOUT_PLANAR_FLOAT, 0 by default. IpxBayerCpu only
+		<tr><td rowspan="1"><b>DEBAYER_NORM_STD</b><td>"NormStd"<td>[array: 3 float]<td>Per-channel R, G, B standard deviation of BAYER_LAYOUT_PLANAR_FLOAT, 1 by default. IpxBayerCpu only
 </table>*/
 
-#define DEBAYER_ALGO_TYPE	"BayerAlgType"	/*!< Bayer Algorithm Type\n\n<b>Type/Range</b>    [int: 0,4]  \note Used by SetParamInt and GetParamInt*/
+#define DEBAYER_ALGO_TYPE	"BayerAlgType"	/*!< Bayer Algorithm Type\n\n<b>Type/Range</b>    [int: 0,5]  \note Used by SetParamInt and GetParamInt*/
 #define DEBAYER_NOREALLOCT 	"NoRealloc"		/*!< No Realloc enabled\n\n<b>Type/Range</b>    [int: 0,1]  \note Used by SetParamInt and GetParamInt*/
+#define DEBAYER_THREADS_NUM	"threads_num"	/*!< Quantity of threads used by one conversion including the calling thread. Default value is 0, it means maximum number of available threads\n\n<b>Type/Range</b>    [int: 0-32]  \note Used by SetParamInt and GetParamInt of IpxBayerCpu*/
+#define DEBAYER_SHARED_POOL	"shared_pool"	/*!< Use the worker threads shared by all the components of the process instead of the own threads\n\n<b>Type/Range</b>    [int: 0,1]  \note Used by SetParamInt and GetParamInt of IpxBayerCpu*/
+#define DEBAYER_FORCE_ISA	"ForceIsa"		/*!< Instruction set of the CPU kernels, BAYER_ISA_AUTO by default\n\n<b>Type/Range</b>    [int: 0,4]  \note Used by SetParamInt and GetParamInt of IpxBayerCpu*/
+#define DEBAYER_ACTIVE_ISA	"ActiveIsa"		/*!< Instruction set used by the CPU kernels\n\n<b>Type/Range</b>    [int: 1,4]  \note Used by GetParamInt of IpxBayerCpu*/
+#define DEBAYER_PYRAMID_LEVELS	"PyramidLevels"	/*!< Number of the levels 1/2, 1/4, 1/8, 1/16 of the source, 3 by default\n\n<b>Type/Range</b>    [int: 1,4]  \note Used by SetParamInt and GetParamInt of IpxBayerPyramid*/
+#define DEBAYER_OUTPUT_LAYOUT	"OutputLayout"	/*!< Layout of the output data, BAYER_LAYOUT_INTERLEAVED by default\n\n<b>Type/Range</b>    [int: 0,3]  \note Used by SetParamInt and GetParamInt of IpxBayerCpu*/
+#define DEBAYER_NORM_MEAN	"NormMean"		/*!< Per-channel R, G, B mean of the normalized float output\n\n<b>Type/Range</b>    [array: 3 float]  \note Used by SetParamArray and GetParamArray of IpxBayerCpu*/
+#define DEBAYER_NORM_STD	"NormStd"		/*!< Per-channel R, G, B standard deviation of the normalized float output, not 0\n\n<b>Type/Range</b>    [array: 3 float]  \note Used by SetParamArray and GetParamArray of IpxBayerCpu*/
 /*! @}*/
 
 /// Type of DeBayer Algorithms
@@ -114,6 +131,33 @@ RGB or BGR bitmaps with respectively 8 and 16 bits color depth.
 #define BAYER_EA			2	/**< Edge-Aware Demosaicing. Average quality, medium speed. */
 #define BAYER_OPENGL_MHC    3	/**< OpenGL MHC Algorithm. */
 #define BAYER_OPENGL_MMA    4	/**< OpenGL MMA Algorithm. */
+#define BAYER_MHC           5	/**< CPU Malvar-He-Cutler algorithm of IpxBayerCpu. High quality, multi-threaded, matches BAYER_OPENGL_MHC within 1 code value. */
+/*! @}*/
+
+/// Instruction sets of the CPU demosaicing kernels
+/*! \addtogroup debayer2 DeBayer CPU Instruction Sets
+ \brief Defines the instruction sets of the IpxBayerCpu kernels
+ \note These values are used to program the DEBAYER_FORCE_ISA parameter. The instruction set not supported
+ by the CPU is rejected with IPX_ERR_BAYER_NOT_SUPPORTED. All the levels produce the same output.
+ *  @{*/
+#define BAYER_ISA_AUTO		0	/**< The highest instruction set supported by the CPU. */
+#define BAYER_ISA_SCALAR	1	/**< Portable C++ code. */
+#define BAYER_ISA_SSE41		2	/**< SSE4.1 kernels, 128-bit vectors. */
+#define BAYER_ISA_AVX2		3	/**< AVX2 kernels, 256-bit vectors. */
+#define BAYER_ISA_AVX512	4	/**< AVX-512 BW kernels, 512-bit vectors. */
+/*! @}*/
+
+/// Layouts of the IpxBayerCpu output
+/*! \addtogroup debayer3 DeBayer Output Layouts
+ \brief Defines the layouts of the IpxBayerCpu output data
+ \note These values are used to program the DEBAYER_OUTPUT_LAYOUT parameter. The planar layouts keep the planes
+ one after another without padding, rowSize is the row of one plane and the pixel type (RGB or BGR) gives the order
+ of the planes, so the data is the CHW tensor of the inference runtimes.
+ *  @{*/
+#define BAYER_LAYOUT_INTERLEAVED	0	/**< The interleaved pixels of the output pixel type. */
+#define BAYER_LAYOUT_PLANAR			1	/**< 3 planes of RGB8, BGR8 or the 16-bit RGB and BGR channels. */
+#define BAYER_LAYOUT_PLANAR_FLOAT	2	/**< 3 planes of float (value / max - mean) / std, the pixel type is RGB8 or BGR8. */
+#define BAYER_LAYOUT_NV12			3	/**< The Y plane and the interleaved UV plane of the half height, BT.601 limited range, II_PIX_MONO8 of the even width and height. */
 /*! @}*/
 
 #ifdef __cplusplus
@@ -0,0 +1,1395 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Imaging API SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxBayerCpu.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Header-only IpxBayer component with the SIMD CPU demosaicing kernels
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _IPX_BAYER_CPU_H_
+#define _IPX_BAYER_CPU_H_
+
+#include "IpxBayer.h"
+#include "IpxToolsImpl.h"
+#include "IpxUnpackCpu.h"
+
+#ifdef __cplusplus
+
+#include <cstring>
+#include <climits>
+#include <vector>
+#include <algorithm>
+#include <new>
+#include <memory>
+
+/*! \namespace IpxBayerKernels
+	\brief A namespace provides the CPU demosaicing kernels of IpxBayerCpu.
+
+	\details Every row of the Bayer CFA has one color X (red or blue) and green, the rows above and below have
+	the other color Y and green. The kernels interpolate the planar X, G and Y values of the row:
+	- X site: X is the own value, G is the average of the 4 greens, Y is the average of the 4 diagonal neighbours
+	- G site: X is the average of the left and right neighbours, G is the own value, Y is the average of the upper and lower ones
+
+	BAYER_GRADIENT interpolates the green at the X site along the direction with the smaller difference of the green
+	neighbours and uses the average of 4 only if both differences are equal.
+
+	The averages are the rounded halving additions (a + b + 1) / 2 nested in the same order by the scalar and the vector
+	code, so all the instruction set levels produce bit-exact results. The image border is mirrored.
+*/
+namespace IpxBayerKernels
+{
+	//! Bayer CFA orders, the colors of the top-left 2x2 cell
+	enum CfaOrder
+	{
+		CfaGR = 0,
+		CfaRG = 1,
+		CfaGB = 2,
+		CfaBG = 3
+	};
+
+	//! Returns the CFA order and the bits per pixel (8 or 16) of the Bayer pixel type
+	inline bool GetCfa( uint32_t pixelType, int *cfa, int *bits )
+	{
+		switch (pixelType)
+		{
+		case II_PIX_BAYGR8: *cfa = CfaGR; *bits = 8; return true;
+		case II_PIX_BAYRG8: *cfa = CfaRG; *bits = 8; return true;
+		case II_PIX_BAYGB8: *cfa = CfaGB; *bits = 8; return true;
+		case II_PIX_BAYBG8: *cfa = CfaBG; *bits = 8; return true;
+		case II_PIX_BAYGR10: case II_PIX_BAYGR12: case II_PIX_BAYGR14: case II_PIX_BAYGR16: *cfa = CfaGR; *bits = 16; return true;
+		case II_PIX_BAYRG10: case II_PIX_BAYRG12: case II_PIX_BAYRG14: case II_PIX_BAYRG16: *cfa = CfaRG; *bits = 16; return true;
+		case II_PIX_BAYGB10: case II_PIX_BAYGB12: case II_PIX_BAYGB14: case II_PIX_BAYGB16: *cfa = CfaGB; *bits = 16; return true;
+		case II_PIX_BAYBG10: case II_PIX_BAYBG12: case II_PIX_BAYBG14: case II_PIX_BAYBG16: *cfa = CfaBG; *bits = 16; return true;
+		default: return false;
+		}
+	}
+
+	//! Returns true if the X color of the row is red
+	inline bool IsRedRow( int cfa, int y )
+	{
+		// GR and RG have red in the even rows, GB and BG in the odd ones
+		return ((cfa == CfaGR || cfa == CfaRG) ? 0 : 1) == (y & 1);
+	}
+
+	//! Returns true if the X color of the row is in the even columns
+	inline bool IsXEven( int cfa, int y )
+	{
+		// RG and BG start with the color, GR and GB with green, the next row is shifted by one
+		return ((cfa == CfaRG || cfa == CfaBG) ? 0 : 1) == (y & 1);
+	}
+
+	// The helpers return the vectors by reference: the vector returned by value changes the ABI without AVX,
+	// though the helpers are always inlined to the kernels compiled for the target instruction set
+
+	template<typename L> IPX_FORCE_INLINE void Avg( L &r, const L &a, const L &b ) { r = (a | b) - ((a ^ b) >> 1); }
+	template<typename L> IPX_FORCE_INLINE void Select( L &r, const L &mask, const L &a, const L &b ) { r = (a & mask) | (b & ~mask); }
+
+	// all ones where a > b, the vector comparison returns the signed lanes of the same width
+	template<typename L> IPX_FORCE_INLINE void Greater( L &r, const L &a, const L &b ) { r = (L)(a > b); }
+	inline void Greater( uint8_t &r, const uint8_t &a, const uint8_t &b ) { r = a > b ? 0xFF : 0; }
+	inline void Greater( uint16_t &r, const uint16_t &a, const uint16_t &b ) { r = a > b ? 0xFFFF : 0; }
+	inline void Greater( int16_t &r, const int16_t &a, const int16_t &b ) { r = a > b ? -1 : 0; }
+	inline void Greater( int32_t &r, const int32_t &a, const int32_t &b ) { r = a > b ? -1 : 0; }
+
+	template<typename L> IPX_FORCE_INLINE void AbsDiff( L &r, const L &a, const L &b )
+	{
+		L gt;
+		Greater(gt, a, b);
+		Select<L>(r, gt, a - b, b - a);
+	}
+
+	template<typename L, typename T> IPX_FORCE_INLINE void Load( L &v, const T *p ) { memcpy(&v, p, sizeof(L)); }
+
+	//! Interpolates X, G and Y of the pixels, site is all ones for the X sites
+	template<int ALG, typename L>
+	IPX_FORCE_INLINE void Interpolate( const L &site, const L &ul, const L &uc, const L &ur, const L &cl, const L &cc, const L &cr,
+		const L &dl, const L &dc, const L &dr, L &x, L &g, L &y )
+	{
+		L h, v, c, d, du, dd;
+		Avg(h, cl, cr);
+		Avg(v, uc, dc);
+		Avg(c, h, v);
+		Avg(du, ul, ur);
+		Avg(dd, dl, dr);
+		Avg(d, du, dd);
+		L gx = c;
+		if (ALG == BAYER_GRADIENT)
+		{
+			L dh, dv, hv, vh;
+			AbsDiff(dh, cl, cr);
+			AbsDiff(dv, uc, dc);
+			Greater(vh, dv, dh);
+			Greater(hv, dh, dv);
+			Select(gx, hv, v, c);
+			Select(gx, vh, h, gx);
+		}
+		Select(x, site, cc, h);
+		Select(g, site, gx, cc);
+		Select(y, site, d, v);
+	}
+
+	//! Limits the values to [0, maxValue]
+	template<typename L> IPX_FORCE_INLINE void Clamp( L &r, const L &v, const L &maxValue )
+	{
+		const L zero = L();
+		L m;
+		Greater(m, v, maxValue);
+		Select(r, m, maxValue, v);
+		Greater(m, zero, r);
+		Select(r, m, zero, r);
+	}
+
+	//! Malvar-He-Cutler interpolation of the pixels in the signed working type, the 5x5 weights are scaled to the
+	//! integers with the denominators 8 and 16, the sums are rounded and clamped
+	template<typename L>
+	IPX_FORCE_INLINE void InterpolateMhc( const L &site, const L &maxValue, const L &c,
+		const L &n, const L &s, const L &e, const L &w, const L &nn, const L &ss, const L &ee, const L &ww,
+		const L &ne, const L &nw, const L &se, const L &sw, L &x, L &g, L &y )
+	{
+		const L h1 = e + w, v1 = n + s, h2 = ee + ww, v2 = nn + ss;
+		const L cross2 = h2 + v2, diag = ne + nw + se + sw;
+
+		// X site: G = (4C + 2(N+S+E+W) - (NN+SS+EE+WW)) / 8, Y = (6C + 2 diag - 1.5(NN+SS+EE+WW)) / 8
+		const L gx = ((c << 2) + ((h1 + v1) << 1) - cross2 + 4) >> 3;
+		const L yx = (c * 12 + (diag << 2) - cross2 * 3 + 8) >> 4;
+		// G site: the color of the row from E and W, the other one from N and S, (5C + 4 near - far - diag + far / 2) / 8
+		const L xg = (c * 10 + (h1 << 3) - (h2 << 1) - (diag << 1) + v2 + 8) >> 4;
+		const L yg = (c * 10 + (v1 << 3) - (v2 << 1) - (diag << 1) + h2 + 8) >> 4;
+
+		L t;
+		Select(t, site, c, xg);
+		Clamp(x, t, maxValue);
+		Select(t, site, gx, c);
+		Clamp(g, t, maxValue);
+		Select(t, site, yx, yg);
+		Clamp(y, t, maxValue);
+	}
+
+	//! Interpolates n pixels of the row, the source rows are readable at [-1, n]
+	template<typename T, int ALG>
+	inline void RowScalar( const T *up, const T *cur, const T *dn, T *x, T *g, T *y, int n, bool xEven )
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			const T site = (((i & 1) == 0) == xEven) ? T(~T(0)) : T(0);
+			Interpolate<ALG, T>(site, up[i - 1], up[i], up[i + 1], cur[i - 1], cur[i], cur[i + 1], dn[i - 1], dn[i], dn[i + 1],
+				x[i], g[i], y[i]);
+		}
+	}
+
+	//! Vector variant of RowScalar, n is rounded up to the vector, so the rows must be readable and the outputs writable
+	//! for the vector width past n
+	template<typename T, int VB, int ALG>
+	IPX_FORCE_INLINE void RowVector( const T *up, const T *cur, const T *dn, T *x, T *g, T *y, int n, bool xEven )
+	{
+		typedef T L __attribute__((vector_size(VB)));
+		const int lanes = VB / sizeof(T);
+
+		L site;
+		for (int i = 0; i < lanes; ++i)
+			site[i] = (((i & 1) == 0) == xEven) ? T(~T(0)) : T(0);
+
+		for (int i = 0; i < n; i += lanes)
+		{
+			L ul, uc, ur, cl, cc, cr, dl, dc, dr, ox, og, oy;
+			Load(ul, up + i - 1); Load(uc, up + i); Load(ur, up + i + 1);
+			Load(cl, cur + i - 1); Load(cc, cur + i); Load(cr, cur + i + 1);
+			Load(dl, dn + i - 1); Load(dc, dn + i); Load(dr, dn + i + 1);
+			Interpolate<ALG, L>(site, ul, uc, ur, cl, cc, cr, dl, dc, dr, ox, og, oy);
+			memcpy(x + i, &ox, sizeof(L));
+			memcpy(g + i, &og, sizeof(L));
+			memcpy(y + i, &oy, sizeof(L));
+		}
+	}
+
+	//! MHC variant of RowScalar, r are the rows y-2...y+2 readable at [-2, n+1]
+	template<typename W>
+	inline void RowMhcScalar( const W *const *r, W *x, W *g, W *y, int n, bool xEven, W maxValue )
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			const W site = (((i & 1) == 0) == xEven) ? W(-1) : W(0);
+			InterpolateMhc<W>(site, maxValue, r[2][i], r[1][i], r[3][i], r[2][i + 1], r[2][i - 1], r[0][i], r[4][i], r[2][i + 2], r[2][i - 2],
+				r[1][i + 1], r[1][i - 1], r[3][i + 1], r[3][i - 1], x[i], g[i], y[i]);
+		}
+	}
+
+	//! Vector variant of RowMhcScalar, the rows must be readable and the outputs writable for the vector width past n
+	template<typename W, int VB>
+	IPX_FORCE_INLINE void RowMhcVector( const W *const *r, W *x, W *g, W *y, int n, bool xEven, W maxValue )
+	{
+		typedef W L __attribute__((vector_size(VB)));
+		const int lanes = VB / sizeof(W);
+
+		L site;
+		for (int i = 0; i < lanes; ++i)
+			site[i] = (((i & 1) == 0) == xEven) ? W(-1) : W(0);
+		const L maxV = L() + maxValue;
+
+		for (int i = 0; i < n; i += lanes)
+		{
+			L c, vn, vs, ve, vw, nn, ss, ee, ww, ne, nw, se, sw, ox, og, oy;
+			Load(nn, r[0] + i);
+			Load(nw, r[1] + i - 1); Load(vn, r[1] + i); Load(ne, r[1] + i + 1);
+			Load(ww, r[2] + i - 2); Load(vw, r[2] + i - 1); Load(c, r[2] + i); Load(ve, r[2] + i + 1); Load(ee, r[2] + i + 2);
+			Load(sw, r[3] + i - 1); Load(vs, r[3] + i); Load(se, r[3] + i + 1);
+			Load(ss, r[4] + i);
+			InterpolateMhc<L>(site, maxV, c, vn, vs, ve, vw, nn, ss, ee, ww, ne, nw, se, sw, ox, og, oy);
+			memcpy(x + i, &ox, sizeof(L));
+			memcpy(g + i, &og, sizeof(L));
+			memcpy(y + i, &oy, sizeof(L));
+		}
+	}
+
+	//! Converts the source row to the signed working type of MHC
+	template<typename T, typename W>
+	inline void WidenScalar( const T *src, W *dst, int n )
+	{
+		for (int i = 0; i < n; ++i)
+			dst[i] = static_cast<W>(src[i]);
+	}
+
+	//! Converts the clamped MHC results back to the pixel type
+	template<typename W, typename T>
+	inline void NarrowScalar( const W *src, T *dst, int n )
+	{
+		for (int i = 0; i < n; ++i)
+			dst[i] = static_cast<T>(src[i]);
+	}
+
+	//! Writes the planar channels to the interleaved 3-channel row
+	template<typename T>
+	inline void Interleave3Scalar( const T *c0, const T *c1, const T *c2, T *dst, int n )
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			dst[3 * i] = c0[i];
+			dst[3 * i + 1] = c1[i];
+			dst[3 * i + 2] = c2[i];
+		}
+	}
+
+	//! Writes the planar channels to the interleaved 4-channel row with the opaque alpha
+	template<typename T>
+	inline void Interleave4Scalar( const T *c0, const T *c1, const T *c2, T *dst, int n )
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			dst[4 * i] = c0[i];
+			dst[4 * i + 1] = c1[i];
+			dst[4 * i + 2] = c2[i];
+			dst[4 * i + 3] = T(~T(0));
+		}
+	}
+
+#if IPX_TOOLS_X86_DISPATCH
+	template<typename T, int ALG> IPX_TARGET_SSE41
+	void RowSse41( const T *up, const T *cur, const T *dn, T *x, T *g, T *y, int n, bool xEven ) { RowVector<T, 16, ALG>(up, cur, dn, x, g, y, n, xEven); }
+
+	template<typename T, int ALG> IPX_TARGET_AVX2
+	void RowAvx2( const T *up, const T *cur, const T *dn, T *x, T *g, T *y, int n, bool xEven ) { RowVector<T, 32, ALG>(up, cur, dn, x, g, y, n, xEven); }
+
+	template<typename T, int ALG> IPX_TARGET_AVX512
+	void RowAvx512( const T *up, const T *cur, const T *dn, T *x, T *g, T *y, int n, bool xEven ) { RowVector<T, 64, ALG>(up, cur, dn, x, g, y, n, xEven); }
+
+	// 16 pixels of 8 bits to 48 bytes, each output vector gathers its bytes from the 3 channels by pshufb
+	IPX_TARGET_SSE41 inline void Interleave3Sse( const uint8_t *c0, const uint8_t *c1, const uint8_t *c2, uint8_t *dst, int n )
+	{
+		const __m128i m00 = _mm_setr_epi8(0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1, 5);
+		const __m128i m01 = _mm_setr_epi8(-1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1);
+		const __m128i m02 = _mm_setr_epi8(-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1);
+		const __m128i m10 = _mm_setr_epi8(-1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10, -1);
+		const __m128i m11 = _mm_setr_epi8(5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10);
+		const __m128i m12 = _mm_setr_epi8(-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1);
+		const __m128i m20 = _mm_setr_epi8(-1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1, -1);
+		const __m128i m21 = _mm_setr_epi8(-1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1);
+		const __m128i m22 = _mm_setr_epi8(10, -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15);
+		int i = 0;
+		for (; i + 16 <= n; i += 16)
+		{
+			const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c0 + i));
+			const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c1 + i));
+			const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c2 + i));
+			__m128i *out = reinterpret_cast<__m128i*>(dst + 3 * i);
+			_mm_storeu_si128(out, _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, m00), _mm_shuffle_epi8(b, m01)), _mm_shuffle_epi8(c, m02)));
+			_mm_storeu_si128(out + 1, _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, m10), _mm_shuffle_epi8(b, m11)), _mm_shuffle_epi8(c, m12)));
+			_mm_storeu_si128(out + 2, _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, m20), _mm_shuffle_epi8(b, m21)), _mm_shuffle_epi8(c, m22)));
+		}
+		Interleave3Scalar(c0 + i, c1 + i, c2 + i, dst + 3 * i, n - i);
+	}
+
+	// 8 pixels of 16 bits to 48 bytes
+	IPX_TARGET_SSE41 inline void Interleave3Sse( const uint16_t *c0, const uint16_t *c1, const uint16_t *c2, uint16_t *dst, int n )
+	{
+		const __m128i m00 = _mm_setr_epi8(0, 1, -1, -1, -1, -1, 2, 3, -1, -1, -1, -1, 4, 5, -1, -1);
+		const __m128i m01 = _mm_setr_epi8(-1, -1, 0, 1, -1, -1, -1, -1, 2, 3, -1, -1, -1, -1, 4, 5);
+		const __m128i m02 = _mm_setr_epi8(-1, -1, -1, -1, 0, 1, -1, -1, -1, -1, 2, 3, -1, -1, -1, -1);
+		const __m128i m10 = _mm_setr_epi8(-1, -1, 6, 7, -1, -1, -1, -1, 8, 9, -1, -1, -1, -1, 10, 11);
+		const __m128i m11 = _mm_setr_epi8(-1, -1, -1, -1, 6, 7, -1, -1, -1, -1, 8, 9, -1, -1, -1, -1);
+		const __m128i m12 = _mm_setr_epi8(4, 5, -1, -1, -1, -1, 6, 7, -1, -1, -1, -1, 8, 9, -1, -1);
+		const __m128i m20 = _mm_setr_epi8(-1, -1, -1, -1, 12, 13, -1, -1, -1, -1, 14, 15, -1, -1, -1, -1);
+		const __m128i m21 = _mm_setr_epi8(10, 11, -1, -1, -1, -1, 12, 13, -1, -1, -1, -1, 14, 15, -1, -1);
+		const __m128i m22 = _mm_setr_epi8(-1, -1, 10, 11, -1, -1, -1, -1, 12, 13, -1, -1, -1, -1, 14, 15);
+		int i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c0 + i));
+			const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c1 + i));
+			const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c2 + i));
+			__m128i *out = reinterpret_cast<__m128i*>(dst + 3 * i);
+			_mm_storeu_si128(out, _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, m00), _mm_shuffle_epi8(b, m01)), _mm_shuffle_epi8(c, m02)));
+			_mm_storeu_si128(out + 1, _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, m10), _mm_shuffle_epi8(b, m11)), _mm_shuffle_epi8(c, m12)));
+			_mm_storeu_si128(out + 2, _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, m20), _mm_shuffle_epi8(b, m21)), _mm_shuffle_epi8(c, m22)));
+		}
+		Interleave3Scalar(c0 + i, c1 + i, c2 + i, dst + 3 * i, n - i);
+	}
+
+	// 16 pixels of 8 bits to 64 bytes by two levels of unpacking
+	IPX_TARGET_SSE41 inline void Interleave4Sse( const uint8_t *c0, const uint8_t *c1, const uint8_t *c2, uint8_t *dst, int n )
+	{
+		const __m128i alpha = _mm_set1_epi8(-1);
+		int i = 0;
+		for (; i + 16 <= n; i += 16)
+		{
+			const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c0 + i));
+			const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c1 + i));
+			const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c2 + i));
+			const __m128i abLo = _mm_unpacklo_epi8(a, b), abHi = _mm_unpackhi_epi8(a, b);
+			const __m128i caLo = _mm_unpacklo_epi8(c, alpha), caHi = _mm_unpackhi_epi8(c, alpha);
+			__m128i *out = reinterpret_cast<__m128i*>(dst + 4 * i);
+			_mm_storeu_si128(out, _mm_unpacklo_epi16(abLo, caLo));
+			_mm_storeu_si128(out + 1, _mm_unpackhi_epi16(abLo, caLo));
+			_mm_storeu_si128(out + 2, _mm_unpacklo_epi16(abHi, caHi));
+			_mm_storeu_si128(out + 3, _mm_unpackhi_epi16(abHi, caHi));
+		}
+		Interleave4Scalar(c0 + i, c1 + i, c2 + i, dst + 4 * i, n - i);
+	}
+
+	// the 4-channel outputs are 8-bit only
+	inline void Interleave4Sse( const uint16_t *c0, const uint16_t *c1, const uint16_t *c2, uint16_t *dst, int n )
+	{
+		Interleave4Scalar(c0, c1, c2, dst, n);
+	}
+
+	template<typename W> IPX_TARGET_SSE41
+	void RowMhcSse41( const W *const *r, W *x, W *g, W *y, int n, bool xEven, W maxValue ) { RowMhcVector<W, 16>(r, x, g, y, n, xEven, maxValue); }
+
+	template<typename W> IPX_TARGET_AVX2
+	void RowMhcAvx2( const W *const *r, W *x, W *g, W *y, int n, bool xEven, W maxValue ) { RowMhcVector<W, 32>(r, x, g, y, n, xEven, maxValue); }
+
+	template<typename W> IPX_TARGET_AVX512
+	void RowMhcAvx512( const W *const *r, W *x, W *g, W *y, int n, bool xEven, W maxValue ) { RowMhcVector<W, 64>(r, x, g, y, n, xEven, maxValue); }
+
+	IPX_TARGET_SSE41 inline void WidenSse( const uint8_t *src, int16_t *dst, int n )
+	{
+		int i = 0;
+		for (; i + 8 <= n; i += 8)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i))));
+		WidenScalar(src + i, dst + i, n - i);
+	}
+
+	IPX_TARGET_SSE41 inline void WidenSse( const uint16_t *src, int32_t *dst, int n )
+	{
+		int i = 0;
+		for (; i + 4 <= n; i += 4)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i))));
+		WidenScalar(src + i, dst + i, n - i);
+	}
+
+	IPX_TARGET_SSE41 inline void NarrowSse( const int16_t *src, uint8_t *dst, int n )
+	{
+		int i = 0;
+		for (; i + 16 <= n; i += 16)
+		{
+			const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+		}
+		NarrowScalar(src + i, dst + i, n - i);
+	}
+
+	IPX_TARGET_SSE41 inline void NarrowSse( const int32_t *src, uint16_t *dst, int n )
+	{
+		int i = 0;
+		for (; i + 8 <= n; i += 8)
+		{
+			const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 4));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi32(lo, hi));
+		}
+		NarrowScalar(src + i, dst + i, n - i);
+	}
+
+	// AVX2 shuffles within the 128-bit lanes, so the lanes hold the pixels 0-15 and 16-31 of the SSE layout
+	// and the 128-bit halves are reordered before the store
+	template<typename T> IPX_TARGET_AVX2 IPX_FORCE_INLINE void Store3Avx2( T *dst, __m256i o0, __m256i o1, __m256i o2 )
+	{
+		__m256i *out = reinterpret_cast<__m256i*>(dst);
+		_mm256_storeu_si256(out, _mm256_permute2x128_si256(o0, o1, 0x20));
+		_mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(o2, o0, 0x30));
+		_mm256_storeu_si256(out + 2, _mm256_permute2x128_si256(o1, o2, 0x31));
+	}
+
+	IPX_TARGET_AVX2 inline void Interleave3Avx2( const uint8_t *c0, const uint8_t *c1, const uint8_t *c2, uint8_t *dst, int n )
+	{
+		const __m256i m00 = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1, 5));
+		const __m256i m01 = _mm256_broadcastsi128_si256(_mm_setr_epi8(-1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1));
+		const __m256i m02 = _mm256_broadcastsi128_si256(_mm_setr_epi8(-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1));
+		const __m256i m10 = _mm256_broadcastsi128_si256(_mm_setr_epi8(-1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10, -1));
+		const __m256i m11 = _mm256_broadcastsi128_si256(_mm_setr_epi8(5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10));
+		const __m256i m12 = _mm256_broadcastsi128_si256(_mm_setr_epi8(-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1));
+		const __m256i m20 = _mm256_broadcastsi128_si256(_mm_setr_epi8(-1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1, -1));
+		const __m256i m21 = _mm256_broadcastsi128_si256(_mm_setr_epi8(-1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1));
+		const __m256i m22 = _mm256_broadcastsi128_si256(_mm_setr_epi8(10, -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15));
+		int i = 0;
+		for (; i + 32 <= n; i += 32)
+		{
+			const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c0 + i));
+			const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c1 + i));
+			const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c2 + i));
+			Store3Avx2(dst + 3 * i,
+				_mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(a, m00), _mm256_shuffle_epi8(b, m01)), _mm256_shuffle_epi8(c, m02)),
+				_mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(a, m10), _mm256_shuffle_epi8(b, m11)), _mm256_shuffle_epi8(c, m12)),
+				_mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(a, m20), _mm256_shuffle_epi8(b, m21)), _mm256_shuffle_epi8(c, m22)));
+		}
+		Interleave3Sse(c0 + i, c1 + i, c2 + i, dst + 3 * i, n - i);
+	}
+
+	IPX_TARGET_AVX2 inline void Interleave3Avx2( const uint16_t *c0, const uint16_t *c1, const uint16_t *c2, uint16_t *dst, int n )
+	{
+		const __m256i m00 = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 1, -1, -1, -1, -1, 2, 3, -1, -1, -1, -1, 4, 5, -1, -1));
+		const __m256i m01 = _mm256_broadcastsi128_si256(_mm_setr_epi8(-1, -1, 0, 1, -1, -1, -1, -1, 2, 3, -1, -1, -1, -1, 4, 5));
+		const __m256i m02 = _mm256_broadcastsi128_si256(_mm_setr_epi8(-1, -1, -1, -1, 0, 1, -1, -1, -1, -1, 2, 3, -1, -1, -1, -1));
+		const __m256i m10 = _mm256_broadcastsi128_si256(_mm_setr_epi8(-1, -1, 6, 7, -1, -1, -1, -1, 8, 9, -1, -1, -1, -1, 10, 11));
+		const __m256i m11 = _mm256_broadcastsi128_si256(_mm_setr_epi8(-1, -1, -1, -1, 6, 7, -1, -1, -1, -1, 8, 9, -1, -1, -1, -1));
+		const __m256i m12 = _mm256_broadcastsi128_si256(_mm_setr_epi8(4, 5, -1, -1, -1, -1, 6, 7, -1, -1, -1, -1, 8, 9, -1, -1));
+		const __m256i m20 = _mm256_broadcastsi128_si256(_mm_setr_epi8(-1, -1, -1, -1, 12, 13, -1, -1, -1, -1, 14, 15, -1, -1, -1, -1));
+		const __m256i m21 = _mm256_broadcastsi128_si256(_mm_setr_epi8(10, 11, -1, -1, -1, -1, 12, 13, -1, -1, -1, -1, 14, 15, -1, -1));
+		const __m256i m22 = _mm256_broadcastsi128_si256(_mm_setr_epi8(-1, -1, 10, 11, -1, -1, -1, -1, 12, 13, -1, -1, -1, -1, 14, 15));
+		int i = 0;
+		for (; i + 16 <= n; i += 16)
+		{
+			const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c0 + i));
+			const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c1 + i));
+			const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c2 + i));
+			Store3Avx2(dst + 3 * i,
+				_mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(a, m00), _mm256_shuffle_epi8(b, m01)), _mm256_shuffle_epi8(c, m02)),
+				_mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(a, m10), _mm256_shuffle_epi8(b, m11)), _mm256_shuffle_epi8(c, m12)),
+				_mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(a, m20), _mm256_shuffle_epi8(b, m21)), _mm256_shuffle_epi8(c, m22)));
+		}
+		Interleave3Sse(c0 + i, c1 + i, c2 + i, dst + 3 * i, n - i);
+	}
+
+	IPX_TARGET_AVX2 inline void Interleave4Avx2( const uint8_t *c0, const uint8_t *c1, const uint8_t *c2, uint8_t *dst, int n )
+	{
+		const __m256i alpha = _mm256_set1_epi8(-1);
+		int i = 0;
+		for (; i + 32 <= n; i += 32)
+		{
+			const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c0 + i));
+			const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c1 + i));
+			const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c2 + i));
+			const __m256i abLo = _mm256_unpacklo_epi8(a, b), abHi = _mm256_unpackhi_epi8(a, b);
+			const __m256i caLo = _mm256_unpacklo_epi8(c, alpha), caHi = _mm256_unpackhi_epi8(c, alpha);
+			const __m256i q0 = _mm256_unpacklo_epi16(abLo, caLo), q1 = _mm256_unpackhi_epi16(abLo, caLo);
+			const __m256i q2 = _mm256_unpacklo_epi16(abHi, caHi), q3 = _mm256_unpackhi_epi16(abHi, caHi);
+			__m256i *out = reinterpret_cast<__m256i*>(dst + 4 * i);
+			_mm256_storeu_si256(out, _mm256_permute2x128_si256(q0, q1, 0x20));
+			_mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(q2, q3, 0x20));
+			_mm256_storeu_si256(out + 2, _mm256_permute2x128_si256(q0, q1, 0x31));
+			_mm256_storeu_si256(out + 3, _mm256_permute2x128_si256(q2, q3, 0x31));
+		}
+		Interleave4Sse(c0 + i, c1 + i, c2 + i, dst + 4 * i, n - i);
+	}
+
+	inline void Interleave4Avx2( const uint16_t *c0, const uint16_t *c1, const uint16_t *c2, uint16_t *dst, int n )
+	{
+		Interleave4Scalar(c0, c1, c2, dst, n);
+	}
+#endif // IPX_TOOLS_X86_DISPATCH
+
+	//! Kernels of the instruction set level
+	template<typename T>
+	struct Kernels
+	{
+		typedef void (*RowFn)( const T*, const T*, const T*, T*, T*, T*, int, bool );
+		typedef void (*InterleaveFn)( const T*, const T*, const T*, T*, int );
+
+		RowFn row;
+		InterleaveFn interleave3;
+		InterleaveFn interleave4;
+	};
+
+	template<typename T, int ALG>
+	inline Kernels<T> GetKernels( int isa )
+	{
+		Kernels<T> k;
+		k.row = &RowScalar<T, ALG>;
+		k.interleave3 = &Interleave3Scalar<T>;
+		k.interleave4 = &Interleave4Scalar<T>;
+#if IPX_TOOLS_X86_DISPATCH
+		if (isa >= IpxToolsImpl::IsaSse41)
+		{
+			k.row = isa >= IpxToolsImpl::IsaAvx512 ? &RowAvx512<T, ALG> : (isa >= IpxToolsImpl::IsaAvx2 ? &RowAvx2<T, ALG> : &RowSse41<T, ALG>);
+			if (isa >= IpxToolsImpl::IsaAvx2)
+			{
+				k.interleave3 = &Interleave3Avx2;
+				k.interleave4 = &Interleave4Avx2;
+			}
+			else
+			{
+				k.interleave3 = &Interleave3Sse;
+				k.interleave4 = &Interleave4Sse;
+			}
+		}
+#else
+		(void)isa;
+#endif
+		return k;
+	}
+
+	template<typename T>
+	inline Kernels<T> GetKernels( int isa, int alg )
+	{
+		return alg == BAYER_GRADIENT ? GetKernels<T, BAYER_GRADIENT>(isa) : GetKernels<T, BAYER_SIMPLE>(isa);
+	}
+
+	//! The signed working type of MHC, wide enough for the weighted sums of the neighbours
+	template<typename T> struct MhcWide;
+	template<> struct MhcWide<uint8_t> { typedef int16_t type; };
+	template<> struct MhcWide<uint16_t> { typedef int32_t type; };
+
+	//! MHC kernels of the instruction set level
+	template<typename T>
+	struct MhcKernels
+	{
+		typedef typename MhcWide<T>::type W;
+		typedef void (*RowFn)( const W *const*, W*, W*, W*, int, bool, W );
+		typedef void (*WidenFn)( const T*, W*, int );
+		typedef void (*NarrowFn)( const W*, T*, int );
+
+		RowFn row;
+		WidenFn widen;
+		NarrowFn narrow;
+	};
+
+	template<typename T>
+	inline MhcKernels<T> GetMhcKernels( int isa )
+	{
+		typedef typename MhcWide<T>::type W;
+		MhcKernels<T> k;
+		(void)isa;
+		k.row = &RowMhcScalar<W>;
+		k.widen = &WidenScalar<T, W>;
+		k.narrow = &NarrowScalar<W, T>;
+#if IPX_TOOLS_X86_DISPATCH
+		if (isa >= IpxToolsImpl::IsaSse41)
+		{
+			k.row = isa >= IpxToolsImpl::IsaAvx512 ? &RowMhcAvx512<W> : (isa >= IpxToolsImpl::IsaAvx2 ? &RowMhcAvx2<W> : &RowMhcSse41<W>);
+			k.widen = &WidenSse;
+			k.narrow = &NarrowSse;
+		}
+#endif
+		return k;
+	}
+
+	//! Returns the CFA order of the packed Bayer pixel type, the rows are unpacked by IpxUnpackKernels
+	inline bool GetPackedCfa( uint32_t pixelType, int *cfa )
+	{
+		switch (pixelType)
+		{
+		case II_PIX_BAYGR10_PACKED_GEV: case II_PIX_BAYGR10_PACKED_PFNC: case II_PIX_BAYGR12_PACKED_GEV: case II_PIX_BAYGR12_PACKED_PFNC:
+			*cfa = CfaGR; return true;
+		case II_PIX_BAYRG10_PACKED_GEV: case II_PIX_BAYRG10_PACKED_PFNC: case II_PIX_BAYRG12_PACKED_GEV: case II_PIX_BAYRG12_PACKED_PFNC:
+			*cfa = CfaRG; return true;
+		case II_PIX_BAYGB10_PACKED_GEV: case II_PIX_BAYGB10_PACKED_PFNC: case II_PIX_BAYGB12_PACKED_GEV: case II_PIX_BAYGB12_PACKED_PFNC:
+			*cfa = CfaGB; return true;
+		case II_PIX_BAYBG10_PACKED_GEV: case II_PIX_BAYBG10_PACKED_PFNC: case II_PIX_BAYBG12_PACKED_GEV: case II_PIX_BAYBG12_PACKED_PFNC:
+			*cfa = CfaBG; return true;
+		default:
+			return false;
+		}
+	}
+
+	//! The Bayer source of the components, the packed one is unpacked to 16 bits per pixel row by row
+	struct Source
+	{
+		int cfa = 0;
+		int bits = 0;		//!< 8 or 16 bits of the pixel in the kernels
+		int depth = 0;		//!< 8...16 significant bits
+		IpxUnpackKernels::Unpack16Fn unpack = nullptr;
+	};
+
+	//! Returns the source of the Bayer pixel type, the unpacker of the packed type is selected for the instruction set
+	inline bool GetSource( uint32_t pixelType, int isa, Source *source )
+	{
+		IpxUnpackKernels::Unpacker unpacker;
+		if (GetPackedCfa(pixelType, &source->cfa) && IpxUnpackKernels::GetUnpacker(pixelType, isa, &unpacker))
+		{
+			source->bits = 16;
+			source->depth = unpacker.depth;
+			source->unpack = unpacker.to16;
+			return true;
+		}
+		if (!GetCfa(pixelType, &source->cfa, &source->bits))
+			return false;
+		switch (source->bits == 8 ? 0 : II_GET_PIXEL_ALIGNMENT(pixelType))
+		{
+		case 0: source->depth = 8; break;
+		case II_ALIGN_10: source->depth = 10; break;
+		case II_ALIGN_12: source->depth = 12; break;
+		case II_ALIGN_14: source->depth = 14; break;
+		default: source->depth = 16; break;
+		}
+		return true;
+	}
+
+	//! Returns true for the 8-bit RGB output types
+	inline bool Is8Bit( uint32_t pixelType )
+	{
+		return pixelType == II_PIX_RGB8 || pixelType == II_PIX_BGR8 || pixelType == II_PIX_RGBA8 || pixelType == II_PIX_BGRA8;
+	}
+
+	//! Returns true for the output types with blue in the first channel
+	inline bool IsBgr( uint32_t pixelType )
+	{
+		return pixelType == II_PIX_BGR8 || pixelType == II_PIX_BGRA8 || pixelType == II_PIX_BGR10 || pixelType == II_PIX_BGR12
+			|| pixelType == II_PIX_BGR14 || pixelType == II_PIX_BGR16;
+	}
+
+	//! Returns the interleaved output type if it is supported for the source, otherwise RGB of the source depth
+	/*!
+	The 8-bit types are supported for all the sources, the 16-bit types for the sources deeper than 8 bits.
+	*/
+	inline uint32_t GetOutputType( const Source &source, uint32_t pixelType )
+	{
+		if (Is8Bit(pixelType))
+			return pixelType;
+		if (source.bits == 8)
+			return II_PIX_RGB8;
+
+		switch (pixelType)
+		{
+		case II_PIX_RGB10: case II_PIX_BGR10: case II_PIX_RGB12: case II_PIX_BGR12:
+		case II_PIX_RGB14: case II_PIX_BGR14: case II_PIX_RGB16: case II_PIX_BGR16:
+			return pixelType;
+		default:
+			break;
+		}
+		switch (source.depth)
+		{
+		case 10: return II_PIX_RGB10;
+		case 12: return II_PIX_RGB12;
+		case 14: return II_PIX_RGB14;
+		default: return II_PIX_RGB16;
+		}
+	}
+
+	//! Shifts the 16-bit values to 8 bits, the loop is vectorized by the compiler
+	inline void ShiftTo8( const uint16_t *src, uint8_t *dst, int n, int shift )
+	{
+		for (int i = 0; i < n; ++i)
+			dst[i] = static_cast<uint8_t>(src[i] >> shift);
+	}
+
+	//! Conversion of one image, the rows can be converted by several calls
+	struct Job
+	{
+		const char *src;
+		size_t srcStride;
+		char *dst;
+		size_t dstStride;
+		int width;
+		int height;
+		int cfa;		//!< CfaOrder
+		int channels;	//!< 3 or 4 channels of the output
+		bool bgr;		//!< blue is the first channel of the output
+		int alg;		//!< BAYER_SIMPLE, BAYER_GRADIENT or BAYER_MHC
+		int isa;		//!< IpxToolsImpl::CpuIsa
+		int maxValue;	//!< the maximal value of the pixel depth, MHC clamps the results to it
+		IpxUnpackKernels::Unpack16Fn unpack = nullptr;	//!< unpacks the packed source rows to 16 bits, nullptr - the source is not packed
+		int outShift = 0;			//!< the 16-bit results are shifted right by it to the 8-bit output, 0 - the output has the source type
+		int layout = BAYER_LAYOUT_INTERLEAVED;	//!< BAYER_LAYOUT_INTERLEAVED ... BAYER_LAYOUT_NV12
+		size_t planeSize = 0;		//!< bytes of one plane of the planar layouts and of the Y plane of NV12
+		float scale[3] = {};		//!< the float planes are value * scale + offset, in the order of the planes
+		float offset[3] = {};
+	};
+
+	//! Working memory of ConvertRows, reused between the calls
+	typedef std::vector<uint64_t> Scratch;
+
+	const int ChunkSize = 512;	//!< pixels interpolated to the planar rows before the interleave, the chunk stays in L1
+	const int RowPad = 64;		//!< elements padded on both sides of the source rows, one 512-bit vector of bytes
+	const int StripeBytes = 256 * 1024;	//!< source and destination bytes of the MHC stripe, a typical L2 share of the core
+
+	//! Returns the mirrored coordinate, the image border is the axis, so the CFA phase is kept
+	inline int Mirror( int i, int size )
+	{
+		while (i < 0 || i >= size)
+			i = i < 0 ? -i : 2 * size - 2 - i;
+		return i;
+	}
+
+	//! Loads the source row sy to dst, the packed row is unpacked
+	inline void LoadRow( const Job &job, int sy, uint8_t *dst )
+	{
+		memcpy(dst, job.src + sy * job.srcStride, job.width);
+	}
+
+	inline void LoadRow( const Job &job, int sy, uint16_t *dst )
+	{
+		const char *src = job.src + sy * job.srcStride;
+		if (job.unpack)
+			job.unpack(reinterpret_cast<const uint8_t*>(src), dst, job.width);
+		else
+			memcpy(dst, src, job.width * sizeof(uint16_t));
+	}
+
+	//! Bytes of the UV sums of the even row of NV12, which are completed by the odd row
+	inline size_t GetChromaBytes( const Job &job )
+	{
+		return job.layout == BAYER_LAYOUT_NV12 ? size_t(job.width / 2) * 3 * sizeof(uint16_t) : 0;
+	}
+
+	//! Converts the 8-bit R, G and B chunks to the row of the Y plane by BT.601 in the limited range
+	inline void StoreLuma( const uint8_t *r, const uint8_t *g, const uint8_t *b, uint8_t *dst, int n )
+	{
+		for (int i = 0; i < n; ++i)
+			dst[i] = static_cast<uint8_t>(((66 * r[i] + 129 * g[i] + 25 * b[i] + 128) >> 8) + 16);
+	}
+
+	//! Keeps the sums of the horizontal pairs of the even row, the odd row adds its pairs and stores the UV row
+	/*!
+	The sums are 3 planes of stride sums, so the loops are vectorized by the compiler.
+	*/
+	inline void StoreChroma( const uint8_t *r, const uint8_t *g, const uint8_t *b, uint16_t *sums, size_t stride, uint8_t *uv, int n, bool odd )
+	{
+		uint16_t *sr = sums, *sg = sums + stride, *sb = sums + 2 * stride;
+		if (!odd)
+		{
+			for (int i = 0; i < n / 2; ++i)
+			{
+				sr[i] = static_cast<uint16_t>(r[2 * i] + r[2 * i + 1]);
+				sg[i] = static_cast<uint16_t>(g[2 * i] + g[2 * i + 1]);
+				sb[i] = static_cast<uint16_t>(b[2 * i] + b[2 * i + 1]);
+			}
+			return;
+		}
+		for (int i = 0; i < n / 2; ++i)
+		{
+			const int ar = (r[2 * i] + r[2 * i + 1] + sr[i] + 2) >> 2;
+			const int ag = (g[2 * i] + g[2 * i + 1] + sg[i] + 2) >> 2;
+			const int ab = (b[2 * i] + b[2 * i + 1] + sb[i] + 2) >> 2;
+			uv[2 * i] = static_cast<uint8_t>(((-38 * ar - 74 * ag + 112 * ab + 128) >> 8) + 128);
+			uv[2 * i + 1] = static_cast<uint8_t>(((112 * ar - 94 * ag - 18 * ab + 128) >> 8) + 128);
+		}
+	}
+
+	//! Writes the chunk to the float plane row, the loop is vectorized by the compiler
+	template<typename T>
+	inline void StoreFloat( const T *src, float *dst, int n, float scale, float offset )
+	{
+		for (int i = 0; i < n; ++i)
+			dst[i] = static_cast<float>(src[i]) * scale + offset;
+	}
+
+	//! Writes the planar chunks to the output row in the layout of the job, the 16-bit chunks of the 8-bit output are shifted first
+	/*!
+	NV12 keeps the sums of the even row in chromaSums, so the even row and the next odd one are written by one call
+	of ConvertRows, the stripes start at the even rows.
+	*/
+	template<typename T>
+	struct ChunkWriter
+	{
+		ChunkWriter( const Job &job, uint8_t *narrowChunks, uint16_t *chromaSums ) : m_job(job), m_narrow(narrowChunks), m_chroma(chromaSums)
+		{
+			const Kernels<T> k = GetKernels<T>(job.isa, BAYER_SIMPLE);
+			const Kernels<uint8_t> k8 = GetKernels<uint8_t>(job.isa, BAYER_SIMPLE);
+			m_interleave = job.channels == 4 ? k.interleave4 : k.interleave3;
+			m_interleave8 = job.channels == 4 ? k8.interleave4 : k8.interleave3;
+		}
+
+		//! Writes n pixels of the row y at x, first and last are the red and blue or the blue and red chunks
+		void Write( const T *first, const T *g, const T *last, int y, int x, int n ) const
+		{
+			char *out = m_job.dst + y * m_job.dstStride;
+			const T *planes[3] = { first, g, last };
+			switch (m_job.layout)
+			{
+			case BAYER_LAYOUT_PLANAR:
+				for (int c = 0; c < 3; ++c)
+				{
+					char *plane = out + c * m_job.planeSize;
+					if (m_job.outShift == 0)
+						memcpy(reinterpret_cast<T*>(plane) + x, planes[c], n * sizeof(T));
+					else
+						Narrow(planes[c], reinterpret_cast<uint8_t*>(plane) + x, n);
+				}
+				return;
+			case BAYER_LAYOUT_PLANAR_FLOAT:
+				for (int c = 0; c < 3; ++c)
+					StoreFloat(planes[c], reinterpret_cast<float*>(out + c * m_job.planeSize) + x, n, m_job.scale[c], m_job.offset[c]);
+				return;
+			case BAYER_LAYOUT_NV12:
+			{
+				// the job of NV12 is RGB, the chunks are narrowed to 8 bits even for the 8-bit source
+				uint8_t *r = m_narrow, *g8 = r + ChunkSize, *b = g8 + ChunkSize;
+				Narrow(first, r, n);
+				Narrow(g, g8, n);
+				Narrow(last, b, n);
+				StoreLuma(r, g8, b, reinterpret_cast<uint8_t*>(out) + x, n);
+				uint8_t *uv = reinterpret_cast<uint8_t*>(m_job.dst + m_job.planeSize + (y / 2) * m_job.dstStride);
+				StoreChroma(r, g8, b, m_chroma + x / 2, m_job.width / 2, uv + x, n, (y & 1) != 0);
+				return;
+			}
+			default:
+				break;
+			}
+
+			if (m_job.outShift == 0)
+			{
+				m_interleave(first, g, last, reinterpret_cast<T*>(out) + m_job.channels * x, n);
+				return;
+			}
+			uint8_t *n0 = m_narrow, *n1 = n0 + ChunkSize, *n2 = n1 + ChunkSize;
+			Narrow(first, n0, n);
+			Narrow(g, n1, n);
+			Narrow(last, n2, n);
+			m_interleave8(n0, n1, n2, reinterpret_cast<uint8_t*>(out) + m_job.channels * x, n);
+		}
+
+	private:
+		void Narrow( const uint8_t *src, uint8_t *dst, int n ) const { memcpy(dst, src, n); }
+		void Narrow( const uint16_t *src, uint8_t *dst, int n ) const { ShiftTo8(src, dst, n, m_job.outShift); }
+
+		const Job &m_job;
+		uint8_t *m_narrow;
+		uint16_t *m_chroma;
+		typename Kernels<T>::InterleaveFn m_interleave;
+		Kernels<uint8_t>::InterleaveFn m_interleave8;
+	};
+
+	//! Converts the rows [y0, y1) of the job
+	template<typename T>
+	inline void ConvertRows( const Job &job, int y0, int y1, Scratch &scratch )
+	{
+		const Kernels<T> k = GetKernels<T>(job.isa, job.alg);
+		const int width = job.width, height = job.height;
+
+		// 3 padded source rows, the 3 planar chunks and the 3 chunks of the 8-bit output, each part starts at 64 bytes
+		const size_t rowLen = (width + 2 * RowPad + 63) & ~size_t(63);
+		const size_t chunkLen = ChunkSize + RowPad;
+		const size_t bytes = (3 * rowLen + 3 * chunkLen) * sizeof(T) + 3 * ChunkSize + GetChromaBytes(job) + 64;
+		if (scratch.size() * sizeof(uint64_t) < bytes)
+			scratch.resize(bytes / sizeof(uint64_t) + 1);
+		T *base = reinterpret_cast<T*>((reinterpret_cast<uintptr_t>(scratch.data()) + 63) & ~uintptr_t(63));
+		T *rows[3] = { base, base + rowLen, base + 2 * rowLen };
+		T *planar = base + 3 * rowLen;
+		T *px = planar, *pg = planar + chunkLen, *py = planar + 2 * chunkLen;
+		uint8_t *narrow = reinterpret_cast<uint8_t*>(planar + 3 * chunkLen);
+		const ChunkWriter<T> writer(job, narrow, reinterpret_cast<uint16_t*>(narrow + 3 * ChunkSize));
+		int loaded[3] = { INT_MIN, INT_MIN, INT_MIN };
+
+		for (int y = y0; y < y1; ++y)
+		{
+			const T *r[3];
+			for (int i = 0; i < 3; ++i)
+			{
+				// the ring slot of the row y-1+i, the mirrored rows -1 and height are the rows 1 and height-2
+				const int logical = y - 1 + i;
+				const int slot = (logical + 3) % 3;
+				if (loaded[slot] != logical)
+				{
+					const int sy = logical < 0 ? -logical : (logical >= height ? 2 * height - 2 - logical : logical);
+					T *row = rows[slot] + RowPad;
+					LoadRow(job, sy, row);
+					row[-1] = row[1];
+					row[width] = row[width - 2];
+					loaded[slot] = logical;
+				}
+				r[i] = rows[slot] + RowPad;
+			}
+
+			const bool redRow = IsRedRow(job.cfa, y);
+			const bool xEven = IsXEven(job.cfa, y);
+			const T *red = redRow ? px : py;
+			const T *blue = redRow ? py : px;
+			const T *first = job.bgr ? blue : red;
+			const T *last = job.bgr ? red : blue;
+
+			for (int x = 0; x < width; x += ChunkSize)
+			{
+				const int n = std::min(ChunkSize, width - x);
+				k.row(r[0] + x, r[1] + x, r[2] + x, px, pg, py, n, xEven);
+				writer.Write(first, pg, last, y, x, n);
+			}
+		}
+	}
+
+	//! Converts the rows [y0, y1) of the job by MHC, the 2 halo rows above and below the stripe are read too
+	template<typename T>
+	inline void ConvertRowsMhc( const Job &job, int y0, int y1, Scratch &scratch )
+	{
+		typedef typename MhcWide<T>::type W;
+		const MhcKernels<T> k = GetMhcKernels<T>(job.isa);
+		const int width = job.width, height = job.height;
+
+		// 5 padded rows and 3 planar chunks of the working type, 3 planar chunks and the unpacked row of the pixel type,
+		// 3 chunks of the 8-bit output
+		const size_t rowLen = (width + 2 * RowPad + 63) & ~size_t(63);
+		const size_t chunkLen = ChunkSize + RowPad;
+		const size_t bytes = (5 * rowLen + 3 * chunkLen) * sizeof(W) + (3 * chunkLen + rowLen) * sizeof(T) + 3 * ChunkSize
+			+ GetChromaBytes(job) + 128;
+		if (scratch.size() * sizeof(uint64_t) < bytes)
+			scratch.resize(bytes / sizeof(uint64_t) + 1);
+		W *base = reinterpret_cast<W*>((reinterpret_cast<uintptr_t>(scratch.data()) + 63) & ~uintptr_t(63));
+		W *rows[5];
+		for (int i = 0; i < 5; ++i)
+			rows[i] = base + i * rowLen;
+		W *wx = base + 5 * rowLen, *wg = wx + chunkLen, *wy = wg + chunkLen;
+		T *px = reinterpret_cast<T*>((reinterpret_cast<uintptr_t>(wy + chunkLen) + 63) & ~uintptr_t(63));
+		T *pg = px + chunkLen, *py = pg + chunkLen;
+		T *unpacked = py + chunkLen;
+		uint8_t *narrow = reinterpret_cast<uint8_t*>(unpacked + rowLen);
+		const ChunkWriter<T> writer(job, narrow, reinterpret_cast<uint16_t*>(narrow + 3 * ChunkSize));
+		int loaded[5] = { INT_MIN, INT_MIN, INT_MIN, INT_MIN, INT_MIN };
+
+		for (int y = y0; y < y1; ++y)
+		{
+			const W *r[5];
+			for (int i = 0; i < 5; ++i)
+			{
+				const int logical = y - 2 + i;
+				const int slot = (logical + 5) % 5;
+				if (loaded[slot] != logical)
+				{
+					W *row = rows[slot] + RowPad;
+					const T *src = reinterpret_cast<const T*>(job.src + Mirror(logical, height) * job.srcStride);
+					if (job.unpack)
+					{
+						LoadRow(job, Mirror(logical, height), unpacked);
+						src = unpacked;
+					}
+					k.widen(src, row, width);
+					row[-2] = row[Mirror(-2, width)];
+					row[-1] = row[Mirror(-1, width)];
+					row[width] = row[Mirror(width, width)];
+					row[width + 1] = row[Mirror(width + 1, width)];
+					loaded[slot] = logical;
+				}
+				r[i] = rows[slot] + RowPad;
+			}
+
+			const bool redRow = IsRedRow(job.cfa, y);
+			const bool xEven = IsXEven(job.cfa, y);
+			const T *red = redRow ? px : py;
+			const T *blue = redRow ? py : px;
+			const T *first = job.bgr ? blue : red;
+			const T *last = job.bgr ? red : blue;
+
+			for (int x = 0; x < width; x += ChunkSize)
+			{
+				const int n = std::min(ChunkSize, width - x);
+				const W *rx[5] = { r[0] + x, r[1] + x, r[2] + x, r[3] + x, r[4] + x };
+				k.row(rx, wx, wg, wy, n, xEven, static_cast<W>(job.maxValue));
+				k.narrow(wx, px, n);
+				k.narrow(wg, pg, n);
+				k.narrow(wy, py, n);
+				writer.Write(first, pg, last, y, x, n);
+			}
+		}
+	}
+
+	//! Returns the rows of the MHC stripe, the stripe fits StripeBytes and every thread gets at least one
+	/*!
+	The number is even, so the stripes start at the even rows as NV12 requires.
+	*/
+	inline int GetStripeRows( const Job &job, int bytesPerPixel, int threads )
+	{
+		const int fit = StripeBytes / std::max(1, job.width * bytesPerPixel);
+		const int share = (job.height + threads - 1) / threads;
+		return (std::max(4, std::min(fit, share)) + 1) & ~1;
+	}
+
+} // end of namespace IpxBayerKernels
+
+/*!
+\brief IpxBayer component with the CPU demosaicing kernels, the implementation is in the header
+\details The component converts II_PIX_BAYGR8 ... II_PIX_BAYBG16 images and the packed II_PIX_BAYGR10_PACKED_GEV ...
+II_PIX_BAYBG12_PACKED_PFNC ones by BAYER_SIMPLE, BAYER_GRADIENT and BAYER_MHC to RGB8, BGR8, RGBA8 and BGRA8 and, for
+10...16 bits, to the 16-bit RGB and BGR types. The 16-bit values are not rescaled, the default output of BAYGR12 is
+RGB12; the 8-bit output of the deeper source is shifted right by (depth - 8). The packed rows are unpacked to the row
+buffers of the stripe, so the conversion reads the source and writes the result once. The kernels are selected at run time by the CPU, DEBAYER_FORCE_ISA
+selects the lower level for testing and DEBAYER_ACTIVE_ISA reports the used one.
+
+The image is split to the horizontal stripes of about 256 KB of the source and destination data, each stripe reads
+the halo rows above and below (1 for BAYER_SIMPLE and BAYER_GRADIENT, 2 for BAYER_MHC), and the stripes are converted
+on the worker pool by up to DEBAYER_THREADS_NUM threads including the calling one. The result does not depend on the
+number of the threads. The pool threads are created by the first conversion and kept until the component is deleted,
+so ConvertImage does not create threads. With DEBAYER_SHARED_POOL = 1 the components use one pool of the process
+(IpxToolsImpl::WorkerPool::GetShared) and DEBAYER_THREADS_NUM limits the threads of each call, so N cameras do not
+start N pools; SetWorkerPool shares any other pool.
+
+DEBAYER_OUTPUT_LAYOUT writes the chunks of the interpolated channels directly in the layout of the inference
+runtimes instead of interleaving them: BAYER_LAYOUT_PLANAR writes 3 planes of the output type, BAYER_LAYOUT_PLANAR_FLOAT
+writes 3 float planes normalized by DEBAYER_NORM_MEAN and DEBAYER_NORM_STD, BAYER_LAYOUT_NV12 writes the Y plane and
+the UV plane averaged over 2x2 pixels. The planes follow each other without padding, see BAYER_LAYOUT_INTERLEAVED.
+
+BAYER_MHC uses the weights of BAYER_OPENGL_MHC in the integer arithmetic: inside the image the output differs from
+the GL output by at most 1 code value (the GL shader rounds the float sums), the 2-pixel border differs more since
+the GL texture sampling clamps to the edge while the CPU kernel mirrors the border to keep the CFA phase.
+\code
+IpxBayerCpu *bayer = IpxBayerCpu::CreateComponent();
+bayer->GetComponent()->SetParamInt(DEBAYER_ALGO_TYPE, BAYER_GRADIENT);
+bayer->GetComponent()->SetParamInt(DEBAYER_FORCE_ISA, BAYER_ISA_AVX2);
+bayer->GetComponent()->SetParamInt(DEBAYER_SHARED_POOL, 1);	// share the threads with the other cameras
+bayer->GetComponent()->SetParamInt(DEBAYER_THREADS_NUM, 4);	// at most 4 threads for each frame
+
+IpxImage rgb;
+IpxInitImageHeader(&rgb, IpxSize(0, 0), II_PIX_BGR8, nullptr, 0, 0);	// the output type, the data is allocated by the component
+IpxError err = bayer->ConvertImage(raw, &rgb);
+...
+const float mean[3] = { 0.485f, 0.456f, 0.406f }, std[3] = { 0.229f, 0.224f, 0.225f };
+bayer->GetComponent()->SetParamInt(DEBAYER_OUTPUT_LAYOUT, BAYER_LAYOUT_PLANAR_FLOAT);
+bayer->GetComponent()->SetParamArray(DEBAYER_NORM_MEAN, (void*)mean, sizeof(mean));
+bayer->GetComponent()->SetParamArray(DEBAYER_NORM_STD, (void*)std, sizeof(std));
+IpxImage tensor;
+IpxInitImageHeader(&tensor, IpxSize(0, 0), II_PIX_RGB8, nullptr, 0, 0);	// the R, G and B float planes
+err = bayer->ConvertImage(raw, &tensor);
+...
+IpxBayerCpu::DeleteComponent(bayer);
+\endcode
+*/
+class IpxBayerCpu final : public IpxBayer
+{
+public:
+
+	//! Creates the component
+	static IpxBayerCpu* CreateComponent() { return new IpxBayerCpu(); }
+
+	//! Deletes the component and the data allocated by it
+	static void DeleteComponent( IpxBayerCpu* in ) { delete in; }
+
+	IpxBayerCpu() {}
+	virtual ~IpxBayerCpu() {}
+
+	IpxComponent* GetComponent() override { return &m_component; }
+
+	IpxError ConvertImage( const IpxImage* pSrc, IpxImage* pDst ) override
+	{
+		IpxBayerKernels::Source source;
+		if (!pSrc || !pDst || !pSrc->imageData || !IpxBayerKernels::GetSource(pSrc->pixelTypeDescr.pixelType, m_component.GetIsa(), &source))
+			return IPX_ERR_BAYER_INVALID_ARGUMENT;
+		if (pSrc->width < 2 || pSrc->height < 2 || pSrc->width > INT_MAX / 4 || pSrc->height > INT_MAX / 4)
+			return IPX_ERR_BAYER_INVALID_ARGUMENT;
+		const size_t rowBytes = source.unpack ? IpxUnpackKernels::GetPackedRowBytes(pSrc->pixelTypeDescr.pixelType, pSrc->width)
+			: size_t(pSrc->width) * source.bits / 8;
+		if (pSrc->rowSize < rowBytes)
+			return IPX_ERR_BAYER_INVALID_ARGUMENT;
+
+		const int layout = m_component.GetLayout();
+		if (layout == BAYER_LAYOUT_NV12 && ((pSrc->width | pSrc->height) & 1))
+			return IPX_ERR_BAYER_INVALID_ARGUMENT;
+		const uint32_t dstType = GetOutputType(source, pDst, layout);
+		if (!Fits(pDst, dstType, pSrc->width, pSrc->height, layout))
+		{
+			if (m_component.GetNoRealloc())
+				return IPX_ERR_BAYER_NO_MEMORY;
+			IpxError err = Alloc(pDst, dstType, pSrc->width, pSrc->height, layout);
+			if (err != IPX_ERR_OK)
+				return err;
+		}
+
+		IpxBayerKernels::Job job;
+		job.src = pSrc->imageData;
+		job.srcStride = pSrc->rowSize;
+		job.dst = pDst->imageData;
+		job.dstStride = pDst->rowSize;
+		job.width = static_cast<int>(pSrc->width);
+		job.height = static_cast<int>(pSrc->height);
+		job.cfa = source.cfa;
+		job.channels = (dstType == II_PIX_RGBA8 || dstType == II_PIX_BGRA8) ? 4 : 3;
+		job.bgr = IpxBayerKernels::IsBgr(dstType);
+		job.alg = static_cast<int>(m_component.GetAlgorithm());
+		job.isa = m_component.GetIsa();
+		job.maxValue = static_cast<int>((1u << source.depth) - 1);
+		job.unpack = source.unpack;
+		job.outShift = (source.bits == 16 && (IpxBayerKernels::Is8Bit(dstType) || dstType == II_PIX_MONO8)) ? source.depth - 8 : 0;
+		job.layout = layout;
+		job.planeSize = size_t(pDst->rowSize) * pDst->height;
+		if (layout == BAYER_LAYOUT_PLANAR_FLOAT)
+		{
+			// (value / max - mean) / std, the mean and std are in the RGB order
+			for (int c = 0; c < 3; ++c)
+			{
+				const int rgb = job.bgr ? 2 - c : c;
+				job.scale[c] = 1.0f / (job.maxValue * m_component.GetStd()[rgb]);
+				job.offset[c] = -m_component.GetMean()[rgb] / m_component.GetStd()[rgb];
+			}
+		}
+
+		try
+		{
+			if (source.bits == 8)
+				ConvertStripes<uint8_t>(job);
+			else
+				ConvertStripes<uint16_t>(job);
+		}
+		catch (const std::bad_alloc&)
+		{
+			return IPX_ERR_BAYER_NO_MEMORY;
+		}
+
+		pDst->timestamp = pSrc->timestamp;
+		pDst->imageID = pSrc->imageID;
+		return IPX_ERR_OK;
+	}
+
+	//! Allocates the destination image for the source, the memory is owned by the component until ReleaseData
+	/*!
+	The pixel type of pDst is kept if it is a supported output for the source, otherwise the default one is set.
+	*/
+	IpxError AllocData( const IpxImage* pSrc, IpxImage* pDst ) override
+	{
+		IpxBayerKernels::Source source;
+		if (!pSrc || !pDst || !IpxBayerKernels::GetSource(pSrc->pixelTypeDescr.pixelType, m_component.GetIsa(), &source))
+			return IPX_ERR_BAYER_INVALID_ARGUMENT;
+		const int layout = m_component.GetLayout();
+		return Alloc(pDst, GetOutputType(source, pDst, layout), pSrc->width, pSrc->height, layout);
+	}
+
+	//! Sets the header of the destination image the way AllocData does, without the data
+	/*!
+	The pixel type of pDst is kept if it is a supported output for the source, otherwise the default one is set.
+	*/
+	IpxError GetOutputFormat( const IpxImage* pSrc, IpxImage* pDst ) const
+	{
+		IpxBayerKernels::Source source;
+		if (!pSrc || !pDst || !IpxBayerKernels::GetSource(pSrc->pixelTypeDescr.pixelType, m_component.GetIsa(), &source))
+			return IPX_ERR_BAYER_INVALID_ARGUMENT;
+		const int layout = m_component.GetLayout();
+		return InitHeader(pDst, GetOutputType(source, pDst, layout), pSrc->width, pSrc->height, layout);
+	}
+
+	//! Sets the worker pool used by the component, for example the pool of the other component
+	/*!
+	\param[in] pool the pool, nullptr - the pool selected by DEBAYER_SHARED_POOL
+	*/
+	void SetWorkerPool( const std::shared_ptr<IpxToolsImpl::WorkerPool> &pool )
+	{
+		m_pool.SetWorkerPool(pool);
+	}
+
+	//! Returns the worker pool used by the component, the pool is created if it is needed
+	std::shared_ptr<IpxToolsImpl::WorkerPool> GetWorkerPool()
+	{
+		return m_pool.GetWorkerPool(m_component.GetSharedPool(), m_component.GetThreads());
+	}
+
+	void ReleaseData() override
+	{
+		std::vector<uint64_t>().swap(m_data);
+		std::vector<IpxBayerKernels::Scratch>().swap(m_scratch);
+	}
+
+private:
+	class Component : public IpxToolsImpl::ParamComponent
+	{
+	public:
+		Component() : IpxToolsImpl::ParamComponent(IPX_CMP_BAYER_DEMOSAICING)
+		{
+			m_algo = AddParamInt(DEBAYER_ALGO_TYPE, BAYER_SIMPLE, 0, BAYER_MHC);
+			m_noRealloc = AddParamInt(DEBAYER_NOREALLOCT, 0, 0, 1);
+			m_threads = AddParamInt(DEBAYER_THREADS_NUM, 0, 0, 32);
+			m_sharedPool = AddParamInt(DEBAYER_SHARED_POOL, 0, 0, 1);
+			AddIsaParams(DEBAYER_FORCE_ISA, DEBAYER_ACTIVE_ISA);
+			m_layout = AddParamInt(DEBAYER_OUTPUT_LAYOUT, BAYER_LAYOUT_INTERLEAVED, BAYER_LAYOUT_INTERLEAVED, BAYER_LAYOUT_NV12);
+		}
+
+		int64_t GetAlgorithm() const { return GetInt(m_algo); }
+		int GetLayout() const { return static_cast<int>(GetInt(m_layout)); }
+		const float* GetMean() const { return m_mean; }
+		const float* GetStd() const { return m_std; }
+
+		//! Copies 3 floats of DEBAYER_NORM_MEAN or DEBAYER_NORM_STD, the size is in bytes
+		IpxError SetParamArray( const char* name, void* param, uint32_t size ) override
+		{
+			float *values = GetNorm(name);
+			if (!values)
+				return ParamComponent::SetParamArray(name, param, size);
+			if (!param)
+				return Error(IPX_ERR_NULL_POINTER);
+			if (size != 3 * sizeof(float))
+				return Error(IPX_ERR_OUT_OF_RANGE);
+			float norm[3];
+			memcpy(norm, param, sizeof(norm));
+			if (values == m_std && (norm[0] == 0.0f || norm[1] == 0.0f || norm[2] == 0.0f))
+				return Error(IPX_ERR_OUT_OF_RANGE);
+			memcpy(values, norm, sizeof(norm));
+			return IPX_ERR_OK;
+		}
+
+		IpxError GetParamArray( const char* name, void* param, uint32_t* size ) override
+		{
+			float *values = GetNorm(name);
+			if (!values)
+				return ParamComponent::GetParamArray(name, param, size);
+			if (!size)
+				return Error(IPX_ERR_NULL_POINTER);
+			if (!param || *size < 3 * sizeof(float))
+			{
+				*size = 3 * sizeof(float);
+				return Error(IPX_ERR_BUFFER_TOO_SMALL);
+			}
+			memcpy(param, values, 3 * sizeof(float));
+			*size = 3 * sizeof(float);
+			return IPX_ERR_OK;
+		}
+		bool GetNoRealloc() const { return GetInt(m_noRealloc) != 0; }
+		int GetThreads() const { return static_cast<int>(GetInt(m_threads)); }
+		bool GetSharedPool() const { return GetInt(m_sharedPool) != 0; }
+
+	protected:
+		IpxError OnSetParamInt( size_t index, int64_t value ) override
+		{
+			if (index == m_algo && value != BAYER_SIMPLE && value != BAYER_GRADIENT && value != BAYER_MHC)
+				return IPX_ERR_BAYER_NOT_SUPPORTED;
+			return IPX_ERR_OK;
+		}
+
+	private:
+		float* GetNorm( const char* name )
+		{
+			if (name && strcmp(name, DEBAYER_NORM_MEAN) == 0)
+				return m_mean;
+			if (name && strcmp(name, DEBAYER_NORM_STD) == 0)
+				return m_std;
+			return nullptr;
+		}
+
+		size_t m_algo, m_noRealloc, m_threads, m_sharedPool, m_layout;
+		float m_mean[3] = { 0.0f, 0.0f, 0.0f };
+		float m_std[3] = { 1.0f, 1.0f, 1.0f };
+	};
+
+	// converts the stripes on the worker pool, the scratch memory is kept per worker of the pool
+	template<typename T>
+	void ConvertStripes( const IpxBayerKernels::Job &job )
+	{
+		const int bytesPerPixel = static_cast<int>(sizeof(T)) * (job.channels + 1);
+		m_pool.RunStripes(m_component.GetSharedPool(), m_component.GetThreads(), job.height, m_scratch,
+			[&]( int threads ) { return IpxBayerKernels::GetStripeRows(job, bytesPerPixel, threads); },
+			[&]( int y0, int y1, IpxBayerKernels::Scratch &scratch )
+			{
+				if (job.alg == BAYER_MHC)
+					IpxBayerKernels::ConvertRowsMhc<T>(job, y0, y1, scratch);
+				else
+					IpxBayerKernels::ConvertRows<T>(job, y0, y1, scratch);
+			});
+	}
+
+	// the pixel type of pDst if it is supported for the source and the layout, see IpxBayerKernels::GetOutputType;
+	// the planar layouts have no alpha, the float planes are described by RGB8 or BGR8 and NV12 by MONO8
+	static uint32_t GetOutputType( const IpxBayerKernels::Source &source, const IpxImage* pDst, int layout )
+	{
+		uint32_t type = pDst->pixelTypeDescr.pixelType;
+		if (layout == BAYER_LAYOUT_NV12)
+			return II_PIX_MONO8;
+		if (layout != BAYER_LAYOUT_INTERLEAVED && (type == II_PIX_RGBA8 || type == II_PIX_BGRA8))
+			type = type == II_PIX_RGBA8 ? II_PIX_RGB8 : II_PIX_BGR8;
+		if (layout == BAYER_LAYOUT_PLANAR_FLOAT)
+			return IpxBayerKernels::IsBgr(type) ? II_PIX_BGR8 : II_PIX_RGB8;
+		return IpxBayerKernels::GetOutputType(source, type);
+	}
+
+	// the bytes of the row of one plane of the layout and the plane rows of the image, 2 rows of NV12 are 3 plane rows
+	static void GetLayoutSize( uint32_t type, uint32_t width, int layout, size_t *rowBytes, uint64_t *planeRows2 )
+	{
+		switch (layout)
+		{
+		case BAYER_LAYOUT_PLANAR:
+			*rowBytes = size_t(width) * (IpxBayerKernels::Is8Bit(type) ? 1 : 2);
+			*planeRows2 = 6;
+			break;
+		case BAYER_LAYOUT_PLANAR_FLOAT:
+			*rowBytes = size_t(width) * sizeof(float);
+			*planeRows2 = 6;
+			break;
+		case BAYER_LAYOUT_NV12:
+			*rowBytes = width;
+			*planeRows2 = 3;
+			break;
+		default:
+			*rowBytes = IpxGetRowSizeUnaligned(type, width);
+			*planeRows2 = 2;
+			break;
+		}
+	}
+
+	// the destination has the data of the right type and size, allocated by the component or by the application
+	static bool Fits( const IpxImage* pDst, uint32_t type, uint32_t width, uint32_t height, int layout )
+	{
+		size_t rowBytes;
+		uint64_t planeRows2;
+		GetLayoutSize(type, width, layout, &rowBytes, &planeRows2);
+		return pDst->imageData && pDst->pixelTypeDescr.pixelType == type && pDst->width == width && pDst->height == height
+			&& pDst->rowSize >= rowBytes && uint64_t(pDst->imageSize) * 2 >= uint64_t(pDst->rowSize) * height * planeRows2;
+	}
+
+	// the interleaved rows are aligned by IpxGetRowSize, the planes are packed without padding
+	static IpxError InitHeader( IpxImage* pDst, uint32_t type, uint32_t width, uint32_t height, int layout )
+	{
+		size_t rowBytes;
+		uint64_t imageSize;
+		if (layout == BAYER_LAYOUT_INTERLEAVED)
+		{
+			rowBytes = IpxGetRowSize(type, width);
+			imageSize = uint64_t(rowBytes) * height;
+		}
+		else
+		{
+			uint64_t planeRows2;
+			GetLayoutSize(type, width, layout, &rowBytes, &planeRows2);
+			imageSize = uint64_t(rowBytes) * height * planeRows2 / 2;
+		}
+		if (imageSize > UINT32_MAX || !IpxInitPixelTypeDescr(type, &pDst->pixelTypeDescr))
+			return IPX_ERR_BAYER_INVALID_ARGUMENT;
+		pDst->width = width;
+		pDst->height = height;
+		pDst->rowSize = static_cast<uint32_t>(rowBytes);
+		pDst->imageSize = static_cast<uint32_t>(imageSize);
+		return IPX_ERR_OK;
+	}
+
+	IpxError Alloc( IpxImage* pDst, uint32_t type, uint32_t width, uint32_t height, int layout )
+	{
+		const IpxError err = InitHeader(pDst, type, width, height, layout);
+		if (err != IPX_ERR_OK)
+			return err;
+		try
+		{
+			if (m_data.size() * sizeof(uint64_t) < pDst->imageSize)
+				m_data.resize((pDst->imageSize + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+		}
+		catch (const std::bad_alloc&)
+		{
+			return IPX_ERR_BAYER_NO_MEMORY;
+		}
+		pDst->imageData = reinterpret_cast<char*>(m_data.data());
+		pDst->imageDataOrigin = nullptr;
+		return IPX_ERR_OK;
+	}
+
+	Component m_component;
+	std::vector<uint64_t> m_data;
+	std::vector<IpxBayerKernels::Scratch> m_scratch;	// per worker of the pool, 0 - the calling thread
+	IpxToolsImpl::ComponentPool m_pool;
+};
+
+#endif // __cplusplus
+
+#endif // _IPX_BAYER_CPU_H_
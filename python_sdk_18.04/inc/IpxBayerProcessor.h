@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Imaging API SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxBayerProcessor.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Header-only IpxImgProcessor converting the packed Bayer images to RGB in one pass
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _IPX_BAYER_PROCESSOR_H_
+#define _IPX_BAYER_PROCESSOR_H_
+
+#include "IpxBayerCpu.h"
+#include "IpxImgProcessor.h"
+
+#ifdef __cplusplus
+
+/*!
+\brief IpxImgProcessor of IpxBayerCpu, the fused replacement of the unpacker, the Bayer and the converter processors
+\details The chain of IpxImageUnpacker::Unpack, IpxBayer::ConvertImage and IpxImageConverter::ConvertImage reads and
+writes the full image three times and keeps two intermediate images. This processor converts II_PIX_BAYGR10_PACKED_GEV
+... II_PIX_BAYBG12_PACKED_PFNC and the unpacked Bayer types directly to RGB8, BGR8, RGBA8 or BGRA8: every stripe
+of rows is unpacked, demosaiced by DEBAYER_ALGO_TYPE and shifted to 8 bits in the chunks of 512 pixels, which stay in
+the cache, and only the 8-bit result is written to the memory. The 16-bit outputs are supported too.
+
+The 8-bit values are the demosaiced values shifted right by (depth - 8), the same as the 16-bit output of IpxBayerCpu
+shifted to 8 bits. The parameters of GetComponent are the ones of IpxBayerCpu.
+\code
+IpxBayerProcessor *proc = IpxBayerProcessor::CreateComponent();
+proc->GetComponent()->SetParamInt(DEBAYER_ALGO_TYPE, BAYER_MHC);
+
+IpxImage format;
+format.pixelTypeDescr.pixelType = II_PIX_BGRA8;
+proc->Init(raw, &format);				// raw is II_PIX_BAYRG12_PACKED_PFNC
+chain->AddProcessor("bayer", proc);		// instead of "unpacker", "bayer" and "converter"
+...
+IpxError err = proc->ProcessImage(raw, nullptr, nullptr);	// the result is in proc->Output()
+...
+IpxBayerProcessor::DeleteComponent(proc);
+\endcode
+*/
+class IpxBayerProcessor final : public IpxImgProcessor
+{
+public:
+
+	//! Creates the processor
+	static IpxBayerProcessor* CreateComponent() { return new IpxBayerProcessor(); }
+
+	//! Deletes the processor and the data allocated by it
+	static void DeleteComponent( IpxBayerProcessor* in ) { delete in; }
+
+	// ProcessImage reads the output type of the format before Init, it is 0 then
+	IpxBayerProcessor() : m_sourceFormat(), m_outputFormat(), m_output(), m_enabled(true) {}
+	virtual ~IpxBayerProcessor() {}
+
+	//! Sets the source and the output formats, the data of the headers is not used
+	/*!
+	\param[in] sourceImageFormat the source pixel type, width and height
+	\param[in] outputImageFormat the output pixel type, nullptr - RGB8
+	\return Returns IPX_ERR_BAYER_INVALID_ARGUMENT if the source type is not a Bayer one
+	*/
+	IpxError Init( IpxImage* sourceImageFormat, IpxImage* outputImageFormat ) override
+	{
+		if (!sourceImageFormat)
+			return IPX_ERR_BAYER_INVALID_ARGUMENT;
+		IpxImage output;
+		output.pixelTypeDescr.pixelType = outputImageFormat ? outputImageFormat->pixelTypeDescr.pixelType : uint32_t(II_PIX_RGB8);
+		IpxError err = m_bayer.GetOutputFormat(sourceImageFormat, &output);
+		if (err != IPX_ERR_OK)
+			return err;
+		SetFormat(&m_sourceFormat, *sourceImageFormat);
+		SetFormat(&m_outputFormat, output);
+		return IPX_ERR_OK;
+	}
+
+	//! Converts the source image to the output one
+	/*!
+	\param[in] sourceImage the Bayer image
+	\param[in,out] outputImage the output image, the data is allocated by the processor if it does not fit;
+		nullptr - the image returned by Output
+	\param[in] data not used
+	*/
+	IpxError ProcessImage( IpxImage *sourceImage, IpxImage *outputImage, void *data ) override
+	{
+		(void)data;
+		IpxImage *output = outputImage ? outputImage : &m_output;
+		if (!output->imageData && m_outputFormat.pixelTypeDescr.pixelType)
+			output->pixelTypeDescr.pixelType = m_outputFormat.pixelTypeDescr.pixelType;
+		return m_bayer.ConvertImage(sourceImage, output);
+	}
+
+	void Release() override
+	{
+		m_bayer.ReleaseData();
+		m_output = IpxImage();
+	}
+
+	IpxComponent* GetComponent() override { return m_bayer.GetComponent(); }
+
+	//! Returns the output image of ProcessImage called without the output image
+	IpxImage* Output() override { return &m_output; }
+
+	//! Returns the source or the output format set by Init
+	IpxImage* Format( bool _sourceFormat ) override { return _sourceFormat ? &m_sourceFormat : &m_outputFormat; }
+
+	bool Enable( bool _enabled ) override { m_enabled = _enabled; return true; }
+
+	bool IsEnabled() override { return m_enabled; }
+
+	//! Returns the converter, for example to share its worker pool
+	IpxBayerCpu* GetBayer() { return &m_bayer; }
+
+private:
+	static void SetFormat( IpxImage *format, const IpxImage &image )
+	{
+		IpxInitPixelTypeDescr(image.pixelTypeDescr.pixelType, &format->pixelTypeDescr);
+		format->width = image.width;
+		format->height = image.height;
+		format->rowSize = image.rowSize;
+		format->imageSize = image.imageSize;
+	}
+
+	IpxBayerCpu m_bayer;
+	IpxImage m_sourceFormat;
+	IpxImage m_outputFormat;
+	IpxImage m_output;
+	bool m_enabled;
+};
+
+#endif // __cplusplus
+
+#endif // _IPX_BAYER_PROCESSOR_H_
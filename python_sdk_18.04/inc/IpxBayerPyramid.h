@@ -0,0 +1,378 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Imaging API SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxBayerPyramid.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Header-only RGB image pyramid binned directly from the Bayer CFA data
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _IPX_BAYER_PYRAMID_H_
+#define _IPX_BAYER_PYRAMID_H_
+
+#include "IpxBayerCpu.h"
+
+#ifdef __cplusplus
+
+/*! \namespace IpxPyramidKernels
+	\brief A namespace provides the kernels of IpxBayerPyramid.
+
+	\details Level 0 is the half resolution RGB image: every 2x2 quad of the CFA gives one pixel, R and B are the
+	own values of the quad and G is the rounded average (g1 + g2 + 1) / 2 of its two greens, so no color is
+	interpolated from the neighbour quads. Every next level is the rounded 2x2 box average (a + b + c + d + 2) / 4
+	of the previous one. The levels are kept in 16 bits of the source depth in the stripe buffers and are shifted
+	to 8 bits only when they are stored, so the rounding does not accumulate over the levels.
+*/
+namespace IpxPyramidKernels
+{
+	enum { MaxLevels = 4 };	//!< levels 1/2, 1/4, 1/8 and 1/16 of the source
+
+	//! The conversion of one frame
+	struct Job
+	{
+		const char *src = nullptr;
+		size_t srcStride = 0;
+		int width = 0;			// source width and height
+		int height = 0;
+		int cfa = 0;
+		int srcBits = 8;		// 8 or 16 bits per pixel of the unpacked source
+		IpxUnpackKernels::Unpack16Fn unpack = nullptr;
+		int levels = 1;
+		char *dst[MaxLevels] = {};
+		size_t dstStride[MaxLevels] = {};
+		int levelWidth[MaxLevels] = {};
+		int levelHeight[MaxLevels] = {};
+		int channels = 3;		// 3 or 4 channels of the output
+		bool bgr = false;
+		bool out8 = true;		// 8-bit or 16-bit output
+		int outShift = 0;		// right shift of the 8-bit output
+	};
+
+	//! Buffers of the stripe, kept per worker between the frames
+	struct Scratch
+	{
+		std::vector<uint16_t> row[2];				// unpacked or widened source rows
+		std::vector<uint16_t> level[MaxLevels];	// 3 channels per pixel of the stripe rows of each level
+	};
+
+	//! Returns the source row in 16 bits, the 16-bit unpacked row is used in place
+	inline const uint16_t* LoadRow( const Job &job, int y, std::vector<uint16_t> &buffer )
+	{
+		const char *row = job.src + job.srcStride * size_t(y);
+		if (!job.unpack && job.srcBits == 16)
+			return reinterpret_cast<const uint16_t*>(row);
+		if (buffer.size() < size_t(job.width))
+			buffer.resize(job.width);
+		if (job.unpack)
+			job.unpack(reinterpret_cast<const uint8_t*>(row), buffer.data(), job.width);
+		else
+			IpxUnpackKernels::Plain8To16(reinterpret_cast<const uint8_t*>(row), buffer.data(), job.width);
+		return buffer.data();
+	}
+
+	//! Bins the quads of the two CFA rows of the even row pair to width RGB pixels
+	inline void BinQuads( const uint16_t *r0, const uint16_t *r1, int width, int cfa, uint16_t *out )
+	{
+		// the red column and row inside the quad, blue is on the opposite corner, greens on the other two
+		const int rx = (cfa == IpxBayerKernels::CfaGR || cfa == IpxBayerKernels::CfaBG) ? 1 : 0;
+		const bool redRow1 = (cfa == IpxBayerKernels::CfaGB || cfa == IpxBayerKernels::CfaBG);
+		const uint16_t *rowR = (redRow1 ? r1 : r0) + rx;
+		const uint16_t *rowB = (redRow1 ? r0 : r1) + (1 - rx);
+		const uint16_t *g0 = (redRow1 ? r1 : r0) + (1 - rx);
+		const uint16_t *g1 = (redRow1 ? r0 : r1) + rx;
+		for (int x = 0; x < width; ++x)
+		{
+			out[3 * x + 0] = rowR[2 * x];
+			out[3 * x + 1] = static_cast<uint16_t>((g0[2 * x] + g1[2 * x] + 1) >> 1);
+			out[3 * x + 2] = rowB[2 * x];
+		}
+	}
+
+	//! Averages the 2x2 pixels of the two RGB rows to width RGB pixels
+	inline void HalveRows( const uint16_t *a, const uint16_t *b, int width, uint16_t *out )
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			for (int c = 0; c < 3; ++c)
+				out[3 * x + c] = static_cast<uint16_t>((a[6 * x + c] + a[6 * x + 3 + c] + b[6 * x + c] + b[6 * x + 3 + c] + 2) >> 2);
+		}
+	}
+
+	//! Stores the RGB row to the output type of the job
+	template<typename T>
+	inline void StoreRow( const Job &job, const uint16_t *in, int width, T *out )
+	{
+		const int ch = job.channels;
+		const int r = job.bgr ? 2 : 0, b = job.bgr ? 0 : 2;
+		for (int x = 0; x < width; ++x)
+		{
+			out[ch * x + r] = static_cast<T>(in[3 * x + 0] >> job.outShift);
+			out[ch * x + 1] = static_cast<T>(in[3 * x + 1] >> job.outShift);
+			out[ch * x + b] = static_cast<T>(in[3 * x + 2] >> job.outShift);
+			if (ch == 4)
+				out[ch * x + 3] = static_cast<T>(0xff);
+		}
+	}
+
+	inline void Store( const Job &job, int level, int y, const uint16_t *in )
+	{
+		char *row = job.dst[level] + job.dstStride[level] * size_t(y);
+		if (job.out8)
+			StoreRow(job, in, job.levelWidth[level], reinterpret_cast<uint8_t*>(row));
+		else
+			StoreRow(job, in, job.levelWidth[level], reinterpret_cast<uint16_t*>(row));
+	}
+
+	//! Converts the level 0 rows [y0, y1) and the rows of the next levels below them
+	/*!
+	y0 is a multiple of 2^(levels - 1), so the rows of every level are computed from the rows of the stripe only.
+	*/
+	inline void ConvertStripe( const Job &job, int y0, int y1, Scratch &scratch )
+	{
+		for (int level = 0; level < job.levels; ++level)
+		{
+			const size_t size = size_t(((y1 - y0) >> level) + 1) * job.levelWidth[level] * 3;
+			if (scratch.level[level].size() < size)
+				scratch.level[level].resize(size);
+		}
+
+		const size_t stride0 = size_t(job.levelWidth[0]) * 3;
+		for (int y = y0; y < y1; ++y)
+		{
+			const uint16_t *r0 = LoadRow(job, 2 * y, scratch.row[0]);
+			const uint16_t *r1 = LoadRow(job, 2 * y + 1, scratch.row[1]);
+			uint16_t *out = scratch.level[0].data() + stride0 * (y - y0);
+			BinQuads(r0, r1, job.levelWidth[0], job.cfa, out);
+			Store(job, 0, y, out);
+		}
+
+		for (int level = 1; level < job.levels; ++level)
+		{
+			const int first = y0 >> level, last = std::min(job.levelHeight[level], y1 >> level);
+			const size_t strideIn = size_t(job.levelWidth[level - 1]) * 3, strideOut = size_t(job.levelWidth[level]) * 3;
+			const uint16_t *in = scratch.level[level - 1].data();
+			for (int y = first; y < last; ++y)
+			{
+				const int i = 2 * (y - first);
+				uint16_t *out = scratch.level[level].data() + strideOut * (y - first);
+				HalveRows(in + strideIn * i, in + strideIn * (i + 1), job.levelWidth[level], out);
+				Store(job, level, y, out);
+			}
+		}
+	}
+
+	//! Returns the level 0 rows of the stripe, a multiple of 2^(levels - 1) fitting StripeBytes
+	inline int GetStripeRows( const Job &job, int threads )
+	{
+		const int align = 1 << (job.levels - 1);
+		const int rowBytes = std::max(1, job.width * 2 * 2 + job.levelWidth[0] * 3 * 2);
+		const int fit = IpxBayerKernels::StripeBytes / rowBytes;
+		const int share = (job.levelHeight[0] + threads - 1) / threads;
+		const int rows = std::max(align, std::min(fit, share));
+		return (rows + align - 1) / align * align;
+	}
+
+} // end of namespace IpxPyramidKernels
+
+/*!
+\brief Component converting the Bayer image to the RGB pyramid of DEBAYER_PYRAMID_LEVELS levels in one pass
+\details Level 0 has the half width and height of the source, every next level halves it again, the odd row and
+column of the level are dropped. Level 0 is demosaiced by binning the 2x2 quads of the CFA, it does not interpolate,
+so it has no zipper or color artifacts and is several times faster than the full demosaicing followed by resizing;
+the next levels are the box averages of the previous one. The source types are the ones of IpxBayerCpu: II_PIX_BAYGR8
+... II_PIX_BAYBG16 and the packed II_PIX_BAYGR10_PACKED_GEV ... II_PIX_BAYBG12_PACKED_PFNC. The outputs are RGB8,
+BGR8, RGBA8, BGRA8 and, for the sources deeper than 8 bits, the 16-bit RGB and BGR types; the 8-bit values are shifted
+right by (depth - 8).
+
+The source is read once: the image is split to the stripes of the rows, each stripe bins the quads and computes the
+rows of all the levels below it from the buffers kept in the cache. The stripes run on the worker pool selected by
+DEBAYER_THREADS_NUM and DEBAYER_SHARED_POOL, as in IpxBayerCpu.
+
+The output images are passed in the array of DEBAYER_PYRAMID_LEVELS images. The data is allocated by the component if
+the image does not fit and is reused by the next frames of the same size, DEBAYER_NOREALLOCT makes the conversion fail
+with IPX_ERR_BAYER_NO_MEMORY instead.
+\code
+IpxBayerPyramid *pyramid = IpxBayerPyramid::CreateComponent();
+pyramid->GetComponent()->SetParamInt(DEBAYER_PYRAMID_LEVELS, 3);
+
+IpxImage levels[3];		// 1/2, 1/4 and 1/8, kept between the frames
+levels[0].pixelTypeDescr.pixelType = II_PIX_BGR8;
+...
+IpxError err = pyramid->ConvertImage(raw, levels);
+...
+IpxBayerPyramid::DeleteComponent(pyramid);
+\endcode
+*/
+class IpxBayerPyramid final
+{
+public:
+
+	//! Creates the component
+	static IpxBayerPyramid* CreateComponent() { return new IpxBayerPyramid(); }
+
+	//! Deletes the component and the data allocated by it
+	static void DeleteComponent( IpxBayerPyramid* in ) { delete in; }
+
+	IpxBayerPyramid() {}
+	virtual ~IpxBayerPyramid() {}
+
+	IpxComponent* GetComponent() { return &m_component; }
+
+	//! Returns the number of the levels set by DEBAYER_PYRAMID_LEVELS
+	int GetLevels() const { return m_component.GetLevels(); }
+
+	//! Converts the Bayer image to the levels
+	/*!
+	\param[in] pSrc the Bayer image, the width and the height are at least 2^DEBAYER_PYRAMID_LEVELS
+	\param[in,out] pLevels the array of GetLevels images, the pixel type of pLevels[0] selects the output type of all
+		the levels, the data is allocated by the component if the image does not fit
+	*/
+	IpxError ConvertImage( const IpxImage* pSrc, IpxImage* pLevels )
+	{
+		IpxBayerKernels::Source source;
+		if (!pSrc || !pLevels || !pSrc->imageData || !IpxBayerKernels::GetSource(pSrc->pixelTypeDescr.pixelType, m_component.GetIsa(), &source))
+			return IPX_ERR_BAYER_INVALID_ARGUMENT;
+
+		IpxPyramidKernels::Job job;
+		job.levels = GetLevels();
+		if ((pSrc->width >> job.levels) == 0 || (pSrc->height >> job.levels) == 0 || pSrc->width > INT_MAX / 4 || pSrc->height > INT_MAX / 4)
+			return IPX_ERR_BAYER_INVALID_ARGUMENT;
+		const size_t rowBytes = source.unpack ? IpxUnpackKernels::GetPackedRowBytes(pSrc->pixelTypeDescr.pixelType, pSrc->width)
+			: size_t(pSrc->width) * source.bits / 8;
+		if (pSrc->rowSize < rowBytes)
+			return IPX_ERR_BAYER_INVALID_ARGUMENT;
+
+		const uint32_t dstType = IpxBayerKernels::GetOutputType(source, pLevels[0].pixelTypeDescr.pixelType);
+		if (m_data.size() < size_t(job.levels))
+			m_data.resize(job.levels);
+		for (int level = 0; level < job.levels; ++level)
+		{
+			IpxImage *dst = &pLevels[level];
+			const uint32_t width = pSrc->width >> (level + 1), height = pSrc->height >> (level + 1);
+			if (!Fits(dst, dstType, width, height))
+			{
+				if (m_component.GetNoRealloc())
+					return IPX_ERR_BAYER_NO_MEMORY;
+				IpxError err = Alloc(dst, dstType, width, height, m_data[level]);
+				if (err != IPX_ERR_OK)
+					return err;
+			}
+			job.dst[level] = dst->imageData;
+			job.dstStride[level] = dst->rowSize;
+			job.levelWidth[level] = static_cast<int>(width);
+			job.levelHeight[level] = static_cast<int>(height);
+		}
+
+		job.src = pSrc->imageData;
+		job.srcStride = pSrc->rowSize;
+		job.width = static_cast<int>(pSrc->width);
+		job.height = static_cast<int>(pSrc->height);
+		job.cfa = source.cfa;
+		job.srcBits = source.bits;
+		job.unpack = source.unpack;
+		job.channels = (dstType == II_PIX_RGBA8 || dstType == II_PIX_BGRA8) ? 4 : 3;
+		job.bgr = IpxBayerKernels::IsBgr(dstType);
+		job.out8 = IpxBayerKernels::Is8Bit(dstType);
+		job.outShift = job.out8 ? source.depth - 8 : 0;
+
+		try
+		{
+			ConvertStripes(job);
+		}
+		catch (const std::bad_alloc&)
+		{
+			return IPX_ERR_BAYER_NO_MEMORY;
+		}
+
+		for (int level = 0; level < job.levels; ++level)
+		{
+			pLevels[level].timestamp = pSrc->timestamp;
+			pLevels[level].imageID = pSrc->imageID;
+		}
+		return IPX_ERR_OK;
+	}
+
+	//! Sets the worker pool used by the component, for example the pool of IpxBayerCpu
+	/*!
+	\param[in] pool the pool, nullptr - the pool selected by DEBAYER_SHARED_POOL
+	*/
+	void SetWorkerPool( const std::shared_ptr<IpxToolsImpl::WorkerPool> &pool )
+	{
+		m_pool.SetWorkerPool(pool);
+	}
+
+	//! Returns the worker pool used by the component, the pool is created if it is needed
+	std::shared_ptr<IpxToolsImpl::WorkerPool> GetWorkerPool()
+	{
+		return m_pool.GetWorkerPool(m_component.GetSharedPool(), m_component.GetThreads());
+	}
+
+	//! Releases the level data and the stripe buffers
+	void ReleaseData()
+	{
+		std::vector<std::vector<uint64_t>>().swap(m_data);
+		std::vector<IpxPyramidKernels::Scratch>().swap(m_scratch);
+	}
+
+private:
+	class Component : public IpxToolsImpl::ParamComponent
+	{
+	public:
+		Component() : IpxToolsImpl::ParamComponent(IPX_CMP_BAYER_DEMOSAICING)
+		{
+			m_levels = AddParamInt(DEBAYER_PYRAMID_LEVELS, 3, 1, IpxPyramidKernels::MaxLevels);
+			m_noRealloc = AddParamInt(DEBAYER_NOREALLOCT, 0, 0, 1);
+			m_threads = AddParamInt(DEBAYER_THREADS_NUM, 0, 0, 32);
+			m_sharedPool = AddParamInt(DEBAYER_SHARED_POOL, 0, 0, 1);
+			AddIsaParams(DEBAYER_FORCE_ISA, DEBAYER_ACTIVE_ISA);
+		}
+
+		int GetLevels() const { return static_cast<int>(GetInt(m_levels)); }
+		bool GetNoRealloc() const { return GetInt(m_noRealloc) != 0; }
+		int GetThreads() const { return static_cast<int>(GetInt(m_threads)); }
+		bool GetSharedPool() const { return GetInt(m_sharedPool) != 0; }
+
+	private:
+		size_t m_levels, m_noRealloc, m_threads, m_sharedPool;
+	};
+
+	// the stripes are the rows of level 0, each one bins the source rows below it
+	void ConvertStripes( const IpxPyramidKernels::Job &job )
+	{
+		m_pool.RunStripes(m_component.GetSharedPool(), m_component.GetThreads(), job.levelHeight[0], m_scratch,
+			[&]( int threads ) { return IpxPyramidKernels::GetStripeRows(job, threads); },
+			[&]( int y0, int y1, IpxPyramidKernels::Scratch &scratch ) { IpxPyramidKernels::ConvertStripe(job, y0, y1, scratch); });
+	}
+
+	static bool Fits( const IpxImage* pDst, uint32_t type, uint32_t width, uint32_t height )
+	{
+		return pDst->imageData && pDst->pixelTypeDescr.pixelType == type && pDst->width == width && pDst->height == height
+			&& pDst->rowSize >= IpxGetRowSizeUnaligned(type, width) && uint64_t(pDst->imageSize) >= uint64_t(pDst->rowSize) * height;
+	}
+
+	static IpxError Alloc( IpxImage* pDst, uint32_t type, uint32_t width, uint32_t height, std::vector<uint64_t> &storage )
+	{
+		try
+		{
+			if (!IpxToolsImpl::InitOwnedImage(pDst, type, width, height, storage))
+				return IPX_ERR_BAYER_INVALID_ARGUMENT;
+		}
+		catch (const std::bad_alloc&)
+		{
+			return IPX_ERR_BAYER_NO_MEMORY;
+		}
+		return IPX_ERR_OK;
+	}
+
+	Component m_component;
+	std::vector<std::vector<uint64_t>> m_data;			// per level
+	std::vector<IpxPyramidKernels::Scratch> m_scratch;	// per worker of the pool, 0 - the calling thread
+	IpxToolsImpl::ComponentPool m_pool;
+};
+
+#endif // __cplusplus
+
+#endif // _IPX_BAYER_PYRAMID_H_
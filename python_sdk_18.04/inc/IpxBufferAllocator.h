@@ -0,0 +1,434 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Camera SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxBufferAllocator.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Huge-page and NUMA-aware allocator of the stream buffers
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IPX_BUFFER_ALLOCATOR_H
+#define IPX_BUFFER_ALLOCATOR_H
+
+#include "IpxCameraApi.h"
+
+#ifdef __cplusplus
+
+#include <map>
+#include <mutex>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+/*! \namespace IpxCamMem
+    \brief A namespace provides the placement-aware memory allocation of the stream buffers.
+
+    \details The stream allocates the buffer memory in CreateBuffer with no control over the page size and the NUMA node.
+    The BufferAllocator maps the buffers with the requested policy, the memory is passed to the stream by Stream::SetBuffer:
+    \code
+    IpxCamMem::AllocPolicy policy;
+    policy.pageSize = IpxCamMem::PageHuge2MB;
+    policy.numaNode = IpxCamMem::LocalNode;    // node of the thread, which processes the frames
+    IpxCamMem::BufferAllocator allocator(policy);
+
+    auto buffer = IpxCamMem::CreateBuffer(stream, &allocator, stream->GetBufferSize());
+    ...
+    IpxCamMem::RevokeBuffer(stream, &allocator, buffer);
+    \endcode
+*/
+namespace IpxCamMem
+{
+    //! An enumeration of the page sizes of the buffer memory
+    enum PageSize : uint32_t
+    {
+        PageDefault = 0,        /*!< Regular pages of the system */
+        PageTransparentHuge,    /*!< Regular mapping advised to be backed by the transparent huge pages (Linux) */
+        PageHuge2MB,            /*!< 2 MB huge pages (Linux hugetlbfs, Windows large pages) */
+        PageHuge1GB             /*!< 1 GB huge pages (Linux hugetlbfs) */
+    };
+
+    //! NUMA node value: no binding, the memory is placed by the system policy
+    const int32_t AnyNode = -1;
+    //! NUMA node value: the node of the CPU the allocating thread runs on
+    const int32_t LocalNode = -2;
+
+    //! Allocation policy of the buffer memory
+    struct AllocPolicy
+    {
+        PageSize pageSize;  /*!< Page size of the mapping */
+        int32_t  numaNode;  /*!< NUMA node to bind the memory to, AnyNode or LocalNode */
+        size_t   alignment; /*!< Alignment of the buffer start, power of two. 0 - page size */
+        bool     fallback;  /*!< If true, the regular pages are used when the huge pages are not available on the node */
+
+        AllocPolicy() : pageSize(PageDefault), numaNode(AnyNode), alignment(0), fallback(true) {}
+    };
+
+    //! Memory statistics of the NUMA node
+    struct NodeStats
+    {
+        int32_t  node;          /*!< NUMA node, AnyNode if the placement is unknown */
+        uint64_t bytesMapped;   /*!< Bytes currently mapped on the node */
+        uint64_t hugeBytes;     /*!< Part of bytesMapped, backed by the huge pages (hugetlbfs or large pages) */
+        uint64_t allocations;   /*!< Number of the live allocations on the node */
+    };
+
+    /**
+    \brief Allocator of the buffer memory with the page size, NUMA node and alignment policy.
+    \details The allocator is thread safe. All the memory still allocated is unmapped by the destructor,
+    so the allocator must outlive the streams, which use its buffers.
+    */
+    class BufferAllocator
+    {
+    public:
+
+        explicit BufferAllocator( const AllocPolicy &policy = AllocPolicy() ) : m_policy(policy) {}
+
+        ~BufferAllocator()
+        {
+            for (auto &entry : m_blocks)
+                Unmap(entry.first, entry.second);
+        }
+
+        //! Returns the allocation policy
+        const AllocPolicy& GetPolicy() const { return m_policy; }
+
+        //! Allocates the memory block
+        /*!
+        \param[in] size size of the block in bytes
+        \param[in] alignment minimal alignment of the block in addition to the policy one, for example Stream::GetBufferAlignment()
+        \param[out] err returns IPX_CAM_ERR_INVALID_ARGUMENT for zero size or not power of two alignment, IPX_CAM_ERR_UNKNOWN if
+        the memory cannot be mapped with the policy
+        \return Returns the pointer to the block or nullptr
+        */
+        void* Allocate( size_t size, size_t alignment = 0, IpxCamErr *err = nullptr )
+        {
+            alignment = std::max(alignment, m_policy.alignment);
+            if (!size || (alignment & (alignment - 1)))
+            {
+                SetErr(err, IPX_CAM_ERR_INVALID_ARGUMENT);
+                return nullptr;
+            }
+
+            Block block;
+            void *ptr = Map(size, alignment, m_policy.pageSize, &block);
+            if (!ptr && m_policy.fallback && m_policy.pageSize != PageDefault)
+                ptr = Map(size, alignment, PageDefault, &block);
+            if (!ptr)
+            {
+                SetErr(err, IPX_CAM_ERR_UNKNOWN);
+                return nullptr;
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_blocks[ptr] = block;
+            auto &stats = Stats(block.node);
+            stats.bytesMapped += block.length;
+            stats.hugeBytes += block.huge ? block.length : 0;
+            ++stats.allocations;
+            SetErr(err, IPX_CAM_ERR_OK);
+            return ptr;
+        }
+
+        //! Frees the memory block allocated by Allocate
+        IpxCamErr Free( void *ptr )
+        {
+            Block block;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_blocks.find(ptr);
+                if (it == m_blocks.end())
+                    return IPX_CAM_ERR_INVALID_ARGUMENT;
+
+                block = it->second;
+                m_blocks.erase(it);
+                auto &stats = Stats(block.node);
+                stats.bytesMapped -= block.length;
+                stats.hugeBytes -= block.huge ? block.length : 0;
+                --stats.allocations;
+            }
+            Unmap(ptr, block);
+            return IPX_CAM_ERR_OK;
+        }
+
+        //! Returns the memory statistics per NUMA node, the nodes without the allocations are not reported
+        std::vector<NodeStats> GetStats()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::vector<NodeStats> result;
+            for (auto &stats : m_stats)
+                if (stats.allocations)
+                    result.push_back(stats);
+            return result;
+        }
+
+        //! Returns the NUMA node of the CPU the calling thread runs on, or AnyNode if it is unknown
+        static int32_t GetCurrentNode()
+        {
+#ifdef _WIN32
+            PROCESSOR_NUMBER proc;
+            USHORT node = 0;
+            GetCurrentProcessorNumberEx(&proc);
+            return GetNumaProcessorNodeEx(&proc, &node) ? static_cast<int32_t>(node) : AnyNode;
+#elif defined(SYS_getcpu)
+            unsigned cpu = 0, node = 0;
+            return syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 ? static_cast<int32_t>(node) : AnyNode;
+#else
+            return AnyNode;
+#endif
+        }
+
+    private:
+
+        struct Block
+        {
+            void    *base;      // start of the mapping
+            size_t   length;    // length of the mapping
+            int32_t  node;      // NUMA node of the memory
+            bool     huge;      // backed by huge pages
+        };
+
+        static void SetErr( IpxCamErr *err, IpxCamErr code )
+        {
+            if (err)
+                *err = code;
+        }
+
+        NodeStats& Stats( int32_t node )
+        {
+            auto it = std::find_if(m_stats.begin(), m_stats.end(), [node](const NodeStats &s){ return s.node == node; });
+            if (it != m_stats.end())
+                return *it;
+            NodeStats stats = { node, 0, 0, 0 };
+            m_stats.push_back(stats);
+            return m_stats.back();
+        }
+
+        static size_t RoundUp( size_t value, size_t align ) { return (value + align - 1) / align * align; }
+
+#ifdef _WIN32
+
+        void* Map( size_t size, size_t alignment, PageSize pageSize, Block *block )
+        {
+            // VirtualAlloc returns the blocks aligned to the allocation granularity (64 KB) or to the large page size
+            const bool large = pageSize == PageHuge2MB || pageSize == PageHuge1GB;
+            const size_t page = large ? GetLargePageMinimum() : 0;
+            if ((large && !page) || alignment > (large ? page : 0x10000))
+                return nullptr;
+
+            const int32_t node = m_policy.numaNode == LocalNode ? GetCurrentNode() : m_policy.numaNode;
+            const size_t length = large ? RoundUp(size, page) : size;
+            const DWORD type = MEM_RESERVE | MEM_COMMIT | (large ? MEM_LARGE_PAGES : 0);
+            void *ptr = node >= 0
+                ? VirtualAllocExNuma(GetCurrentProcess(), nullptr, length, type, PAGE_READWRITE, static_cast<DWORD>(node))
+                : VirtualAlloc(nullptr, length, type, PAGE_READWRITE);
+            if (!ptr)
+                return nullptr;
+
+            block->base = ptr;
+            block->length = length;
+            block->node = node;
+            block->huge = large;
+            return ptr;
+        }
+
+        static void Unmap( void*, const Block &block )
+        {
+            VirtualFree(block.base, 0, MEM_RELEASE);
+        }
+
+#else
+
+        void* Map( size_t size, size_t alignment, PageSize pageSize, Block *block )
+        {
+            const size_t systemPage = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            size_t page = systemPage;
+            int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_HUGETLB
+            const int hugeShift = 26; // MAP_HUGE_SHIFT
+            if (pageSize == PageHuge2MB)
+            {
+                page = size_t(1) << 21;
+                flags |= MAP_HUGETLB | (21 << hugeShift);
+            }
+            else if (pageSize == PageHuge1GB)
+            {
+                page = size_t(1) << 30;
+                flags |= MAP_HUGETLB | (30 << hugeShift);
+            }
+#else
+            if (pageSize == PageHuge2MB || pageSize == PageHuge1GB)
+                return nullptr;
+#endif
+            if (pageSize == PageTransparentHuge)
+                alignment = std::max(alignment, size_t(1) << 21);
+
+            // the mapping is page aligned, the larger alignment is done by trimming the over-sized mapping
+            const size_t length = RoundUp(size, page);
+            const size_t extra = alignment > page ? alignment : 0;
+            auto base = static_cast<uint8_t*>(mmap(nullptr, length + extra, PROT_READ | PROT_WRITE, flags, -1, 0));
+            if (base == MAP_FAILED)
+                return nullptr;
+
+            uint8_t *ptr = base;
+            if (extra)
+            {
+                ptr = reinterpret_cast<uint8_t*>(RoundUp(reinterpret_cast<size_t>(base), alignment));
+                if (ptr != base)
+                    munmap(base, ptr - base);
+                if (ptr + length != base + length + extra)
+                    munmap(ptr + length, base + length + extra - (ptr + length));
+            }
+
+#ifdef MADV_HUGEPAGE
+            if (pageSize == PageTransparentHuge)
+                madvise(ptr, length, MADV_HUGEPAGE);
+#endif
+
+            const bool huge = pageSize == PageHuge2MB || pageSize == PageHuge1GB;
+            int32_t node = m_policy.numaNode == LocalNode ? GetCurrentNode() : m_policy.numaNode;
+#ifdef SYS_mbind
+            if (node >= 0)
+            {
+                // mmap reserves the huge pages of any node, the bound node must have them free
+                if (huge && GetFreeHugePages(node, page) < length / page)
+                {
+                    munmap(ptr, length);
+                    return nullptr;
+                }
+                // MPOL_BIND, the pages are faulted in below, so they are placed on the node before the first use
+                std::vector<unsigned long> mask(node / (8 * sizeof(unsigned long)) + 1, 0);
+                mask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+                if (syscall(SYS_mbind, ptr, length, 2, mask.data(), mask.size() * 8 * sizeof(unsigned long) + 1, 0) != 0)
+                    node = AnyNode;
+            }
+#endif
+            // fault the pages in, so the frame does not pay the page faults and the memory is accounted to its node
+            if (!Populate(ptr, length, systemPage))
+            {
+                munmap(ptr, length);
+                return nullptr;
+            }
+
+            if (node < 0)
+                node = QueryNode(ptr);
+
+            block->base = ptr;
+            block->length = length;
+            block->node = node;
+            block->huge = huge;
+            return ptr;
+        }
+
+        // MADV_POPULATE_WRITE (Linux 5.14) fails instead of SIGBUS if the bound node has run out of the huge pages,
+        // the older kernels touch the pages
+        static bool Populate( uint8_t *ptr, size_t length, size_t systemPage )
+        {
+            const int populateWrite = 23; // MADV_POPULATE_WRITE
+            if (madvise(ptr, length, populateWrite) == 0)
+                return true;
+            if (errno != EINVAL)
+                return false;
+            for (size_t offset = 0; offset < length; offset += systemPage)
+                ptr[offset] = 0;
+            return true;
+        }
+
+        // returns the free huge pages of the size on the node, SIZE_MAX if the node does not report them
+        static size_t GetFreeHugePages( int32_t node, size_t page )
+        {
+            char path[128];
+            snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/hugepages/hugepages-%zukB/free_hugepages",
+                static_cast<int>(node), page >> 10);
+            FILE *file = fopen(path, "r");
+            if (!file)
+                return SIZE_MAX;
+            unsigned long count = 0;
+            const bool read = fscanf(file, "%lu", &count) == 1;
+            fclose(file);
+            return read ? static_cast<size_t>(count) : SIZE_MAX;
+        }
+
+        static void Unmap( void *ptr, const Block &block )
+        {
+            munmap(ptr, block.length);
+        }
+
+        // returns the node of the page by get_mempolicy(MPOL_F_NODE | MPOL_F_ADDR)
+        static int32_t QueryNode( void *ptr )
+        {
+#ifdef SYS_get_mempolicy
+            int node = -1;
+            if (syscall(SYS_get_mempolicy, &node, nullptr, 0, ptr, 1 | 2) == 0 && node >= 0)
+                return node;
+#endif
+            (void)ptr;
+            return AnyNode;
+        }
+
+#endif
+
+        AllocPolicy m_policy;
+        std::mutex m_mutex;
+        std::map<void*, Block> m_blocks;
+        std::vector<NodeStats> m_stats;
+    };
+
+    //! Creates the stream buffer in the memory of the allocator
+    /*!
+    \param[in] stream the data stream
+    \param[in] allocator the allocator, the memory is aligned to Stream::GetBufferAlignment() in addition to the policy
+    \param[in] size size of the buffer in bytes
+    \param[in] pPrivate pointer to the user's data
+    \param[out] err returns the error code
+    \return Returns the pointer to Buffer, which must be revoked by RevokeBuffer with the same allocator
+    */
+    inline IpxCam::Buffer* CreateBuffer( IpxCam::Stream *stream, BufferAllocator *allocator, size_t size, void *pPrivate = nullptr, IpxCamErr *err = nullptr )
+    {
+        if (!stream || !allocator)
+        {
+            if (err)
+                *err = IPX_CAM_ERR_INVALID_ARGUMENT;
+            return nullptr;
+        }
+
+        auto ptr = allocator->Allocate(size, stream->GetBufferAlignment(), err);
+        if (!ptr)
+            return nullptr;
+
+        auto buffer = stream->SetBuffer(ptr, size, pPrivate, err);
+        if (!buffer)
+            allocator->Free(ptr);
+        return buffer;
+    }
+
+    //! Revokes the buffer created by CreateBuffer and frees its memory
+    inline IpxCamErr RevokeBuffer( IpxCam::Stream *stream, BufferAllocator *allocator, IpxCam::Buffer *buffer )
+    {
+        if (!stream || !allocator || !buffer)
+            return IPX_CAM_ERR_INVALID_ARGUMENT;
+
+        void *ptr = buffer->GetBufferPtr();
+        auto err = stream->RevokeBuffer(buffer);
+        if (err == IPX_CAM_ERR_OK)
+            err = allocator->Free(ptr);
+        return err;
+    }
+
+} // end of namespace IpxCamMem
+
+#endif // __cplusplus
+
+#endif // IPX_BUFFER_ALLOCATOR_H
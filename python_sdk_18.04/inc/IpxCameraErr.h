@@ -48,6 +48,8 @@ enum IpxCamErr
     IPX_CAM_ERR_INVALID_INDEX = -40005,
 	IPX_CAM_ERR_NO_DEVICE = -40006,
 	IPX_CAM_ERR_INVALID_ARGUMENT = -40007,
+	IPX_CAM_ERR_TIMEOUT = -1011,	// GC_ERR_TIMEOUT, the wait for the buffer or the frame expired
+	IPX_CAM_ERR_ABORT = -1012,	// GC_ERR_ABORT, the wait for the buffer was cancelled
 	    
     IPX_CAM_ERR_INVALID_STATE = -40051,
     
@@ -84,6 +86,10 @@ inline const char* GetIpxCamErrString(IpxCamErr err)
 		return "No device";
 	case  IPX_CAM_ERR_INVALID_ARGUMENT: 
 		return "Invalid argument";
+	case  IPX_CAM_ERR_TIMEOUT:
+		return "Timeout";
+	case  IPX_CAM_ERR_ABORT:
+		return "Aborted";
 	case  IPX_CAM_ERR_INVALID_STATE: 
 		return "Invalid state";
 	case  IPX_CAM_ERR_FLASH_ERASE: 
@@ -114,6 +120,8 @@ inline const char* GetIpxCamErrString(IpxCamErr err)
 typedef int32_t IpxCamErr;
 #define IPX_CAM_ERR_OK      0
 #define IPX_CAM_ERR_UNKNOWN -40001
+#define IPX_CAM_ERR_TIMEOUT -1011
+#define IPX_CAM_ERR_ABORT   -1012
 
 #endif
 
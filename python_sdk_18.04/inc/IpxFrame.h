@@ -0,0 +1,207 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Camera SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxFrame.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Reference-counted zero-copy frame handles over the stream buffers
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IPX_FRAME_H
+#define IPX_FRAME_H
+
+#include "IpxCameraApi.h"
+
+#ifdef __cplusplus
+
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <condition_variable>
+
+/*! \namespace IpxCamFrame
+    \brief A namespace provides the reference-counted handles of the acquired frames.
+
+    \details The image returned by Buffer::GetImage is valid until the buffer is queued back to the stream, so passing it to
+    another thread requires a copy. The Frame handle keeps the buffer out of the input pool while any copy of the handle exists
+    and queues it back automatically when the last copy is destroyed:
+    \code
+    IpxCamFrame::FrameQueue frames(stream);
+    ...
+    IpxCamFrame::Frame frame = frames.GetFrame(1000);
+    if (frame)
+        worker.Post([frame]{ Process(frame.GetImage()); });   // no copy, the buffer is requeued after Process
+    ...
+    // stopping: the frames still held by the workers must not be requeued to the flushed stream
+    frames.SetRequeue(false);
+    frames.WaitReleased(5000);
+    stream->FlushBuffers(IpxCam::Flush_AllDiscard);
+    \endcode
+*/
+namespace IpxCamFrame
+{
+    class FrameQueue;
+
+    /**
+    \brief Reference-counted handle of the acquired buffer.
+    \details Copying the handle is cheap and thread safe (one atomic increment). The image and the buffer memory stay valid
+    until the last copy is destroyed or reset.
+    */
+    class Frame
+    {
+    public:
+
+        //! Creates the empty handle
+        Frame() {}
+
+        //! Returns true if the handle refers to a buffer
+        explicit operator bool() const { return m_holder != nullptr; }
+
+        //! Returns the buffer or nullptr for the empty handle. The buffer must not be queued by the application.
+        IpxCam::Buffer* GetBuffer() const { return m_holder ? m_holder->buffer : nullptr; }
+
+        //! Returns the image of the buffer or nullptr for the empty handle
+        IpxImage* GetImage() const { return m_holder ? m_holder->buffer->GetImage() : nullptr; }
+
+        //! Returns the pointer to the image data or nullptr for the empty handle
+        const void* GetData() const
+        {
+            return m_holder ? static_cast<const uint8_t*>(m_holder->buffer->GetBufferPtr()) + m_holder->buffer->GetImageOffset() : nullptr;
+        }
+
+        uint64_t GetFrameID() const { return m_holder ? m_holder->buffer->GetFrameID() : 0; }
+        uint64_t GetTimestamp() const { return m_holder ? m_holder->buffer->GetTimestamp() : 0; }
+
+        //! Returns the number of the handles referring to the buffer
+        long GetUseCount() const { return m_holder.use_count(); }
+
+        //! Releases the reference, the buffer is requeued if it was the last one
+        void Reset() { m_holder.reset(); }
+
+    private:
+        friend class FrameQueue;
+
+        struct State;
+
+        // the holder is destroyed with the last handle and returns the buffer to the stream
+        struct Holder
+        {
+            Holder( const std::shared_ptr<State> &s, IpxCam::Buffer *b ) : state(s), buffer(b) {}
+            ~Holder();
+
+            std::shared_ptr<State> state;
+            IpxCam::Buffer *buffer;
+        };
+
+        explicit Frame( const std::shared_ptr<Holder> &holder ) : m_holder(holder) {}
+
+        std::shared_ptr<Holder> m_holder;
+    };
+
+    // state shared by the queue and its frames
+    struct Frame::State
+    {
+        explicit State( IpxCam::Stream *s ) : stream(s), outstanding(0), requeue(true) {}
+
+        IpxCam::Stream *stream;
+        std::mutex mutex;
+        std::condition_variable cv;
+        size_t outstanding;
+        bool requeue;
+    };
+
+    inline Frame::Holder::~Holder()
+    {
+        // the mutex is held while queuing, so the buffer is never queued after SetRequeue(false) returned
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->requeue)
+            state->stream->QueueBuffer(buffer);
+        --state->outstanding;
+        state->cv.notify_all();
+    }
+
+    /**
+    \brief Source of the Frame handles of one stream
+    \details The queue can be destroyed before the handles, the last handle then still returns the buffer to the stream,
+    so the stream must not be released while the handles exist.
+    */
+    class FrameQueue
+    {
+    public:
+
+        explicit FrameQueue( IpxCam::Stream *stream ) : m_state(std::make_shared<Frame::State>(stream)) {}
+
+        //! Retrieves the buffer by Stream::GetBuffer and wraps it to the Frame
+        /*!
+        \param[in] iTimeout timeout in milliseconds
+        \param[out] err returns the error code of GetBuffer
+        \return Returns the Frame, empty on the error
+        */
+        Frame GetFrame( uint64_t iTimeout, IpxCamErr *err = nullptr )
+        {
+            auto buffer = m_state->stream->GetBuffer(iTimeout, err);
+            return buffer ? Wrap(buffer) : Frame();
+        }
+
+        //! Wraps the buffer, which was retrieved from the stream by the application (GetBuffer or the push mode callback)
+        /*!
+        The ownership of the buffer is passed to the Frame, the application must not queue it.
+        */
+        Frame Wrap( IpxCam::Buffer *buffer )
+        {
+            if (!buffer)
+                return Frame();
+            {
+                std::lock_guard<std::mutex> lock(m_state->mutex);
+                ++m_state->outstanding;
+            }
+            return Frame(std::make_shared<Frame::Holder>(m_state, buffer));
+        }
+
+        //! Returns the number of the buffers held by the Frame handles
+        size_t GetNumOutstanding() const
+        {
+            std::lock_guard<std::mutex> lock(m_state->mutex);
+            return m_state->outstanding;
+        }
+
+        //! Enables or disables queuing of the released buffers to the stream
+        /*!
+        Disable the requeue before the acquisition is stopped and the stream is flushed, so the buffers released later do not
+        go back to the input pool. Such buffers stay announced and can be revoked.
+        */
+        void SetRequeue( bool requeue )
+        {
+            std::lock_guard<std::mutex> lock(m_state->mutex);
+            m_state->requeue = requeue;
+        }
+
+        //! Waits until all the Frame handles are released
+        /*!
+        \param[in] iTimeout timeout in milliseconds, UINT64_MAX - infinite
+        \return Returns false on timeout
+        */
+        bool WaitReleased( uint64_t iTimeout )
+        {
+            std::unique_lock<std::mutex> lock(m_state->mutex);
+            auto released = [this]{ return m_state->outstanding == 0; };
+            if (iTimeout == UINT64_MAX)
+            {
+                m_state->cv.wait(lock, released);
+                return true;
+            }
+            return m_state->cv.wait_for(lock, std::chrono::milliseconds(iTimeout), released);
+        }
+
+    private:
+        std::shared_ptr<Frame::State> m_state;
+    };
+
+} // end of namespace IpxCamFrame
+
+#endif // __cplusplus
+
+#endif // IPX_FRAME_H
@@ -0,0 +1,675 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Camera SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxFrameSync.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Hardware timestamp alignment and frame set assembly of several cameras
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IPX_FRAME_SYNC_H
+#define IPX_FRAME_SYNC_H
+
+#include "IpxCameraApi.h"
+#include "IpxFrame.h"
+
+#ifdef __cplusplus
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <condition_variable>
+
+/*! \namespace IpxCamSync
+    \brief A namespace provides the assembly of the synchronized frame sets of several cameras.
+
+    \details The timestamp of every buffer is converted from the ticks of its camera to the common host clock (nanoseconds
+    of std::chrono::steady_clock). The conversion is calibrated by GevTimestampControlLatch (TimestampLatch) and
+    GevTimestampTickFrequency and is re-calibrated periodically, so the drift of the camera clocks is compensated.
+    The frames of all the cameras within the tolerance are returned as one FrameSet:
+    \code
+    std::vector<IpxCam::Device*> devices = ...;   // streams are started
+    IpxCamSync::SyncParams params;
+    params.tolerance = 2000000;                    // 2 ms
+    IpxCamSync::FrameSync sync(devices, params);
+    sync.Start();
+    while (...)
+    {
+        IpxCamSync::FrameSet set = sync.GetFrameSet(1000);
+        if (set.IsComplete())
+            Process(set[0].GetImage(), set[1].GetImage());
+    }   // the buffers are requeued when the set is destroyed
+    sync.Stop();
+    \endcode
+*/
+namespace IpxCamSync
+{
+    //! An enumeration of the straggler handling
+    enum StragglerPolicy
+    {
+        StragglerDrop = 0,  /*!< The frame without the partners is dropped (requeued), only complete sets are returned */
+        StragglerFlag = 1   /*!< The frame is returned in the incomplete set, FrameSet::IsComplete returns false */
+    };
+
+    //! Parameters of the frame set assembly
+    struct SyncParams
+    {
+        SyncParams() : tolerance(1000000), maxLatency(200000000), latchInterval(1000), queueDepth(64)
+            , grabTimeout(100), policy(StragglerDrop) {}
+
+        uint64_t tolerance;         //!< maximum spread of the host timestamps in one set, ns
+        uint64_t maxLatency;        //!< time to wait for the missing partners of a frame, ns
+        uint64_t latchInterval;     //!< period of the clock re-calibration, ms, 0 - calibrate only at Start
+        uint32_t queueDepth;        //!< depth of the per camera queue, power of 2, the frames are dropped on overflow
+        uint64_t grabTimeout;       //!< timeout of GetBuffer of the grabbing threads, ms
+        StragglerPolicy policy;     //!< handling of the frames without the partners
+    };
+
+    //! Returns the host clock in nanoseconds
+    inline uint64_t GetHostTime()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    /**
+    \brief Conversion of the camera timestamp ticks to the host clock
+    \details Calibrate is called by one thread, ToHost can be called by any number of threads concurrently without locking.
+    */
+    class ClockMapper
+    {
+    public:
+
+        ClockMapper() : m_seq(0), m_devRef(0), m_hostRef(0), m_scale(1.0), m_nominal(1.0), m_roundTrip(0)
+            , m_calibrations(0), m_firstDev(0), m_firstHost(0) {}
+
+        //! Latches the camera clock and updates the conversion
+        /*!
+        The latch is repeated a few times, the sample with the shortest round trip is used. The first calibration
+        sets the offset, the next ones also estimate the rate of the camera clock relative to the host clock.
+        \param[in] params the camera parameters of the device
+        \return Returns IPX_CAM_ERR_OK or the error of the latch command
+        */
+        IpxCamErr Calibrate( IpxGenParam::Array *params )
+        {
+            if (!params)
+                return IPX_CAM_ERR_INVALID_ARGUMENT;
+
+            IpxCamErr err = IPX_CAM_ERR_OK;
+            const char *latch = "GevTimestampControlLatch", *value = "GevTimestampValue";
+            if (!params->GetCommand(latch, &err) || err != IPX_CAM_ERR_OK)
+            {
+                latch = "TimestampLatch";
+                value = "TimestampLatchValue";
+            }
+
+            int64_t freq = params->GetIntegerValue("GevTimestampTickFrequency", &err);
+            if (err != IPX_CAM_ERR_OK || freq <= 0)
+                freq = 1000000000;
+
+            uint64_t bestTrip = UINT64_MAX, bestHost = 0;
+            int64_t bestDev = 0;
+            for (int i = 0; i < 5; ++i)
+            {
+                uint64_t before = GetHostTime();
+                err = params->ExecuteCommand(latch);
+                if (err != IPX_CAM_ERR_OK)
+                    return err;
+                int64_t dev = params->GetIntegerValue(value, &err);
+                if (err != IPX_CAM_ERR_OK)
+                    return err;
+                uint64_t after = GetHostTime();
+
+                // the camera latched somewhere between before and after, the midpoint has the error of half the round trip
+                if (after - before < bestTrip)
+                {
+                    bestTrip = after - before;
+                    bestHost = before + bestTrip / 2;
+                    bestDev = dev;
+                }
+            }
+
+            double nominal = 1000000000.0 / static_cast<double>(freq);
+            double scale = nominal;
+            if (m_calibrations.load(std::memory_order_relaxed) == 0)
+            {
+                m_firstDev = bestDev;
+                m_firstHost = bestHost;
+            }
+            else if (bestDev > m_firstDev)
+            {
+                // the rate is estimated over the whole history, so the latch error is divided by the long interval
+                double measured = static_cast<double>(bestHost - m_firstHost) / static_cast<double>(bestDev - m_firstDev);
+                if (measured > nominal * 0.999 && measured < nominal * 1.001)
+                    scale = measured;
+            }
+
+            m_seq.fetch_add(1, std::memory_order_acq_rel);
+            m_devRef.store(bestDev, std::memory_order_relaxed);
+            m_hostRef.store(bestHost, std::memory_order_relaxed);
+            m_scale.store(scale, std::memory_order_relaxed);
+            m_seq.fetch_add(1, std::memory_order_release);
+
+            m_nominal.store(nominal, std::memory_order_relaxed);
+            m_roundTrip.store(bestTrip, std::memory_order_relaxed);
+            m_calibrations.fetch_add(1, std::memory_order_release);
+            return IPX_CAM_ERR_OK;
+        }
+
+        //! Converts the camera timestamp to the host clock in nanoseconds
+        uint64_t ToHost( uint64_t ticks ) const
+        {
+            while (true)
+            {
+                uint32_t seq = m_seq.load(std::memory_order_acquire);
+                if (seq & 1)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                int64_t devRef = m_devRef.load(std::memory_order_relaxed);
+                uint64_t hostRef = m_hostRef.load(std::memory_order_relaxed);
+                double scale = m_scale.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_seq.load(std::memory_order_relaxed) != seq)
+                    continue;
+
+                // the difference is small, so the double keeps the nanosecond precision
+                double delta = static_cast<double>(static_cast<int64_t>(ticks) - devRef) * scale;
+                return static_cast<uint64_t>(static_cast<int64_t>(hostRef) + static_cast<int64_t>(delta));
+            }
+        }
+
+        //! Returns the ratio of the measured camera clock rate to the nominal one minus 1, in ppm
+        double GetDriftPpm() const
+        {
+            return (m_scale.load(std::memory_order_relaxed) / m_nominal.load(std::memory_order_relaxed) - 1.0) * 1000000.0;
+        }
+
+        //! Returns the round trip of the last latch in nanoseconds, the accuracy of the offset is half of it
+        uint64_t GetRoundTrip() const { return m_roundTrip.load(std::memory_order_relaxed); }
+
+        bool IsCalibrated() const { return m_calibrations.load(std::memory_order_acquire) > 0; }
+
+    private:
+        std::atomic<uint32_t> m_seq;
+        std::atomic<int64_t> m_devRef;
+        std::atomic<uint64_t> m_hostRef;
+        std::atomic<double> m_scale;
+        std::atomic<double> m_nominal;      // read by GetStats while the latch thread calibrates
+        std::atomic<uint64_t> m_roundTrip;
+        std::atomic<uint32_t> m_calibrations;
+
+        // accessed by the calibrating thread only
+        int64_t m_firstDev;
+        uint64_t m_firstHost;
+    };
+
+    /**
+    \brief Frames of all the cameras taken at the same time
+    \details The frames are in the order of the devices passed to FrameSync. In the incomplete set the missing frames are empty.
+    */
+    class FrameSet
+    {
+    public:
+
+        FrameSet() : m_id(0), m_complete(false) {}
+
+        //! Returns true if the set has the frames of all the cameras
+        bool IsComplete() const { return m_complete; }
+
+        //! Returns true if the set has no frames (GetFrameSet failed)
+        bool IsEmpty() const { return m_frames.empty(); }
+
+        //! Returns the number of the cameras
+        size_t GetSize() const { return m_frames.size(); }
+
+        //! Returns the frame of the camera, empty if the camera has no frame in the set
+        const IpxCamFrame::Frame& operator[]( size_t index ) const { return m_frames[index]; }
+
+        //! Returns the host timestamp of the camera frame, 0 if no frame
+        uint64_t GetHostTimestamp( size_t index ) const { return m_times[index]; }
+
+        //! Returns the mean of the host timestamps of the frames
+        uint64_t GetTimestamp() const
+        {
+            uint64_t first = 0, sum = 0, n = 0;
+            for (auto t : m_times)
+            {
+                if (!t)
+                    continue;
+                if (!first)
+                    first = t;
+                sum += t - first;
+                ++n;
+            }
+            return n ? first + sum / n : 0;
+        }
+
+        //! Returns the difference between the latest and the earliest frame, ns
+        uint64_t GetSpread() const
+        {
+            uint64_t lo = UINT64_MAX, hi = 0;
+            for (auto t : m_times)
+            {
+                if (!t)
+                    continue;
+                lo = std::min(lo, t);
+                hi = std::max(hi, t);
+            }
+            return hi >= lo ? hi - lo : 0;
+        }
+
+        //! Returns the sequential number of the set
+        uint64_t GetSetID() const { return m_id; }
+
+        //! Releases the frames, the buffers are requeued
+        void Reset()
+        {
+            m_frames.clear();
+            m_times.clear();
+            m_complete = false;
+        }
+
+    private:
+        friend class FrameSync;
+
+        std::vector<IpxCamFrame::Frame> m_frames;
+        std::vector<uint64_t> m_times;
+        uint64_t m_id;
+        bool m_complete;
+    };
+
+    /**
+    \brief Assembles the frame sets of several cameras
+    \details FrameSync grabs the buffers of every stream by its own thread, converts the timestamps and passes the frames to
+    the matcher through single producer single consumer lock-free queues. The matcher runs in the thread calling GetFrameSet,
+    only one thread may call it.
+
+    The frames of the camera must arrive in the order of the timestamps. If the heads of all the queues are within the
+    tolerance, they form the set. Otherwise the earliest head can not have partners any more and it is the straggler.
+    If some queue is empty, the matcher waits for it up to maxLatency after the arrival of the earliest frame.
+    */
+    class FrameSync
+    {
+    public:
+
+        //! Statistics of one camera
+        struct CameraStats
+        {
+            uint64_t received;      //!< frames grabbed from the stream
+            uint64_t matched;       //!< frames returned in the complete sets
+            uint64_t stragglers;    //!< frames without the partners, dropped or returned in the incomplete sets
+            uint64_t overflows;     //!< frames dropped because the queue was full
+            double driftPpm;        //!< measured drift of the camera clock
+            uint64_t latchRoundTrip; //!< round trip of the last latch, ns
+        };
+
+        //! Constructor
+        /*!
+        The streams are taken by GetStreamByIndex(0), the buffers must be announced and the acquisition started by the application.
+        \param[in] devices the devices, the order defines the order of the frames in the set
+        \param[in] params the assembly parameters
+        */
+        FrameSync( const std::vector<IpxCam::Device*> &devices, const SyncParams &params = SyncParams() )
+            : m_params(params), m_running(false), m_matching(false), m_waiters(0), m_pushes(0), m_setId(0)
+        {
+            uint32_t depth = 2;
+            while (depth < m_params.queueDepth)
+                depth <<= 1;
+            m_params.queueDepth = depth;
+
+            for (auto device : devices)
+                m_cameras.emplace_back(new Camera(device, depth));
+        }
+
+        ~FrameSync() { Stop(); }
+
+        FrameSync( const FrameSync& ) = delete;
+        FrameSync& operator=( const FrameSync& ) = delete;
+
+        //! Calibrates the clocks and starts the grabbing threads
+        /*!
+        \return Returns IPX_CAM_ERR_OK, IPX_CAM_ERR_INVALID_STATE if already started or the error of the calibration
+        */
+        IpxCamErr Start()
+        {
+            if (m_running)
+                return IPX_CAM_ERR_INVALID_STATE;
+            if (m_cameras.empty())
+                return IPX_CAM_ERR_INVALID_ARGUMENT;
+
+            for (auto &camera : m_cameras)
+            {
+                if (!camera->stream)
+                    return IPX_CAM_ERR_NO_DEVICE;
+                IpxCamErr err = camera->clock.Calibrate(camera->device->GetCameraParameters());
+                if (err != IPX_CAM_ERR_OK)
+                    return err;
+            }
+
+            m_running = true;
+            for (auto &camera : m_cameras)
+                camera->thread = std::thread(&FrameSync::Grab, this, camera.get());
+            if (m_params.latchInterval)
+                m_latchThread = std::thread(&FrameSync::Latch, this);
+            return IPX_CAM_ERR_OK;
+        }
+
+        //! Stops the grabbing threads and releases the queued frames
+        /*!
+        Call Stop before the acquisition is stopped and the buffers are flushed. GetFrameSet waiting in another thread
+        returns IPX_CAM_ERR_INVALID_STATE. The frame sets held by the application must be released before the buffers are revoked.
+        */
+        void Stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_running)
+                    return;
+                m_running = false;
+            }
+            m_cv.notify_all();
+            m_latchCv.notify_all();
+
+            // the queues have the single consumer, wait until the matcher leaves them
+            while (m_matching)
+                std::this_thread::yield();
+
+            for (auto &camera : m_cameras)
+            {
+                if (camera->thread.joinable())
+                    camera->thread.join();
+                IpxCamFrame::Frame frame;
+                uint64_t t;
+                while (camera->Pop(&frame, &t))
+                    frame.Reset();
+            }
+            if (m_latchThread.joinable())
+                m_latchThread.join();
+        }
+
+        //! Returns the next frame set
+        /*!
+        \param[in] iTimeout timeout in milliseconds
+        \param[out] err returns IPX_CAM_ERR_OK, IPX_CAM_ERR_TIMEOUT or IPX_CAM_ERR_INVALID_STATE if not started
+        \return Returns the set, empty on the error. With StragglerFlag the set can be incomplete.
+        */
+        FrameSet GetFrameSet( uint64_t iTimeout, IpxCamErr *err = nullptr )
+        {
+            FrameSet set;
+            auto deadline = iTimeout == UINT64_MAX ? std::chrono::steady_clock::time_point::max()
+                : std::chrono::steady_clock::now() + std::chrono::milliseconds(iTimeout);
+
+            const size_t count = m_cameras.size();
+            IpxCamErr result = IPX_CAM_ERR_INVALID_STATE;
+            m_matching = true;
+            while (m_running)
+            {
+                // the counter is read before the queues, so a frame pushed after the scan always wakes the matcher
+                uint64_t pushes = m_pushes.load(std::memory_order_seq_cst);
+
+                // heads of the queues
+                uint64_t lo = UINT64_MAX, hi = 0, loArrival = 0;
+                size_t empty = 0, loIndex = 0;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const Entry *head = m_cameras[i]->Peek();
+                    if (!head)
+                    {
+                        ++empty;
+                        continue;
+                    }
+                    if (head->time < lo)
+                    {
+                        lo = head->time;
+                        loIndex = i;
+                        loArrival = head->arrival;
+                    }
+                    hi = std::max(hi, head->time);
+                }
+
+                if (!empty && hi - lo <= m_params.tolerance)
+                {
+                    Assemble(&set, lo, true);
+                    result = IPX_CAM_ERR_OK;
+                    break;
+                }
+
+                // the earliest head is the straggler if the later frames of all the other cameras are already here
+                // or its partners did not arrive within maxLatency. Dropping does not need to wait for the empty queues
+                // if the earliest head does not match the other heads anyway.
+                bool straggler = empty < count && (!empty || GetHostTime() - loArrival > m_params.maxLatency
+                    || (m_params.policy == StragglerDrop && hi - lo > m_params.tolerance));
+                if (straggler)
+                {
+                    if (m_params.policy == StragglerFlag)
+                    {
+                        Assemble(&set, lo, false);
+                        result = IPX_CAM_ERR_OK;
+                        break;
+                    }
+                    IpxCamFrame::Frame frame;
+                    uint64_t t;
+                    m_cameras[loIndex]->Pop(&frame, &t);
+                    ++m_cameras[loIndex]->stragglers;
+                    continue;
+                }
+
+                if (std::chrono::steady_clock::now() >= deadline)
+                {
+                    result = IPX_CAM_ERR_TIMEOUT;
+                    break;
+                }
+                Wait(deadline, empty < count ? loArrival + m_params.maxLatency : 0, pushes);
+            }
+            m_matching = false;
+
+            if (err)
+                *err = result;
+            return set;
+        }
+
+        //! Returns the statistics of the camera
+        CameraStats GetStats( size_t index ) const
+        {
+            CameraStats stats;
+            const Camera &camera = *m_cameras[index];
+            stats.received = camera.received;
+            stats.matched = camera.matched;
+            stats.stragglers = camera.stragglers;
+            stats.overflows = camera.overflows;
+            stats.driftPpm = camera.clock.GetDriftPpm();
+            stats.latchRoundTrip = camera.clock.GetRoundTrip();
+            return stats;
+        }
+
+        //! Returns the number of the cameras
+        size_t GetNumCameras() const { return m_cameras.size(); }
+
+        //! Returns the clock conversion of the camera
+        const ClockMapper& GetClock( size_t index ) const { return m_cameras[index]->clock; }
+
+        const SyncParams& GetParams() const { return m_params; }
+
+    private:
+
+        struct Entry
+        {
+            IpxCamFrame::Frame frame;
+            uint64_t time;      // host timestamp of the frame
+            uint64_t arrival;   // host time the frame was grabbed
+        };
+
+        // per camera state, the queue is written by the grabbing thread and read by the matcher
+        struct Camera
+        {
+            Camera( IpxCam::Device *d, uint32_t depth )
+                : device(d), stream(d && d->GetNumStreams() ? d->GetStreamByIndex(0) : nullptr), frames(stream)
+                , ring(depth), mask(depth - 1), head(0), tail(0)
+                , received(0), matched(0), stragglers(0), overflows(0) {}
+
+            bool Push( IpxCamFrame::Frame &&frame, uint64_t time, uint64_t arrival )
+            {
+                size_t t = tail.load(std::memory_order_relaxed);
+                if (t - head.load(std::memory_order_acquire) > mask)
+                    return false;
+                Entry &entry = ring[t & mask];
+                entry.frame = std::move(frame);
+                entry.time = time;
+                entry.arrival = arrival;
+                tail.store(t + 1, std::memory_order_release);
+                return true;
+            }
+
+            const Entry* Peek() const
+            {
+                size_t h = head.load(std::memory_order_relaxed);
+                return h != tail.load(std::memory_order_acquire) ? &ring[h & mask] : nullptr;
+            }
+
+            bool Pop( IpxCamFrame::Frame *frame, uint64_t *time )
+            {
+                size_t h = head.load(std::memory_order_relaxed);
+                if (h == tail.load(std::memory_order_acquire))
+                    return false;
+                Entry &entry = ring[h & mask];
+                *frame = std::move(entry.frame);
+                *time = entry.time;
+                head.store(h + 1, std::memory_order_release);
+                return true;
+            }
+
+            IpxCam::Device *device;
+            IpxCam::Stream *stream;
+            IpxCamFrame::FrameQueue frames;
+            ClockMapper clock;
+            std::thread thread;
+
+            std::vector<Entry> ring;
+            size_t mask;
+            // the indices are written by different threads, keep them on separate cache lines
+            char pad0[64];
+            std::atomic<size_t> head;
+            char pad1[64];
+            std::atomic<size_t> tail;
+            char pad2[64];
+
+            std::atomic<uint64_t> received;
+            std::atomic<uint64_t> matched;
+            std::atomic<uint64_t> stragglers;
+            std::atomic<uint64_t> overflows;
+        };
+
+        // moves the heads within the tolerance of the earliest one to the set
+        void Assemble( FrameSet *set, uint64_t lo, bool complete )
+        {
+            const size_t count = m_cameras.size();
+            set->m_frames.resize(count);
+            set->m_times.assign(count, 0);
+            for (size_t i = 0; i < count; ++i)
+            {
+                Camera &camera = *m_cameras[i];
+                const Entry *head = camera.Peek();
+                if (!head || head->time - lo > m_params.tolerance)
+                    continue;
+                camera.Pop(&set->m_frames[i], &set->m_times[i]);
+                ++(complete ? camera.matched : camera.stragglers);
+            }
+            set->m_complete = complete;
+            set->m_id = ++m_setId;
+        }
+
+        // waits for a new frame, the deadline or the expiration of maxLatency of the earliest frame
+        void Wait( std::chrono::steady_clock::time_point deadline, uint64_t expiry, uint64_t pushes )
+        {
+            auto until = deadline;
+            if (expiry)
+            {
+                auto now = GetHostTime();
+                auto left = std::chrono::nanoseconds(expiry > now ? expiry - now : 0);
+                until = std::min(until, std::chrono::steady_clock::now() + left);
+            }
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            // the grabbing thread counts the push before it checks m_waiters, one of both sees the other
+            m_waiters.fetch_add(1, std::memory_order_seq_cst);
+            if (m_running && m_pushes.load(std::memory_order_seq_cst) == pushes)
+                m_cv.wait_until(lock, until);
+            m_waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        void Grab( Camera *camera )
+        {
+            while (m_running)
+            {
+                IpxCamErr err = IPX_CAM_ERR_OK;
+                auto buffer = camera->stream->GetBuffer(m_params.grabTimeout, &err);
+                if (!buffer)
+                {
+                    // the stream is stopped, do not spin until Stop
+                    if (err != IPX_CAM_ERR_TIMEOUT)
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    continue;
+                }
+
+                ++camera->received;
+                uint64_t time = camera->clock.ToHost(buffer->GetTimestamp());
+                IpxCamFrame::Frame frame = camera->frames.Wrap(buffer);
+                if (!camera->Push(std::move(frame), time, GetHostTime()))
+                {
+                    // the frame is released here and the buffer returns to the stream
+                    ++camera->overflows;
+                    continue;
+                }
+
+                m_pushes.fetch_add(1, std::memory_order_seq_cst);
+                if (m_waiters.load(std::memory_order_seq_cst))
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_cv.notify_one();
+                }
+            }
+        }
+
+        void Latch()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (m_running)
+            {
+                m_latchCv.wait_for(lock, std::chrono::milliseconds(m_params.latchInterval));
+                if (!m_running)
+                    break;
+                lock.unlock();
+                for (auto &camera : m_cameras)
+                    camera->clock.Calibrate(camera->device->GetCameraParameters());
+                lock.lock();
+            }
+        }
+
+        SyncParams m_params;
+        std::vector<std::unique_ptr<Camera>> m_cameras;
+        std::thread m_latchThread;
+
+        std::atomic<bool> m_running;
+        std::atomic<bool> m_matching;
+        std::atomic<uint32_t> m_waiters;
+        std::atomic<uint64_t> m_pushes;
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::condition_variable m_latchCv;
+        uint64_t m_setId;
+    };
+
+} // end of namespace IpxCamSync
+
+#endif // __cplusplus
+
+#endif // IPX_FRAME_SYNC_H
@@ -0,0 +1,785 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Camera SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxGenParamImpl.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// In-process implementation of the IpxGenParam interfaces
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IPX_GEN_PARAM_IMPL_H
+#define IPX_GEN_PARAM_IMPL_H
+
+#include "IpxCameraApi.h"
+
+#ifdef __cplusplus
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+/*! \namespace IpxGenParamImpl
+    \brief A namespace with the in-process implementation of the IpxGenParam interfaces.
+
+    \details The parameters declared here are not backed by a GenICam node map. They are used by
+    the software components of the SDK (virtual camera, stream helpers) to expose their settings through
+    the same IpxGenParam::Array interface, the applications use to control the real cameras.
+    The values of Int, Float, Enum and Boolean parameters are stored in atomics, so a producer thread
+    can read them every frame without locking.
+*/
+namespace IpxGenParamImpl
+{
+    /**
+    \brief The template class implements the common part of the IpxGenParam::Param interface.
+    \details T is one of the parameter interfaces: IpxGenParam::Int, IpxGenParam::Float, etc.
+    */
+    template<class T>
+    class ParamImpl : public T
+    {
+    public:
+
+        //! Function type returning true if parameter can be written at the moment.
+        typedef std::function<bool()> AccessFn;
+
+        ParamImpl( const char *name, const char *description = nullptr )
+            : m_name(name)
+            , m_displayName(name)
+            , m_description(description ? description : "")
+            , m_visibility(IpxGenParam::VisBeginner)
+            , m_writable(true)
+        {}
+
+        virtual const char* GetName() { return m_name.c_str(); }
+        virtual const char* GetToolTip() { return m_description.c_str(); }
+        virtual const char* GetDescription() { return m_description.c_str(); }
+        virtual const char* GetDisplayName() { return m_displayName.c_str(); }
+        virtual IpxGenParam::Visibility GetVisibility() { return m_visibility; }
+        virtual bool IsValueCached() { return false; }
+        virtual bool IsAvailable() { return true; }
+        virtual bool IsWritable() { return m_writable && (!m_access || m_access()); }
+        virtual bool IsReadable() { return true; }
+        virtual bool IsStreamable() { return m_writable; }
+        virtual bool IsVisible( IpxGenParam::Visibility vis ) { return m_visibility <= vis; }
+
+        virtual IpxCamErr RegisterEventSink( IpxGenParam::ParamEventSink *aEventSink )
+        {
+            if (!aEventSink)
+                return IPX_CAM_ERR_INVALID_ARGUMENT;
+
+            std::lock_guard<std::mutex> lock(m_sinksMutex);
+            if (std::find(m_sinks.begin(), m_sinks.end(), aEventSink) == m_sinks.end())
+                m_sinks.push_back(aEventSink);
+            return IPX_CAM_ERR_OK;
+        }
+
+        virtual IpxCamErr UnregisterEventSink( IpxGenParam::ParamEventSink *aEventSink )
+        {
+            std::lock_guard<std::mutex> lock(m_sinksMutex);
+            auto it = std::find(m_sinks.begin(), m_sinks.end(), aEventSink);
+            if (it == m_sinks.end())
+                return IPX_CAM_ERR_INVALID_ARGUMENT;
+            m_sinks.erase(it);
+            return IPX_CAM_ERR_OK;
+        }
+
+        virtual IPX_GENAPI_NS::INode* GetNode() { return nullptr; }
+
+        virtual IpxGenParam::Category* ToCategory() { return dynamic_cast<IpxGenParam::Category*>(Self()); }
+        virtual IpxGenParam::Boolean* ToBoolean() { return dynamic_cast<IpxGenParam::Boolean*>(Self()); }
+        virtual IpxGenParam::Command* ToCommand() { return dynamic_cast<IpxGenParam::Command*>(Self()); }
+        virtual IpxGenParam::EnumEntry* ToEnumEntry() { return dynamic_cast<IpxGenParam::EnumEntry*>(Self()); }
+        virtual IpxGenParam::Enum* ToEnum() { return dynamic_cast<IpxGenParam::Enum*>(Self()); }
+        virtual IpxGenParam::Float* ToFloat() { return dynamic_cast<IpxGenParam::Float*>(Self()); }
+        virtual IpxGenParam::Int* ToInt() { return dynamic_cast<IpxGenParam::Int*>(Self()); }
+        virtual IpxGenParam::String* ToString() { return dynamic_cast<IpxGenParam::String*>(Self()); }
+
+        //! Sets the parameter display name
+        void SetDisplayName( const char *name ) { m_displayName = name; }
+
+        //! Sets the visibility level of the parameter
+        void SetVisibility( IpxGenParam::Visibility vis ) { m_visibility = vis; }
+
+        //! Makes the parameter read-only (false) or read-write (true)
+        void SetWritable( bool writable ) { m_writable = writable; }
+
+        //! Sets the function, which is called to check if parameter can be written (for example, locked by TLParamsLocked)
+        void SetAccess( AccessFn access ) { m_access = access; }
+
+    protected:
+
+        IpxGenParam::Param* Self() { return this; }
+
+        //! Calls OnParameterUpdate of all the registered event sinks
+        void NotifySinks()
+        {
+            std::vector<IpxGenParam::ParamEventSink*> sinks;
+            {
+                std::lock_guard<std::mutex> lock(m_sinksMutex);
+                sinks = m_sinks;
+            }
+            for (auto sink : sinks)
+                sink->OnParameterUpdate(this);
+        }
+
+        //! Returns IPX_CAM_ERR_OK if the parameter can be written
+        IpxCamErr CheckWritable()
+        {
+            return IsWritable() ? IPX_CAM_ERR_OK : IPX_CAM_GENICAM_ACCESS_ERROR;
+        }
+
+    private:
+        std::string m_name;
+        std::string m_displayName;
+        std::string m_description;
+        IpxGenParam::Visibility m_visibility;
+        bool m_writable;
+        AccessFn m_access;
+
+        std::mutex m_sinksMutex;
+        std::vector<IpxGenParam::ParamEventSink*> m_sinks;
+    };
+
+    // set error code if pointer is valid
+    inline void SetErr( IpxCamErr *err, IpxCamErr code )
+    {
+        if (err)
+            *err = code;
+    }
+
+    /**
+    \brief Integer parameter
+    */
+    class Int : public ParamImpl<IpxGenParam::Int>
+    {
+    public:
+
+        //! Function type called before the new value is stored. Returns the error code to reject the value.
+        typedef std::function<IpxCamErr(int64_t)> SetFn;
+
+        //! Function type to compute the value of read-only parameters
+        typedef std::function<int64_t()> GetFn;
+
+        Int( const char *name, int64_t value, int64_t min = INT64_MIN, int64_t max = INT64_MAX, int64_t inc = 1, const char *description = nullptr )
+            : ParamImpl<IpxGenParam::Int>(name, description)
+            , m_value(value)
+            , m_min(min)
+            , m_max(max)
+            , m_inc(inc > 0 ? inc : 1)
+        {}
+
+        virtual IpxCamErr SetValue( int64_t val )
+        {
+            auto err = CheckWritable();
+            if (err != IPX_CAM_ERR_OK)
+                return err;
+
+            if (val < m_min || val > m_max || (m_inc > 1 && ((val - m_min) % m_inc) != 0))
+                return IPX_CAM_GENICAM_OUT_OF_RANGE;
+
+            if (m_onSet && (err = m_onSet(val)) != IPX_CAM_ERR_OK)
+                return err;
+
+            m_value = val;
+            NotifySinks();
+            return IPX_CAM_ERR_OK;
+        }
+
+        virtual int64_t GetValue( IpxCamErr *err = nullptr )
+        {
+            SetErr(err, IPX_CAM_ERR_OK);
+            return m_getter ? m_getter() : m_value.load(std::memory_order_relaxed);
+        }
+
+        virtual int64_t GetMin( IpxCamErr *err = nullptr ) { SetErr(err, IPX_CAM_ERR_OK); return m_min; }
+        virtual int64_t GetMax( IpxCamErr *err = nullptr ) { SetErr(err, IPX_CAM_ERR_OK); return m_max; }
+        virtual int64_t GetIncrement( IpxCamErr *err = nullptr ) { SetErr(err, IPX_CAM_ERR_OK); return m_inc; }
+
+        //! Returns the value without any check, used by the owner of the parameter
+        int64_t Value() const { return m_getter ? m_getter() : m_value.load(std::memory_order_relaxed); }
+
+        //! Stores the value without access and range checks, used by the owner of the parameter
+        void Store( int64_t val ) { m_value = val; }
+
+        //! Changes the range of the parameter
+        void SetRange( int64_t min, int64_t max ) { m_min = min; m_max = max; }
+
+        void OnSet( SetFn fn ) { m_onSet = fn; }
+        void SetGetter( GetFn fn ) { m_getter = fn; }
+
+    private:
+        std::atomic<int64_t> m_value;
+        int64_t m_min, m_max, m_inc;
+        SetFn m_onSet;
+        GetFn m_getter;
+    };
+
+    /**
+    \brief Float parameter
+    */
+    class Float : public ParamImpl<IpxGenParam::Float>
+    {
+    public:
+
+        typedef std::function<IpxCamErr(double)> SetFn;
+        typedef std::function<double()> GetFn;
+
+        Float( const char *name, double value, double min, double max, const char *unit = "", const char *description = nullptr )
+            : ParamImpl<IpxGenParam::Float>(name, description)
+            , m_value(value)
+            , m_min(min)
+            , m_max(max)
+            , m_unit(unit ? unit : "")
+        {}
+
+        virtual IpxCamErr SetValue( double val )
+        {
+            auto err = CheckWritable();
+            if (err != IPX_CAM_ERR_OK)
+                return err;
+
+            if (!(val >= m_min && val <= m_max))
+                return IPX_CAM_GENICAM_OUT_OF_RANGE;
+
+            if (m_onSet && (err = m_onSet(val)) != IPX_CAM_ERR_OK)
+                return err;
+
+            m_value = val;
+            NotifySinks();
+            return IPX_CAM_ERR_OK;
+        }
+
+        virtual double GetValue( IpxCamErr *err = nullptr )
+        {
+            SetErr(err, IPX_CAM_ERR_OK);
+            return Value();
+        }
+
+        virtual double GetMin( IpxCamErr *err = nullptr ) { SetErr(err, IPX_CAM_ERR_OK); return m_min; }
+        virtual double GetMax( IpxCamErr *err = nullptr ) { SetErr(err, IPX_CAM_ERR_OK); return m_max; }
+        virtual const char* GetUnit( IpxCamErr *err = nullptr ) { SetErr(err, IPX_CAM_ERR_OK); return m_unit.c_str(); }
+
+        double Value() const { return m_getter ? m_getter() : m_value.load(std::memory_order_relaxed); }
+        void Store( double val ) { m_value = val; }
+
+        void OnSet( SetFn fn ) { m_onSet = fn; }
+        void SetGetter( GetFn fn ) { m_getter = fn; }
+
+    private:
+        std::atomic<double> m_value;
+        double m_min, m_max;
+        std::string m_unit;
+        SetFn m_onSet;
+        GetFn m_getter;
+    };
+
+    /**
+    \brief Boolean parameter
+    */
+    class Boolean : public ParamImpl<IpxGenParam::Boolean>
+    {
+    public:
+
+        typedef std::function<IpxCamErr(bool)> SetFn;
+
+        Boolean( const char *name, bool value, const char *description = nullptr )
+            : ParamImpl<IpxGenParam::Boolean>(name, description)
+            , m_value(value)
+        {}
+
+        virtual IpxCamErr SetValue( bool val )
+        {
+            auto err = CheckWritable();
+            if (err != IPX_CAM_ERR_OK)
+                return err;
+
+            if (m_onSet && (err = m_onSet(val)) != IPX_CAM_ERR_OK)
+                return err;
+
+            m_value = val;
+            NotifySinks();
+            return IPX_CAM_ERR_OK;
+        }
+
+        virtual bool GetValue( IpxCamErr *err = nullptr )
+        {
+            SetErr(err, IPX_CAM_ERR_OK);
+            return m_value;
+        }
+
+        bool Value() const { return m_value.load(std::memory_order_relaxed); }
+        void Store( bool val ) { m_value = val; }
+
+        void OnSet( SetFn fn ) { m_onSet = fn; }
+
+    private:
+        std::atomic<bool> m_value;
+        SetFn m_onSet;
+    };
+
+    /**
+    \brief Command parameter. The action is executed synchronously, so IsDone always returns true.
+    */
+    class Command : public ParamImpl<IpxGenParam::Command>
+    {
+    public:
+
+        typedef std::function<IpxCamErr()> ExecFn;
+
+        Command( const char *name, ExecFn fn, const char *description = nullptr )
+            : ParamImpl<IpxGenParam::Command>(name, description)
+            , m_exec(fn)
+        {}
+
+        virtual IpxCamErr Execute()
+        {
+            auto err = CheckWritable();
+            if (err != IPX_CAM_ERR_OK)
+                return err;
+
+            err = m_exec ? m_exec() : IPX_CAM_ERR_OK;
+            if (err == IPX_CAM_ERR_OK)
+                NotifySinks();
+            return err;
+        }
+
+        virtual bool IsDone( IpxCamErr *err = nullptr )
+        {
+            SetErr(err, IPX_CAM_ERR_OK);
+            return true;
+        }
+
+    private:
+        ExecFn m_exec;
+    };
+
+    /**
+    \brief String parameter
+    */
+    class String : public ParamImpl<IpxGenParam::String>
+    {
+    public:
+
+        typedef std::function<IpxCamErr(const char*)> SetFn;
+
+        String( const char *name, const char *value, size_t maxLength = 64, const char *description = nullptr )
+            : ParamImpl<IpxGenParam::String>(name, description)
+            , m_value(value ? value : "")
+            , m_maxLength(maxLength)
+        {}
+
+        virtual size_t GetMaxLength( IpxCamErr *err = nullptr )
+        {
+            SetErr(err, IPX_CAM_ERR_OK);
+            return m_maxLength;
+        }
+
+        //! \note The returned pointer is the copy of the calling thread, valid until its next GetValue call
+        virtual const char* GetValue( size_t *len = nullptr, IpxCamErr *err = nullptr )
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            SetErr(err, IPX_CAM_ERR_OK);
+            if (len)
+                *len = m_value.size();
+            std::string &copy = m_copies[std::this_thread::get_id()];
+            copy = m_value;
+            return copy.c_str();
+        }
+
+        virtual IpxCamErr SetValue( const char *val )
+        {
+            auto err = CheckWritable();
+            if (err != IPX_CAM_ERR_OK)
+                return err;
+
+            if (!val)
+                return IPX_CAM_GENICAM_INVALID_ARGUMENT;
+
+            if (strlen(val) > m_maxLength)
+                return IPX_CAM_GENICAM_OUT_OF_RANGE;
+
+            if (m_onSet && (err = m_onSet(val)) != IPX_CAM_ERR_OK)
+                return err;
+
+            Store(val);
+            NotifySinks();
+            return IPX_CAM_ERR_OK;
+        }
+
+        //! Returns the copy of the value, used by the owner of the parameter
+        std::string Value()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_value;
+        }
+
+        //! Stores the value without access and length checks, used by the owner of the parameter
+        void Store( const std::string &val )
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_value = val;
+        }
+
+        void OnSet( SetFn fn ) { m_onSet = fn; }
+
+    private:
+        std::mutex m_mutex;
+        std::string m_value;
+        std::map<std::thread::id, std::string> m_copies;    // the values returned by GetValue, one per thread
+        size_t m_maxLength;
+        SetFn m_onSet;
+    };
+
+    /**
+    \brief Enumeration entry parameter
+    */
+    class EnumEntry : public ParamImpl<IpxGenParam::EnumEntry>
+    {
+    public:
+
+        EnumEntry( const char *name, int64_t value, const char *description = nullptr )
+            : ParamImpl<IpxGenParam::EnumEntry>(name, description)
+            , m_value(value)
+        {
+            SetWritable(false);
+        }
+
+        virtual int64_t GetValue( IpxCamErr *err = nullptr ) { SetErr(err, IPX_CAM_ERR_OK); return m_value; }
+        virtual const char* GetValueStr( IpxCamErr *err = nullptr ) { SetErr(err, IPX_CAM_ERR_OK); return GetName(); }
+
+    private:
+        int64_t m_value;
+    };
+
+    /**
+    \brief Enumeration parameter. Entries are added by AddEntry before the parameter is published.
+    */
+    class Enum : public ParamImpl<IpxGenParam::Enum>
+    {
+    public:
+
+        typedef std::function<IpxCamErr(int64_t)> SetFn;
+
+        Enum( const char *name, const char *description = nullptr )
+            : ParamImpl<IpxGenParam::Enum>(name, description)
+            , m_value(0)
+        {}
+
+        //! Adds the entry to the enumeration, first added entry becomes the current value
+        EnumEntry* AddEntry( const char *name, int64_t value )
+        {
+            if (m_entries.empty())
+                m_value = value;
+            m_entries.emplace_back(new EnumEntry(name, value));
+            return m_entries.back().get();
+        }
+
+        virtual size_t GetEnumEntriesCount( IpxCamErr *err = nullptr )
+        {
+            SetErr(err, IPX_CAM_ERR_OK);
+            return m_entries.size();
+        }
+
+        virtual IpxGenParam::EnumEntry* GetEnumEntryByIndex( size_t aIndex )
+        {
+            return aIndex < m_entries.size() ? m_entries[aIndex].get() : nullptr;
+        }
+
+        virtual IpxGenParam::EnumEntry* GetEnumEntryByName( const char *name )
+        {
+            if (name)
+                for (auto &entry : m_entries)
+                    if (!strcmp(entry->GetName(), name))
+                        return entry.get();
+            return nullptr;
+        }
+
+        virtual IpxGenParam::EnumEntry* GetEnumEntryByValue( int64_t val )
+        {
+            for (auto &entry : m_entries)
+                if (entry->GetValue() == val)
+                    return entry.get();
+            return nullptr;
+        }
+
+        virtual int64_t GetValue( IpxCamErr *err = nullptr )
+        {
+            SetErr(err, IPX_CAM_ERR_OK);
+            return m_value;
+        }
+
+        virtual const char* GetValueStr( IpxCamErr *err = nullptr )
+        {
+            auto entry = GetEnumEntryByValue(m_value);
+            SetErr(err, entry ? IPX_CAM_ERR_OK : IPX_CAM_GENICAM_OUT_OF_RANGE);
+            return entry ? entry->GetName() : "";
+        }
+
+        virtual IpxCamErr SetValue( int64_t val )
+        {
+            auto err = CheckWritable();
+            if (err != IPX_CAM_ERR_OK)
+                return err;
+
+            if (!GetEnumEntryByValue(val))
+                return IPX_CAM_GENICAM_OUT_OF_RANGE;
+
+            if (m_onSet && (err = m_onSet(val)) != IPX_CAM_ERR_OK)
+                return err;
+
+            m_value = val;
+            NotifySinks();
+            return IPX_CAM_ERR_OK;
+        }
+
+        virtual IpxCamErr SetValueStr( const char *val )
+        {
+            auto entry = GetEnumEntryByName(val);
+            if (!entry)
+                return IPX_CAM_GENICAM_INVALID_ARGUMENT;
+            return SetValue(entry->GetValue());
+        }
+
+        int64_t Value() const { return m_value.load(std::memory_order_relaxed); }
+        void Store( int64_t val ) { m_value = val; }
+
+        void OnSet( SetFn fn ) { m_onSet = fn; }
+
+    private:
+        std::atomic<int64_t> m_value;
+        std::vector<std::unique_ptr<EnumEntry>> m_entries;
+        SetFn m_onSet;
+    };
+
+    /**
+    \brief Category parameter. Does not own the parameters it refers to.
+    */
+    class Category : public ParamImpl<IpxGenParam::Category>
+    {
+    public:
+
+        Category( const char *name, const char *description = nullptr )
+            : ParamImpl<IpxGenParam::Category>(name, description)
+        {
+            SetWritable(false);
+        }
+
+        virtual uint32_t GetCount() { return static_cast<uint32_t>(m_params.size()); }
+
+        virtual IpxGenParam::Param* GetParamByIndex( uint32_t idx, IpxCamErr *err )
+        {
+            if (idx >= m_params.size())
+            {
+                SetErr(err, IPX_CAM_ERR_INVALID_INDEX);
+                return nullptr;
+            }
+            SetErr(err, IPX_CAM_ERR_OK);
+            return m_params[idx];
+        }
+
+        void Add( IpxGenParam::Param *param ) { m_params.push_back(param); }
+
+    private:
+        std::vector<IpxGenParam::Param*> m_params;
+    };
+
+    /**
+    \brief Array of parameters. Owns the parameters added to it.
+    \details Parameters must be added before the array is handed out to the application,
+    the array itself is not modified afterwards, so lookups are not synchronized.
+    */
+    class Array : public IpxGenParam::Array
+    {
+    public:
+
+        Array()
+            : m_root(new Category("Root"))
+        {}
+
+        //! Adds the parameter to the array and to the category (or to the root category) and returns the parameter
+        template<class P>
+        P* Add( P *param, Category *category = nullptr )
+        {
+            m_params.emplace_back(param);
+            m_byName[param->GetName()] = param;
+            (category ? category : m_root.get())->Add(param);
+            return param;
+        }
+
+        //! Adds the category under the root category
+        Category* AddCategory( const char *name, const char *description = nullptr )
+        {
+            return Add(new Category(name, description));
+        }
+
+        virtual IpxGenParam::Param* GetParam( const char *name, IpxCamErr *err )
+        {
+            auto it = name ? m_byName.find(name) : m_byName.end();
+            if (it == m_byName.end())
+            {
+                SetErr(err, IPX_CAM_GENICAM_UNKNOWN_PARAM);
+                return nullptr;
+            }
+            SetErr(err, IPX_CAM_ERR_OK);
+            return it->second;
+        }
+
+        virtual IpxGenParam::Boolean* GetBoolean( const char *name, IpxCamErr *err ) { return Get<IpxGenParam::Boolean>(name, err); }
+        virtual IpxGenParam::Command* GetCommand( const char *name, IpxCamErr *err ) { return Get<IpxGenParam::Command>(name, err); }
+        virtual IpxGenParam::Enum* GetEnum( const char *name, IpxCamErr *err ) { return Get<IpxGenParam::Enum>(name, err); }
+        virtual IpxGenParam::Float* GetFloat( const char *name, IpxCamErr *err ) { return Get<IpxGenParam::Float>(name, err); }
+        virtual IpxGenParam::Int* GetInt( const char *name, IpxCamErr *err ) { return Get<IpxGenParam::Int>(name, err); }
+        virtual IpxGenParam::String* GetString( const char *name, IpxCamErr *err ) { return Get<IpxGenParam::String>(name, err); }
+
+        virtual IpxGenParam::Category* GetRootCategory( IpxCamErr *err )
+        {
+            SetErr(err, IPX_CAM_ERR_OK);
+            return m_root.get();
+        }
+
+        virtual IPX_GENAPI_NS::INodeMap* GetNodeMap( IpxCamErr *err )
+        {
+            // there is no GenApi node map behind these parameters
+            SetErr(err, IPX_CAM_ERR_INVALID_STATE);
+            return nullptr;
+        }
+
+        virtual uint32_t GetCount() { return static_cast<uint32_t>(m_params.size()); }
+
+        virtual IpxGenParam::Param* GetParamByIndex( uint32_t idx, IpxCamErr *err )
+        {
+            if (idx >= m_params.size())
+            {
+                SetErr(err, IPX_CAM_ERR_INVALID_INDEX);
+                return nullptr;
+            }
+            SetErr(err, IPX_CAM_ERR_OK);
+            return m_params[idx].get();
+        }
+
+        virtual IpxCamErr SetBooleanValue( const char *name, bool aValue )
+        {
+            IpxCamErr err;
+            auto param = GetBoolean(name, &err);
+            return param ? param->SetValue(aValue) : err;
+        }
+
+        virtual bool GetBooleanValue( const char *name, IpxCamErr *err = nullptr )
+        {
+            auto param = GetBoolean(name, err);
+            return param ? param->GetValue(err) : false;
+        }
+
+        virtual IpxCamErr SetEnumValueStr( const char *name, const char *val )
+        {
+            IpxCamErr err;
+            auto param = GetEnum(name, &err);
+            return param ? param->SetValueStr(val) : err;
+        }
+
+        virtual IpxCamErr SetEnumValue( const char *name, int64_t val )
+        {
+            IpxCamErr err;
+            auto param = GetEnum(name, &err);
+            return param ? param->SetValue(val) : err;
+        }
+
+        virtual const char* GetEnumValueStr( const char *name, IpxCamErr *err = nullptr )
+        {
+            auto param = GetEnum(name, err);
+            return param ? param->GetValueStr(err) : nullptr;
+        }
+
+        virtual int64_t GetEnumValue( const char *name, IpxCamErr *err = nullptr )
+        {
+            auto param = GetEnum(name, err);
+            return param ? param->GetValue(err) : 0;
+        }
+
+        virtual IpxCamErr SetFloatValue( const char *name, double val )
+        {
+            IpxCamErr err;
+            auto param = GetFloat(name, &err);
+            return param ? param->SetValue(val) : err;
+        }
+
+        virtual double GetFloatValue( const char *name, IpxCamErr *err = nullptr )
+        {
+            auto param = GetFloat(name, err);
+            return param ? param->GetValue(err) : 0.0;
+        }
+
+        virtual IpxCamErr SetIntegerValue( const char *name, int64_t val )
+        {
+            IpxCamErr err;
+            auto param = GetInt(name, &err);
+            return param ? param->SetValue(val) : err;
+        }
+
+        virtual int64_t GetIntegerValue( const char *name, IpxCamErr *err = nullptr )
+        {
+            auto param = GetInt(name, err);
+            return param ? param->GetValue(err) : 0;
+        }
+
+        virtual IpxCamErr SetStringValue( const char *name, const char *val )
+        {
+            IpxCamErr err;
+            auto param = GetString(name, &err);
+            return param ? param->SetValue(val) : err;
+        }
+
+        virtual const char* GetStringValue( const char *name, IpxCamErr *err = nullptr )
+        {
+            auto param = GetString(name, err);
+            return param ? param->GetValue(nullptr, err) : nullptr;
+        }
+
+        virtual IpxCamErr ExecuteCommand( const char *name )
+        {
+            IpxCamErr err;
+            auto param = GetCommand(name, &err);
+            return param ? param->Execute() : err;
+        }
+
+        virtual bool IsCommandDone( const char *name, IpxCamErr *err = nullptr )
+        {
+            auto param = GetCommand(name, err);
+            return param ? param->IsDone(err) : false;
+        }
+
+        virtual IpxCamErr Poll( int64_t /*elapsedTime*/ ) { return IPX_CAM_ERR_OK; }
+
+    private:
+
+        template<class P>
+        P* Get( const char *name, IpxCamErr *err )
+        {
+            auto param = GetParam(name, err);
+            if (!param)
+                return nullptr;
+
+            auto typed = dynamic_cast<P*>(param);
+            SetErr(err, typed ? IPX_CAM_ERR_OK : IPX_CAM_GENICAM_TYPE_ERROR);
+            return typed;
+        }
+
+        std::unique_ptr<Category> m_root;
+        std::vector<std::unique_ptr<IpxGenParam::Param>> m_params;
+        std::map<std::string, IpxGenParam::Param*> m_byName;
+    };
+
+} // end of namespace IpxGenParamImpl
+
+#endif // __cplusplus
+
+#endif // IPX_GEN_PARAM_IMPL_H
@@ -69,6 +69,46 @@
 /// @{
 ////////
 
+//! IpxImageConverter component error codes
+#define IPX_ERR_CONV_INVALID_ARGUMENT IPX_ERR(IPX_CMP_IMG_CONVERTER, IPX_ERR_INVALID_ARGUMENT)
+#define IPX_ERR_CONV_NO_MEMORY        IPX_ERR(IPX_CMP_IMG_CONVERTER, IPX_ERR_NOT_ENOUGH_MEMORY)
+#define IPX_ERR_CONV_NOT_SUPPORTED    IPX_ERR(IPX_CMP_IMG_CONVERTER, IPX_ERR_NOT_SUPPORTED)
+
+/*! \addtogroup conv_params Converter Parameters of IpxImageConverterCpu
+ *  \brief Defines for the parameters of the 10...16-bit to 8-bit conversion of IpxImageConverterCpu
+ * @{
+<table>
+        <caption id="conv_params">Converter Parameters</caption>
+		<tr><th>Macro<th>Parameter Name<th>Type and Range<th>Description
+		<tr><td rowspan="1"><b>CONV_NOREALLOC</b><td>"NoRealloc"<td>[int: 0,1]<td>No Realloc enabled
+		<tr><td rowspan="1"><b>CONV_LUT_MODE</b><td>"LutMode"<td>[int: 0,2]<td>Mapping of the source values to 8 bits, CONV_LUT_LINEAR by default
+		<tr><td rowspan="1"><b>CONV_WINDOW_WIDTH</b><td>"WindowWidth"<td>[int: 0-65536]<td>Width of the window of the source values mapped to 0...255 by CONV_LUT_WINDOW, 0 - the full range of the source depth
+		<tr><td rowspan="1"><b>CONV_WINDOW_LEVEL</b><td>"WindowLevel"<td>[int: 0-65535]<td>Center of the window of the source values
+		<tr><td rowspan="1"><b>CONV_GAMMA</b><td>"Gamma"<td>[float: 0.1-10]<td>Gamma of CONV_LUT_WINDOW, the output is 255 * x ^ (1 / Gamma), 1 by default
+		<tr><td rowspan="1"><b>CONV_LUT</b><td>"Lut"<td>[array: 256-65536 bytes]<td>Table of CONV_LUT_USER, the 8-bit output of every source value, the size is a power of 2
+		<tr><td rowspan="1"><b>CONV_FORCE_ISA</b><td>"ForceIsa"<td>[int: 0,4]<td>Instruction set of the CPU kernels, 0 - automatic, see BAYER_ISA_AUTO
+		<tr><td rowspan="1"><b>CONV_ACTIVE_ISA</b><td>"ActiveIsa"<td>[int: 1,4]<td>Instruction set used by the CPU kernels, read-only
+</table>*/
+
+#define CONV_NOREALLOC		"NoRealloc"		/*!< No Realloc enabled\n\n<b>Type/Range</b>    [int: 0,1]  \note Used by SetParamInt and GetParamInt*/
+#define CONV_LUT_MODE		"LutMode"		/*!< Mapping of the source values to 8 bits\n\n<b>Type/Range</b>    [int: 0,2]  \note Used by SetParamInt and GetParamInt*/
+#define CONV_WINDOW_WIDTH	"WindowWidth"	/*!< Width of the window of the source values, 0 - the full range of the source depth\n\n<b>Type/Range</b>    [int: 0-65536]  \note Used by SetParamInt and GetParamInt*/
+#define CONV_WINDOW_LEVEL	"WindowLevel"	/*!< Center of the window of the source values\n\n<b>Type/Range</b>    [int: 0-65535]  \note Used by SetParamInt and GetParamInt*/
+#define CONV_GAMMA			"Gamma"			/*!< Gamma of the window mapping\n\n<b>Type/Range</b>    [float: 0.1-10]  \note Used by SetParamFloat and GetParamFloat*/
+#define CONV_LUT			"Lut"			/*!< Table of the user mapping, 2^N bytes\n\n<b>Type/Range</b>    [array: 256-65536 bytes]  \note Used by SetParamArray and GetParamArray*/
+#define CONV_FORCE_ISA		"ForceIsa"		/*!< Instruction set of the CPU kernels, 0 - automatic\n\n<b>Type/Range</b>    [int: 0,4]  \note Used by SetParamInt and GetParamInt*/
+#define CONV_ACTIVE_ISA		"ActiveIsa"		/*!< Instruction set used by the CPU kernels\n\n<b>Type/Range</b>    [int: 1,4]  \note Used by GetParamInt*/
+/*! @}*/
+
+/// Mappings of the source values to 8 bits
+/*! \addtogroup conv_lut Converter LUT Modes
+ \brief Defines the values of the CONV_LUT_MODE parameter
+ *  @{*/
+#define CONV_LUT_LINEAR		0	/**< The source value shifted right by (depth - 8), the SIMD kernels. */
+#define CONV_LUT_WINDOW		1	/**< The table computed from CONV_WINDOW_WIDTH, CONV_WINDOW_LEVEL and CONV_GAMMA when they change. */
+#define CONV_LUT_USER		2	/**< The table set by CONV_LUT. */
+/*! @}*/
+
 #ifdef __cplusplus
 /**  
 * A class containing methods for IpxImageConverter modules.   
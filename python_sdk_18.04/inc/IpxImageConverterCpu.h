@@ -0,0 +1,465 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Imaging API SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxImageConverterCpu.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Header-only IpxImageConverter component converting the 10...16-bit images to 8 bits
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _IPX_IMAGE_CONVERTER_CPU_H_
+#define _IPX_IMAGE_CONVERTER_CPU_H_
+
+#include "IpxImageConverter.h"
+#include "IpxToolsImpl.h"
+
+#ifdef __cplusplus
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <new>
+
+/*! \namespace IpxConvertKernels
+	\brief A namespace provides the CPU kernels of IpxImageConverterCpu.
+
+	\details CONV_LUT_LINEAR shifts the 16-bit values right by (depth - 8) and saturates them to 255, the vector
+	kernels shift and pack 8, 16 or 32 values per instruction. The table kernel reads one byte of the table per value,
+	the table of the 16-bit source is 64 KB and stays in the L2 cache.
+*/
+namespace IpxConvertKernels
+{
+	//! Narrows n values to 8 bits by the shift
+	typedef void (*ShiftFn)( const uint16_t *src, uint8_t *dst, int n, int shift );
+
+	inline void ShiftScalar( const uint16_t *src, uint8_t *dst, int n, int shift )
+	{
+		for (int i = 0; i < n; ++i)
+		{
+			const int v = src[i] >> shift;
+			dst[i] = static_cast<uint8_t>(v > 255 ? 255 : v);
+		}
+	}
+
+#if IPX_TOOLS_X86_DISPATCH
+	// the shift is at least 2, so the values fit the signed 16 bits of packus
+	IPX_TARGET_SSE41 inline void ShiftSse41( const uint16_t *src, uint8_t *dst, int n, int shift )
+	{
+		const __m128i count = _mm_cvtsi32_si128(shift);
+		int i = 0;
+		for (; i + 16 <= n; i += 16)
+		{
+			const __m128i lo = _mm_srl_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), count);
+			const __m128i hi = _mm_srl_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8)), count);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+		}
+		ShiftScalar(src + i, dst + i, n - i, shift);
+	}
+
+	// packus works within the 128-bit lanes, the 64-bit quarters are reordered before the store
+	IPX_TARGET_AVX2 inline void ShiftAvx2( const uint16_t *src, uint8_t *dst, int n, int shift )
+	{
+		const __m128i count = _mm_cvtsi32_si128(shift);
+		int i = 0;
+		for (; i + 32 <= n; i += 32)
+		{
+			const __m256i lo = _mm256_srl_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), count);
+			const __m256i hi = _mm256_srl_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 16)), count);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8));
+		}
+		ShiftScalar(src + i, dst + i, n - i, shift);
+	}
+
+	IPX_TARGET_AVX512 inline void ShiftAvx512( const uint16_t *src, uint8_t *dst, int n, int shift )
+	{
+		const __m128i count = _mm_cvtsi32_si128(shift);
+		int i = 0;
+		for (; i + 32 <= n; i += 32)
+		{
+			const __m512i v = _mm512_srl_epi16(_mm512_loadu_si512(src + i), count);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm512_cvtusepi16_epi8(v));
+		}
+		ShiftScalar(src + i, dst + i, n - i, shift);
+	}
+#endif
+
+	//! Returns the shift kernel of the instruction set level
+	inline ShiftFn GetShift( int isa )
+	{
+#if IPX_TOOLS_X86_DISPATCH
+		if (isa >= IpxToolsImpl::IsaAvx512)
+			return &ShiftAvx512;
+		if (isa >= IpxToolsImpl::IsaAvx2)
+			return &ShiftAvx2;
+		if (isa >= IpxToolsImpl::IsaSse41)
+			return &ShiftSse41;
+#else
+		(void)isa;
+#endif
+		return &ShiftScalar;
+	}
+
+	//! Maps n values by the table, the index is the value shifted right by shift and limited by last
+	inline void Lut( const uint16_t *src, uint8_t *dst, int n, const uint8_t *lut, int shift, uint32_t last )
+	{
+		int i = 0;
+		for (; i + 4 <= n; i += 4)
+		{
+			const uint32_t a = std::min<uint32_t>(src[i] >> shift, last), b = std::min<uint32_t>(src[i + 1] >> shift, last);
+			const uint32_t c = std::min<uint32_t>(src[i + 2] >> shift, last), d = std::min<uint32_t>(src[i + 3] >> shift, last);
+			dst[i] = lut[a];
+			dst[i + 1] = lut[b];
+			dst[i + 2] = lut[c];
+			dst[i + 3] = lut[d];
+		}
+		for (; i < n; ++i)
+			dst[i] = lut[std::min<uint32_t>(src[i] >> shift, last)];
+	}
+
+	//! Swaps the first and the third bytes of the 3-byte pixels
+	inline void SwapRB( uint8_t *row, int pixels )
+	{
+		for (int x = 0; x < pixels; ++x, row += 3)
+			std::swap(row[0], row[2]);
+	}
+
+	//! Fills the table of 2^depth values mapping the window [level - width / 2, level + width / 2) to 0...255 with the gamma
+	/*!
+	\param[out] lut the table
+	\param[in] depth bits of the source values
+	\param[in] width the width of the window, 0 - the full range of the depth
+	\param[in] level the center of the window
+	\param[in] gamma the output is 255 * x ^ (1 / gamma), x is 0...1 inside the window
+	*/
+	inline void FillWindowLut( std::vector<uint8_t> &lut, int depth, int width, int level, double gamma )
+	{
+		const int size = 1 << depth;
+		double lo = 0.0, range = size - 1.0;
+		if (width > 0)
+		{
+			lo = level - width / 2.0;
+			range = width - 1.0 > 0.0 ? width - 1.0 : 1.0;
+		}
+		lut.resize(size);
+		const double exponent = 1.0 / gamma;
+		for (int v = 0; v < size; ++v)
+		{
+			const double x = std::min(1.0, std::max(0.0, (v - lo) / range));
+			lut[v] = static_cast<uint8_t>(std::pow(x, exponent) * 255.0 + 0.5);
+		}
+	}
+}
+
+/*!
+\brief IpxImageConverter component converting the high bit depth images to 8 bits, the implementation is in the header
+\details The component converts II_PIX_MONO10 ... II_PIX_MONO16 to II_PIX_MONO8, II_PIX_RGB10 ... II_PIX_BGR16 to
+II_PIX_RGB8 or II_PIX_BGR8 and the unpacked 10...16-bit Bayer types to the 8-bit Bayer type of the same CFA order,
+the other conversions return IPX_ERR_CONV_NOT_SUPPORTED. CONV_LUT_MODE selects the mapping:
+- CONV_LUT_LINEAR: the value shifted right by (depth - 8), the SIMD kernels selected at run time like IpxBayerCpu
+- CONV_LUT_WINDOW: the table of CONV_WINDOW_WIDTH, CONV_WINDOW_LEVEL and CONV_GAMMA, computed by the first conversion
+after they change
+- CONV_LUT_USER: the table set by CONV_LUT, so the contrast of every frame is changed by one SetParamArray of the
+precomputed table. The table of 2^N bytes is indexed by the source value shifted right by (depth - N) if N < depth
+
+The values above the source depth are saturated to 255 or to the last entry of the table.
+\code
+IpxImageConverterCpu *conv = IpxImageConverterCpu::CreateComponent();
+conv->GetComponent()->SetParamInt(CONV_LUT_MODE, CONV_LUT_WINDOW);
+conv->GetComponent()->SetParamInt(CONV_WINDOW_WIDTH, 1024);
+conv->GetComponent()->SetParamInt(CONV_WINDOW_LEVEL, 600);
+conv->GetComponent()->SetParamFloat(CONV_GAMMA, 2.2);
+
+IpxImage *mono8 = nullptr;
+IpxError err = conv->IIConvert(mono12, II_PIX_MONO8, &mono8);	// mono8 is owned by the component
+...
+IpxImageConverterCpu::DeleteComponent(conv);
+\endcode
+*/
+class IpxImageConverterCpu final : public IpxImageConverter
+{
+public:
+
+	//! Creates the component
+	static IpxImageConverterCpu* CreateComponent() { return new IpxImageConverterCpu(); }
+
+	//! Deletes the component and the data allocated by it
+	static void DeleteComponent( IpxImageConverterCpu* in ) { delete in; }
+
+	IpxImageConverterCpu() {}
+	virtual ~IpxImageConverterCpu() {}
+
+	IpxComponent* GetComponent() override { return &m_component; }
+
+	//! Converts the source to the pixel type of the output, the output data is allocated by the component if it does not fit
+	/*!
+	\param[in] source the 10...16-bit mono, Bayer, RGB or BGR image
+	\param[in,out] output the output image, the pixel type 0 - the 8-bit type of the source
+	*/
+	IpxError ConvertImage( IpxImage* source, IpxImage* output ) override
+	{
+		if (!output)
+			return IPX_ERR_CONV_INVALID_ARGUMENT;
+		return Convert(source, output, output->pixelTypeDescr.pixelType, m_data, m_component.GetNoRealloc());
+	}
+
+	//! Converts the source to the image of outPixelType owned by the component until the next IIConvert or ReleaseData
+	IpxError IIConvert( IpxImage* image_in, unsigned long outPixelType, IpxImage** image_out ) override
+	{
+		if (!image_out)
+			return IPX_ERR_CONV_INVALID_ARGUMENT;
+		IpxError err = Convert(image_in, &m_output, static_cast<uint32_t>(outPixelType), m_outputData, false);
+		*image_out = err == IPX_ERR_OK ? &m_output : nullptr;
+		return err;
+	}
+
+	//! Releases the output data and the tables
+	void ReleaseData()
+	{
+		std::vector<uint64_t>().swap(m_data);
+		std::vector<uint64_t>().swap(m_outputData);
+		std::vector<uint8_t>().swap(m_windowLut);
+		m_output = IpxImage();
+		m_windowKey = WindowKey();
+	}
+
+private:
+	class Component : public IpxToolsImpl::ParamComponent
+	{
+	public:
+		Component() : IpxToolsImpl::ParamComponent(IPX_CMP_IMG_CONVERTER)
+		{
+			m_noRealloc = AddParamInt(CONV_NOREALLOC, 0, 0, 1);
+			m_lutMode = AddParamInt(CONV_LUT_MODE, CONV_LUT_LINEAR, CONV_LUT_LINEAR, CONV_LUT_USER);
+			m_width = AddParamInt(CONV_WINDOW_WIDTH, 0, 0, 65536);
+			m_level = AddParamInt(CONV_WINDOW_LEVEL, 0, 0, 65535);
+			AddIsaParams(CONV_FORCE_ISA, CONV_ACTIVE_ISA);
+		}
+
+		bool GetNoRealloc() const { return GetInt(m_noRealloc) != 0; }
+		int GetLutMode() const { return static_cast<int>(GetInt(m_lutMode)); }
+		int GetWindowWidth() const { return static_cast<int>(GetInt(m_width)); }
+		int GetWindowLevel() const { return static_cast<int>(GetInt(m_level)); }
+		double GetGamma() const { return m_gamma; }
+		const std::vector<uint8_t>& GetUserLut() const { return m_userLut; }
+
+		IpxError SetParamFloat( const char* name, double param ) override
+		{
+			if (!name || strcmp(name, CONV_GAMMA) != 0)
+				return ParamComponent::SetParamFloat(name, param);
+			if (!(param >= 0.1 && param <= 10.0))
+				return Error(IPX_ERR_OUT_OF_RANGE);
+			m_gamma = param;
+			return IPX_ERR_OK;
+		}
+
+		IpxError GetParamFloat( const char* name, double* param ) override
+		{
+			if (!name || strcmp(name, CONV_GAMMA) != 0)
+				return ParamComponent::GetParamFloat(name, param);
+			if (!param)
+				return Error(IPX_ERR_NULL_POINTER);
+			*param = m_gamma;
+			return IPX_ERR_OK;
+		}
+
+		//! Copies the table, 2^N bytes for N = 8...16
+		IpxError SetParamArray( const char* name, void* param, uint32_t size ) override
+		{
+			if (!name || strcmp(name, CONV_LUT) != 0)
+				return ParamComponent::SetParamArray(name, param, size);
+			if (!param)
+				return Error(IPX_ERR_NULL_POINTER);
+			if (size < 256 || size > 65536 || (size & (size - 1)))
+				return Error(IPX_ERR_OUT_OF_RANGE);
+			m_userLut.assign(static_cast<const uint8_t*>(param), static_cast<const uint8_t*>(param) + size);
+			return IPX_ERR_OK;
+		}
+
+		IpxError GetParamArray( const char* name, void* param, uint32_t* size ) override
+		{
+			if (!name || strcmp(name, CONV_LUT) != 0)
+				return ParamComponent::GetParamArray(name, param, size);
+			if (!size)
+				return Error(IPX_ERR_NULL_POINTER);
+			const uint32_t required = static_cast<uint32_t>(m_userLut.size());
+			if (!param || *size < required)
+			{
+				*size = required;
+				return Error(IPX_ERR_BUFFER_TOO_SMALL);
+			}
+			if (required)
+				memcpy(param, m_userLut.data(), required);
+			*size = required;
+			return IPX_ERR_OK;
+		}
+
+	private:
+		size_t m_noRealloc, m_lutMode, m_width, m_level;
+		double m_gamma = 1.0;
+		std::vector<uint8_t> m_userLut;
+	};
+
+	// the parameters of the computed table
+	struct WindowKey
+	{
+		int depth = 0;
+		int width = 0;
+		int level = 0;
+		double gamma = 0.0;
+
+		bool operator==( const WindowKey &k ) const
+		{
+			return depth == k.depth && width == k.width && level == k.level && gamma == k.gamma;
+		}
+	};
+
+	// returns the depth, the channels and the 8-bit output type of the source, outType 0 - the default one
+	static bool GetConversion( uint32_t srcType, uint32_t outType, int *depth, int *channels, bool *swap, uint32_t *dstType )
+	{
+		if (II_GET_PIXEL_BITS_SIZE(srcType) != 16 * (II_IS_COLOR_RGB_PIXEL(srcType) ? 3u : 1u))
+			return false;
+		switch (II_GET_PIXEL_ALIGNMENT(srcType))
+		{
+		case II_ALIGN_10: *depth = 10; break;
+		case II_ALIGN_12: *depth = 12; break;
+		case II_ALIGN_14: *depth = 14; break;
+		case II_ALIGN_16: *depth = 16; break;
+		default: return false;
+		}
+		*swap = false;
+		*channels = 1;
+		if (II_IS_MONO_PIXEL(srcType))
+			*dstType = II_PIX_MONO8;
+		else if (II_IS_BAYER_CFA_PIXEL(srcType))
+		{
+			// the Bayer types of a depth are GR, RG, GB, BG, the 8-bit ones are the first 4 IDs
+			static const uint32_t bayer8[4] = { II_PIX_BAYGR8, II_PIX_BAYRG8, II_PIX_BAYGB8, II_PIX_BAYBG8 };
+			const uint32_t gr[4] = { II_PIX_BAYGR10, II_PIX_BAYGR12, II_PIX_BAYGR14, II_PIX_BAYGR16 };
+			const uint32_t id = II_GET_PIXEL_ID(srcType);
+			*dstType = 0;
+			for (uint32_t g : gr)
+				if (id >= II_GET_PIXEL_ID(g) && id < II_GET_PIXEL_ID(g) + 4)
+					*dstType = bayer8[id - II_GET_PIXEL_ID(g)];
+			if (!*dstType)
+				return false;
+		}
+		else if (II_IS_COLOR_RGB_PIXEL(srcType))
+		{
+			const bool bgr = srcType == II_PIX_BGR10 || srcType == II_PIX_BGR12 || srcType == II_PIX_BGR14 || srcType == II_PIX_BGR16;
+			*channels = 3;
+			*dstType = bgr ? II_PIX_BGR8 : II_PIX_RGB8;
+			if (outType == II_PIX_RGB8 || outType == II_PIX_BGR8)
+			{
+				*swap = outType != *dstType;
+				*dstType = outType;
+			}
+		}
+		else
+			return false;
+		return outType == 0 || outType == *dstType;
+	}
+
+	static bool Fits( const IpxImage* pDst, uint32_t type, uint32_t width, uint32_t height )
+	{
+		return pDst->imageData && pDst->pixelTypeDescr.pixelType == type && pDst->width == width && pDst->height == height
+			&& pDst->rowSize >= IpxGetRowSizeUnaligned(type, width) && uint64_t(pDst->imageSize) >= uint64_t(pDst->rowSize) * height;
+	}
+
+	IpxError Convert( const IpxImage* src, IpxImage* dst, uint32_t outType, std::vector<uint64_t> &storage, bool noRealloc )
+	{
+		int depth = 0, channels = 0;
+		bool swap = false;
+		uint32_t dstType = 0;
+		if (!src || !src->imageData || !GetConversion(src->pixelTypeDescr.pixelType, outType, &depth, &channels, &swap, &dstType))
+			return src && src->imageData ? IPX_ERR_CONV_NOT_SUPPORTED : IPX_ERR_CONV_INVALID_ARGUMENT;
+		if (src->width > 0x3FFFFFFFu / 3 || src->rowSize < src->width * 2u * channels)
+			return IPX_ERR_CONV_INVALID_ARGUMENT;
+		if (!Fits(dst, dstType, src->width, src->height))
+		{
+			if (noRealloc)
+				return IPX_ERR_CONV_NO_MEMORY;
+			try
+			{
+				if (!IpxToolsImpl::InitOwnedImage(dst, dstType, src->width, src->height, storage))
+					return IPX_ERR_CONV_INVALID_ARGUMENT;
+			}
+			catch (const std::bad_alloc&)
+			{
+				return IPX_ERR_CONV_NO_MEMORY;
+			}
+		}
+
+		// the table and the index shift of the mode, nullptr - the linear shift
+		const uint8_t *lut = nullptr;
+		int shift = depth - 8;
+		uint32_t last = 0;
+		const int mode = m_component.GetLutMode();
+		if (mode == CONV_LUT_WINDOW)
+		{
+			WindowKey key;
+			key.depth = depth;
+			key.width = m_component.GetWindowWidth();
+			key.level = m_component.GetWindowLevel();
+			key.gamma = m_component.GetGamma();
+			if (!(key == m_windowKey) || m_windowLut.empty())
+			{
+				try
+				{
+					IpxConvertKernels::FillWindowLut(m_windowLut, depth, key.width, key.level, key.gamma);
+				}
+				catch (const std::bad_alloc&)
+				{
+					return IPX_ERR_CONV_NO_MEMORY;
+				}
+				m_windowKey = key;
+			}
+			lut = m_windowLut.data();
+			shift = 0;
+			last = static_cast<uint32_t>(m_windowLut.size() - 1);
+		}
+		else if (mode == CONV_LUT_USER)
+		{
+			const std::vector<uint8_t> &table = m_component.GetUserLut();
+			if (table.empty())
+				return IPX_ERR_CONV_INVALID_ARGUMENT;
+			int bits = 0;
+			while ((size_t(1) << bits) < table.size())
+				++bits;
+			lut = table.data();
+			shift = depth > bits ? depth - bits : 0;
+			last = static_cast<uint32_t>(table.size() - 1);
+		}
+
+		const IpxConvertKernels::ShiftFn narrow = IpxConvertKernels::GetShift(m_component.GetIsa());
+		const int n = static_cast<int>(src->width) * channels;
+		for (uint32_t y = 0; y < src->height; ++y)
+		{
+			const uint16_t *s = reinterpret_cast<const uint16_t*>(src->imageData + size_t(y) * src->rowSize);
+			uint8_t *d = reinterpret_cast<uint8_t*>(dst->imageData + size_t(y) * dst->rowSize);
+			if (lut)
+				IpxConvertKernels::Lut(s, d, n, lut, shift, last);
+			else
+				narrow(s, d, n, shift);
+			if (swap)
+				IpxConvertKernels::SwapRB(d, static_cast<int>(src->width));
+		}
+		dst->timestamp = src->timestamp;
+		dst->imageID = src->imageID;
+		return IPX_ERR_OK;
+	}
+
+	Component m_component;
+	std::vector<uint64_t> m_data;			// the output of ConvertImage
+	std::vector<uint64_t> m_outputData;		// the output of IIConvert
+	IpxImage m_output;
+	std::vector<uint8_t> m_windowLut;		// the table of CONV_LUT_WINDOW
+	WindowKey m_windowKey;					// the parameters of m_windowLut
+};
+
+#endif // __cplusplus
+
+#endif // _IPX_IMAGE_CONVERTER_CPU_H_
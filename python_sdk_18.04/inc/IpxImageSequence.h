@@ -0,0 +1,1309 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Imaging API SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxImageSequence.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Single-file raw image sequence: the file format, the writer and the reader
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _IPX_IMAGE_SEQUENCE_H_
+#define _IPX_IMAGE_SEQUENCE_H_
+
+#include "IpxImage.h"
+#include "IpxImageApi.h"
+#include "IpxToolsBase.h"
+
+#ifdef __cplusplus
+
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <cerrno>
+#endif
+
+// io_uring of the writer, the system calls are used directly
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(IORING_FEAT_RW_CUR_POS)
+#define IPX_SEQ_URING 1
+#endif
+#endif
+#endif
+#ifndef IPX_SEQ_URING
+#define IPX_SEQ_URING 0
+#endif
+
+/*! \namespace IpxImageSequence
+	\brief A namespace provides the single-file raw image sequence.
+
+	\details The sequence file keeps the raw images of a recording one after another with their metadata, so a recording
+	creates one file instead of a file per frame. All the fields are little-endian, all the offsets are from the start
+	of the file and are multiples of PageSize:
+	- the page of FileHeader;
+	- the records, one per image: the page of RecordHeader, then the image data padded to PageSize;
+	- the page of IndexHeader with the IndexEntry array, written by Writer::Close, padded to PageSize.
+
+	FileHeader::indexOffset is 0 until the file is closed, the reader of such a file finds the records by RecordHeader::
+	recordSize starting from the first page. The image data of every record starts at a page boundary, so the reader can
+	map the file and use the images in place.
+
+	Writer reserves the place of the record before the image is written, so several threads write the records of one
+	file at the same time, and writes the pages with O_DIRECT (FILE_FLAG_NO_BUFFERING), bypassing the page cache. The
+	file is extended by Params::preallocBytes at once, so the writes do not change the file size. On Linux the records
+	are written by io_uring: WriteRecords submits the pages of up to Params::ringDepth records by one system call, the
+	file is the fixed file of the ring and the memory of Params::buffers (the stream buffers) is registered, so the
+	kernel does not map the pages of every write. Without io_uring the records are written by pwritev, by the threads
+	calling Write:
+	\code
+	IpxImageSequence::Writer writer;
+	IpxImageSequence::Writer::Params params;
+	IpxError err = writer.Open("/data/cam0.ipxseq", params);
+	...
+	err = writer.WriteImage(image);			// or Reserve, Write and Commit by several threads
+	...
+	err = writer.Close();					// writes the index
+	\endcode
+
+	Reader maps the file and returns the images pointing into the mapping, so opening a long recording does not read it
+	and a frame is found by its number or timestamp without a copy:
+	\code
+	IpxImageSequence::Reader reader;
+	if (reader.Open("/data/cam0.ipxseq") == IPX_ERR_OK)
+	{
+		reader.SetAccess(IpxImageSequence::Reader::AccessRandom);	// scrubbing
+		uint64_t frame = reader.FindTimestamp(timestamp);
+		reader.Prefetch(frame, 8);									// the next frames are read ahead
+		IpxImage image;
+		if (reader.GetImage(frame, &image) == IPX_ERR_OK)
+			Display(&image);										// the data is valid until Close
+	}
+	\endcode
+*/
+namespace IpxImageSequence
+{
+	//! Alignment of the headers, the records and the index
+	const uint32_t PageSize = 4096;
+
+	const char FileMagic[8] = { 'I', 'P', 'X', 'R', 'A', 'W', 'S', 'Q' };
+	const uint32_t RecordMagic = 0x52585049;	// "IPXR"
+	const uint32_t IndexMagic = 0x49585049;		// "IPXI"
+	const uint32_t Version = 1;
+
+	//! The first page of the file
+	struct FileHeader
+	{
+		char magic[8];			//!< FileMagic
+		uint32_t version;		//!< Version
+		uint32_t headerSize;	//!< sizeof(FileHeader)
+		uint32_t pageSize;		//!< PageSize
+		uint32_t recordHeaderSize;	//!< sizeof(RecordHeader)
+		uint64_t frameCount;	//!< number of the records in the index, 0 until the file is closed
+		uint64_t indexOffset;	//!< offset of IndexHeader, 0 until the file is closed
+		uint64_t dataEnd;		//!< offset following the last record, 0 until the file is closed
+		uint64_t reserved[8];
+	};
+
+	//! The first page of the record, the image data follows at the next page
+	struct RecordHeader
+	{
+		uint32_t magic;			//!< RecordMagic
+		uint32_t headerSize;	//!< sizeof(RecordHeader)
+		uint64_t frameNumber;	//!< position of the record in the file, from 0
+		uint64_t recordSize;	//!< size of the record including the header page and the padding
+		uint64_t imageID;		//!< IpxImage::imageID, the frame ID of the camera
+		uint64_t timestamp;		//!< IpxImage::timestamp, the timestamp of the camera
+		uint32_t pixelType;		//!< IpxImage::pixelTypeDescr.pixelType
+		uint32_t width;
+		uint32_t height;
+		uint32_t rowSize;
+		uint32_t imageSize;		//!< size of the image data
+		int32_t origin;
+		uint64_t reserved[4];
+	};
+
+	//! The header of the index
+	struct IndexHeader
+	{
+		uint32_t magic;			//!< IndexMagic
+		uint32_t entrySize;		//!< sizeof(IndexEntry)
+		uint64_t count;			//!< number of the entries following the header
+	};
+
+	//! The entry of the index, the entries are in the order of frameNumber
+	struct IndexEntry
+	{
+		uint64_t offset;		//!< offset of RecordHeader
+		uint64_t imageID;
+		uint64_t timestamp;
+	};
+
+	//! The memory of the images registered with io_uring, such as the stream buffers
+	struct Region
+	{
+		const void *data;
+		size_t size;
+	};
+
+	//! Returns the size of the record of the image data
+	inline uint64_t GetRecordSize( uint32_t imageSize )
+	{
+		return PageSize + (static_cast<uint64_t>(imageSize) + PageSize - 1) / PageSize * PageSize;
+	}
+
+	//! Page-aligned memory of the pages written by a thread, reused by the next images
+	class Staging
+	{
+	public:
+		//! Returns at least size bytes aligned to PageSize, nullptr if the memory is not available
+		uint8_t* Get( size_t size )
+		{
+			try
+			{
+				if (m_memory.size() < size + PageSize)
+					m_memory.resize(size + PageSize);
+			}
+			catch (const std::bad_alloc&)
+			{
+				return nullptr;
+			}
+			const uintptr_t base = reinterpret_cast<uintptr_t>(m_memory.data());
+			return m_memory.data() + (PageSize - base % PageSize) % PageSize;
+		}
+
+	private:
+		std::vector<uint8_t> m_memory;
+	};
+
+	/**
+	\brief Writer of the sequence file
+	\details Reserve, Write and Commit can be called by several threads at the same time, each with its own Staging;
+	the records are numbered in the order of Reserve. Open and Close must not overlap with them.
+	*/
+	class Writer
+	{
+	public:
+		//! Parameters of the file
+		struct Params
+		{
+			Params() : directIo(true), preallocBytes(uint64_t(1) << 30), ringDepth(32) {}
+
+			bool directIo;			//!< writes bypass the page cache, ignored if the file system does not support it
+			uint64_t preallocBytes;	//!< the file is extended by this size at once, 0 - by every record
+			uint32_t ringDepth;		//!< records submitted to io_uring at once, 0 - the records are written by pwritev
+			std::vector<Region> buffers;	//!< the memory of the images registered with io_uring until Close
+		};
+
+		//! The place of the record returned by Reserve
+		struct Slot
+		{
+			uint64_t frameNumber;
+			uint64_t offset;
+			uint32_t imageSize;
+		};
+
+		//! The record of WriteRecords
+		struct Record
+		{
+			Slot slot;					//!< the place returned by Reserve
+			const IpxImage *image;		//!< the image
+			IpxError result;			//!< the result of the write, the records with an error on input are skipped
+		};
+
+		Writer() {}
+		~Writer() { Close(); }
+
+		Writer( const Writer& ) = delete;
+		Writer& operator=( const Writer& ) = delete;
+
+		//! Creates the file and writes the file header
+		/*!
+		\param[in] fileName the file name, the existing file is overwritten
+		\param[in] params the parameters of the file
+		\return Returns the error code
+		*/
+		IpxError Open( const char* fileName, const Params &params = Params() )
+		{
+			if (!fileName)
+				return Error(IPX_ERR_NULL_POINTER);
+			Close();
+			if (!OpenFile(fileName, params.directIo))
+				return Error(IPX_ERR_ACCESS_DENIED);
+			m_params = params;
+			m_end = PageSize;
+			m_allocated = 0;
+			m_bytes = 0;
+			m_index.clear();
+			m_failed.clear();
+			const IpxError err = WriteFileHeader(0, 0);
+			if (err != IPX_ERR_OK)
+			{
+				CloseFile();
+				return err;
+			}
+#if IPX_SEQ_URING
+			// pwritev is used if the kernel does not provide io_uring
+			if (params.ringDepth)
+				m_ring.Create(m_fd, params.ringDepth, params.buffers);
+#endif
+			return IPX_ERR_OK;
+		}
+
+		//! Returns true if the file is open
+		bool IsOpen() const { return m_open; }
+
+		//! Returns true if the writes bypass the page cache
+		bool IsDirect() const { return m_direct; }
+
+		//! Returns true if the records are written by io_uring
+		bool IsRing() const
+		{
+#if IPX_SEQ_URING
+			return m_ring.IsActive();
+#else
+			return false;
+#endif
+		}
+
+		//! Returns the number of the records WriteRecords submits at once
+		size_t GetBatchSize() const
+		{
+#if IPX_SEQ_URING
+			return m_ring.IsActive() ? m_ring.GetRecords() : 1;
+#else
+			return 1;
+#endif
+		}
+
+		//! Reserves the record of the image, the record is numbered in the order of the calls
+		IpxError Reserve( const IpxImage* image, Slot* slot )
+		{
+			if (!image || !slot)
+				return Error(IPX_ERR_NULL_POINTER);
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_open)
+				return Error(IPX_ERR_ACCESS_DENIED);
+			const uint64_t size = GetRecordSize(image->imageSize);
+			try
+			{
+				IndexEntry entry = { m_end, image->imageID, image->timestamp };
+				m_index.push_back(entry);
+				m_failed.push_back(false);
+			}
+			catch (const std::bad_alloc&)
+			{
+				return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+			}
+			// the next extent is allocated ahead, so the writes of the records do not extend the file
+			if (m_end + size > m_allocated)
+			{
+				const uint64_t end = m_end + std::max<uint64_t>(size, m_params.preallocBytes);
+				Preallocate(m_allocated, end - m_allocated);
+				m_allocated = end;
+			}
+			slot->frameNumber = m_index.size() - 1;
+			slot->offset = m_end;
+			slot->imageSize = image->imageSize;
+			m_end += size;
+			return IPX_ERR_OK;
+		}
+
+		//! Writes the record to the reserved place
+		/*!
+		\param[in] slot the place returned by Reserve for the image
+		\param[in] image the image
+		\param[in] staging the memory of the calling thread
+		\return Returns the error code
+		*/
+		IpxError Write( const Slot &slot, const IpxImage* image, Staging &staging )
+		{
+			const IpxError err = Check(slot, image);
+			if (err != IPX_ERR_OK)
+				return err;
+			const bool aligned = IsAligned(image);
+			// the header page, the tail page, or all the data if the image is not aligned for the direct write
+			uint8_t *pages = staging.Get(aligned ? 2 * PageSize : static_cast<size_t>(GetRecordSize(image->imageSize)));
+			if (!pages)
+				return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+			Chunk chunks[3];
+			const size_t count = aligned ? MakeChunks(slot, image, pages, chunks) : CopyRecord(slot, image, pages, chunks);
+			if (!WriteAt(chunks, count, slot.offset))
+				return Error(IPX_ERR_UNKNOWN);
+			m_bytes += GetRecordSize(image->imageSize);
+			return IPX_ERR_OK;
+		}
+
+		//! Writes the records of several images, by one submission of io_uring if the ring is active
+		/*!
+		\param[in,out] records the reserved places and the images, returns the results of the writes
+		\param[in] count the number of the records
+		\param[in] staging the memory of the calling thread
+		*/
+		void WriteRecords( Record* records, size_t count, Staging &staging )
+		{
+#if IPX_SEQ_URING
+			if (m_ring.IsActive())
+			{
+				std::lock_guard<std::mutex> lock(m_ringMutex);
+				// the records following the failure of the ring are written by pwritev
+				size_t first = 0;
+				for (size_t n; first < count && (n = std::min(count - first, m_ring.GetRecords())) != 0; first += n)
+					WriteRing(records + first, n, staging);
+				records += first;
+				count -= first;
+			}
+#endif
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (records[i].result == IPX_ERR_OK)
+					records[i].result = Write(records[i].slot, records[i].image, staging);
+			}
+		}
+
+		//! Marks the record written, the failed records are left out of the index
+		void Commit( const Slot &slot, bool written )
+		{
+			if (written)
+				return;
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (slot.frameNumber < m_failed.size())
+				m_failed[slot.frameNumber] = true;
+		}
+
+		//! Writes the image, the single-thread form of Reserve, Write and Commit
+		IpxError WriteImage( const IpxImage* image )
+		{
+			Slot slot;
+			IpxError err = Reserve(image, &slot);
+			if (err != IPX_ERR_OK)
+				return err;
+			Record record = { slot, image, IPX_ERR_OK };
+			WriteRecords(&record, 1, m_staging);
+			Commit(slot, record.result == IPX_ERR_OK);
+			return record.result;
+		}
+
+		//! Returns the number of the bytes of the written records
+		uint64_t GetBytesWritten() const { return m_bytes; }
+
+		//! Writes the index, completes the file header and closes the file
+		/*!
+		\return Returns IPX_ERR_OK if the file was not open
+		*/
+		IpxError Close()
+		{
+			if (!m_open)
+				return IPX_ERR_OK;
+
+			std::vector<IndexEntry> entries;
+			IpxError err = IPX_ERR_OK;
+			try
+			{
+				entries.reserve(m_index.size());
+				for (size_t i = 0; i < m_index.size(); ++i)
+				{
+					if (!m_failed[i])
+						entries.push_back(m_index[i]);
+				}
+			}
+			catch (const std::bad_alloc&)
+			{
+				err = Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+			}
+
+			const uint64_t indexOffset = m_end;
+			const size_t indexBytes = sizeof(IndexHeader) + entries.size() * sizeof(IndexEntry);
+			const size_t padded = (indexBytes + PageSize - 1) / PageSize * PageSize;
+			if (err == IPX_ERR_OK)
+			{
+				uint8_t *pages = m_staging.Get(padded);
+				if (!pages)
+					err = Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+				else
+				{
+					memset(pages, 0, padded);
+					IndexHeader header = { IndexMagic, sizeof(IndexEntry), entries.size() };
+					memcpy(pages, &header, sizeof(header));
+					if (!entries.empty())
+						memcpy(pages + sizeof(header), entries.data(), entries.size() * sizeof(IndexEntry));
+					Chunk chunk(pages, padded);
+					if (!WriteAt(&chunk, 1, indexOffset))
+						err = Error(IPX_ERR_UNKNOWN);
+				}
+			}
+			if (err == IPX_ERR_OK)
+				err = WriteFileHeader(entries.size(), indexOffset);
+			// the preallocated extent is cut after the index, or after the records if the index was not written
+			Truncate(err == IPX_ERR_OK ? indexOffset + padded : m_end);
+#if IPX_SEQ_URING
+			m_ring.Destroy();
+#endif
+			CloseFile();
+			return err;
+		}
+
+	private:
+		struct Chunk
+		{
+			Chunk() : data(nullptr), size(0) {}
+			Chunk( const void *d, size_t s ) : data(d), size(s) {}
+
+			const void *data;
+			size_t size;
+		};
+
+		static IpxError Error( uint32_t code ) { return IPX_ERR(IPX_CMP_IMG_SERIALIZER, code); }
+
+		static IpxError Check( const Slot &slot, const IpxImage* image )
+		{
+			if (!image || !image->imageData)
+				return Error(IPX_ERR_NULL_POINTER);
+			return image->imageSize == slot.imageSize ? IPX_ERR_OK : Error(IPX_ERR_INVALID_ARGUMENT);
+		}
+
+		// the direct write needs the data at a page boundary
+		bool IsAligned( const IpxImage* image ) const
+		{
+			return !m_direct || reinterpret_cast<uintptr_t>(image->imageData) % PageSize == 0;
+		}
+
+		static void FillHeader( const Slot &slot, const IpxImage* image, uint8_t *page )
+		{
+			memset(page, 0, PageSize);
+			RecordHeader *header = reinterpret_cast<RecordHeader*>(page);
+			header->magic = RecordMagic;
+			header->headerSize = sizeof(RecordHeader);
+			header->frameNumber = slot.frameNumber;
+			header->recordSize = GetRecordSize(image->imageSize);
+			header->imageID = image->imageID;
+			header->timestamp = image->timestamp;
+			header->pixelType = image->pixelTypeDescr.pixelType;
+			header->width = image->width;
+			header->height = image->height;
+			header->rowSize = image->rowSize;
+			header->imageSize = image->imageSize;
+			header->origin = image->origin;
+		}
+
+		// the header page, the page-aligned part of the image data in place and the tail page from the two pages
+		static size_t MakeChunks( const Slot &slot, const IpxImage* image, uint8_t *pages, Chunk chunks[3] )
+		{
+			const size_t size = image->imageSize;
+			const size_t body = size / PageSize * PageSize;
+			const size_t tail = size - body;
+			FillHeader(slot, image, pages);
+			size_t count = 0;
+			chunks[count++] = Chunk(pages, PageSize);
+			if (body)
+				chunks[count++] = Chunk(image->imageData, body);
+			if (tail)
+			{
+				uint8_t *last = pages + PageSize;
+				memcpy(last, image->imageData + body, tail);
+				memset(last + tail, 0, PageSize - tail);
+				chunks[count++] = Chunk(last, PageSize);
+			}
+			return count;
+		}
+
+		// the header page followed by the copy of the image data
+		static size_t CopyRecord( const Slot &slot, const IpxImage* image, uint8_t *pages, Chunk chunks[3] )
+		{
+			const size_t size = image->imageSize;
+			const size_t padded = static_cast<size_t>(GetRecordSize(image->imageSize)) - PageSize;
+			FillHeader(slot, image, pages);
+			memcpy(pages + PageSize, image->imageData, size);
+			memset(pages + PageSize + size, 0, padded - size);
+			chunks[0] = Chunk(pages, PageSize + padded);
+			return 1;
+		}
+
+		IpxError WriteFileHeader( uint64_t frameCount, uint64_t indexOffset )
+		{
+			uint8_t *page = m_staging.Get(PageSize);
+			if (!page)
+				return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+			memset(page, 0, PageSize);
+			FileHeader *header = reinterpret_cast<FileHeader*>(page);
+			memcpy(header->magic, FileMagic, sizeof(FileMagic));
+			header->version = Version;
+			header->headerSize = sizeof(FileHeader);
+			header->pageSize = PageSize;
+			header->recordHeaderSize = sizeof(RecordHeader);
+			header->frameCount = frameCount;
+			header->indexOffset = indexOffset;
+			header->dataEnd = indexOffset ? m_end : 0;
+			Chunk chunk(page, PageSize);
+			return WriteAt(&chunk, 1, 0) ? IPX_ERR_OK : Error(IPX_ERR_UNKNOWN);
+		}
+
+#ifdef _WIN32
+
+		bool OpenFile( const char* fileName, bool direct )
+		{
+			const DWORD flags = FILE_ATTRIBUTE_NORMAL | (direct ? FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH : 0);
+			m_file = CreateFileA(fileName, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, flags, nullptr);
+			if (m_file == INVALID_HANDLE_VALUE && direct)
+			{
+				direct = false;
+				m_file = CreateFileA(fileName, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+			}
+			m_open = m_file != INVALID_HANDLE_VALUE;
+			m_direct = m_open && direct;
+			return m_open;
+		}
+
+		bool WriteAt( const Chunk *chunks, size_t count, uint64_t offset )
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				OVERLAPPED ov = {};
+				ov.Offset = static_cast<DWORD>(offset);
+				ov.OffsetHigh = static_cast<DWORD>(offset >> 32);
+				DWORD written = 0;
+				if (!WriteFile(m_file, chunks[i].data, static_cast<DWORD>(chunks[i].size), &written, &ov) || written != chunks[i].size)
+					return false;
+				offset += chunks[i].size;
+			}
+			return true;
+		}
+
+		void Preallocate( uint64_t offset, uint64_t size )
+		{
+			// the allocation size reserves the clusters without writing the zeros
+			FILE_ALLOCATION_INFO info;
+			info.AllocationSize.QuadPart = static_cast<LONGLONG>(offset + size);
+			SetFileInformationByHandle(m_file, FileAllocationInfo, &info, sizeof(info));
+		}
+
+		void Truncate( uint64_t size )
+		{
+			FILE_END_OF_FILE_INFO info;
+			info.EndOfFile.QuadPart = static_cast<LONGLONG>(size);
+			SetFileInformationByHandle(m_file, FileEndOfFileInfo, &info, sizeof(info));
+		}
+
+		void CloseFile()
+		{
+			if (m_file != INVALID_HANDLE_VALUE)
+				CloseHandle(m_file);
+			m_file = INVALID_HANDLE_VALUE;
+			m_open = false;
+		}
+
+		HANDLE m_file = INVALID_HANDLE_VALUE;
+
+#else
+
+		bool OpenFile( const char* fileName, bool direct )
+		{
+			const int flags = O_RDWR | O_CREAT | O_TRUNC;
+#ifdef O_DIRECT
+			// the file systems without the direct I/O (tmpfs) reject the flag
+			m_fd = direct ? open(fileName, flags | O_DIRECT, 0644) : -1;
+			if (m_fd < 0)
+			{
+				direct = false;
+				m_fd = open(fileName, flags, 0644);
+			}
+#else
+			direct = false;
+			m_fd = open(fileName, flags, 0644);
+#endif
+			m_open = m_fd >= 0;
+			m_direct = m_open && direct;
+			return m_open;
+		}
+
+		bool WriteAt( const Chunk *chunks, size_t count, uint64_t offset )
+		{
+			struct iovec iov[3];
+			size_t total = 0;
+			for (size_t i = 0; i < count; ++i)
+			{
+				iov[i].iov_base = const_cast<void*>(chunks[i].data);
+				iov[i].iov_len = chunks[i].size;
+				total += chunks[i].size;
+			}
+			ssize_t written;
+			do
+				written = pwritev(m_fd, iov, static_cast<int>(count), static_cast<off_t>(offset));
+			while (written < 0 && errno == EINTR);
+			// a regular file is written partially only if the disk is full
+			return written == static_cast<ssize_t>(total);
+		}
+
+		void Preallocate( uint64_t offset, uint64_t size )
+		{
+#if defined(__linux__) && defined(_GNU_SOURCE)
+			// allocates the extents without writing the zeros, the file systems without it keep growing by the writes
+			fallocate(m_fd, 0, static_cast<off_t>(offset), static_cast<off_t>(size));
+#else
+			(void)offset;
+			(void)size;
+#endif
+		}
+
+		void Truncate( uint64_t size )
+		{
+			const int ret = ftruncate(m_fd, static_cast<off_t>(size));
+			(void)ret;
+		}
+
+		void CloseFile()
+		{
+			if (m_fd >= 0)
+				close(m_fd);
+			m_fd = -1;
+			m_open = false;
+		}
+
+		int m_fd = -1;
+
+#if IPX_SEQ_URING
+
+		// io_uring with the file as the fixed file, the header and tail pages and the buffers as the fixed buffers
+		class Ring
+		{
+		public:
+			struct Op
+			{
+				const void *data;
+				uint32_t size;
+				uint64_t offset;
+				size_t record;		// the index of the record in the submission
+				int result;			// the written bytes or -errno
+			};
+
+			Ring() {}
+			~Ring() { Destroy(); }
+
+			Ring( const Ring& ) = delete;
+			Ring& operator=( const Ring& ) = delete;
+
+			// returns false if the kernel does not provide io_uring with IORING_OP_WRITE
+			bool Create( int fd, uint32_t records, const std::vector<Region> &buffers )
+			{
+				Destroy();
+				io_uring_params params;
+				memset(&params, 0, sizeof(params));
+				m_ring = static_cast<int>(syscall(__NR_io_uring_setup, records * 3, &params));
+				if (m_ring < 0)
+					return false;
+				try
+				{
+					if ((params.features & IORING_FEAT_SINGLE_MMAP) && Map(params) && Probe()
+						&& syscall(__NR_io_uring_register, m_ring, IORING_REGISTER_FILES, &fd, 1) == 0)
+					{
+						m_ops.resize(static_cast<size_t>(records) * 3);
+						m_pageMemory = m_pages.Get(static_cast<size_t>(records) * 2 * PageSize);
+						if (m_pageMemory)
+						{
+							Region region = { m_pageMemory, static_cast<size_t>(records) * 2 * PageSize };
+							m_regions.assign(1, region);
+							m_regions.insert(m_regions.end(), buffers.begin(), buffers.end());
+							// the pages are registered without the buffers if the buffers can't be pinned
+							if (!RegisterBuffers(m_regions.size()) && !RegisterBuffers(1))
+								m_regions.clear();
+							m_records = records;
+							return true;
+						}
+					}
+				}
+				catch (const std::bad_alloc&)
+				{
+				}
+				Destroy();
+				return false;
+			}
+
+			void Destroy()
+			{
+				// closing the ring releases the fixed file and the fixed buffers
+				if (m_sqes)
+					munmap(m_sqes, m_sqesSize);
+				if (m_mem)
+					munmap(m_mem, m_memSize);
+				if (m_ring >= 0)
+					close(m_ring);
+				m_ring = -1;
+				m_mem = nullptr;
+				m_sqes = nullptr;
+				m_pageMemory = nullptr;
+				m_records = 0;
+				m_regions.clear();
+			}
+
+			bool IsActive() const { return m_records != 0; }
+			size_t GetRecords() const { return m_records; }
+
+			// the operations of Submit, 3 per record
+			Op* GetOps() { return m_ops.data(); }
+
+			// the header and tail pages of the record of the submission
+			uint8_t* GetPages( size_t record ) { return m_pageMemory + record * 2 * PageSize; }
+
+			// submits the operations by one system call and waits for all of them, returns false if the ring failed,
+			// no operation is in progress on return
+			bool Submit( size_t count )
+			{
+				unsigned tail = *m_sqTail;
+				for (size_t i = 0; i < count; ++i)
+				{
+					Op &op = m_ops[i];
+					const unsigned index = tail++ & m_sqMask;
+					io_uring_sqe &sqe = m_sqes[index];
+					memset(&sqe, 0, sizeof(sqe));
+					const int buffer = FindBuffer(op.data, op.size);
+					sqe.opcode = buffer < 0 ? IORING_OP_WRITE : IORING_OP_WRITE_FIXED;
+					sqe.flags = IOSQE_FIXED_FILE;
+					sqe.fd = 0;
+					sqe.off = op.offset;
+					sqe.addr = reinterpret_cast<uintptr_t>(op.data);
+					sqe.len = op.size;
+					sqe.buf_index = static_cast<uint16_t>(buffer < 0 ? 0 : buffer);
+					sqe.user_data = i;
+					op.result = -ECANCELED;
+					m_sqArray[index] = index;
+				}
+				__atomic_store_n(m_sqTail, tail, __ATOMIC_RELEASE);
+
+				size_t pending = count, done = 0;
+				while (done < count)
+				{
+					const long ret = syscall(__NR_io_uring_enter, m_ring, static_cast<unsigned>(pending),
+						static_cast<unsigned>(count - done), IORING_ENTER_GETEVENTS, nullptr, 0);
+					if (ret < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+					{
+						// the writes taken by the kernel are completed before the records are written again by pwritev,
+						// the entries left in the queue are never submitted
+						Drain(count - pending - done);
+						m_records = 0;
+						return false;
+					}
+					if (ret > 0)
+						pending -= std::min(pending, static_cast<size_t>(ret));
+					done += Reap();
+				}
+				return true;
+			}
+
+		private:
+			bool Map( const io_uring_params &params )
+			{
+				m_memSize = std::max<size_t>(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+					params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+				void *mem = mmap(nullptr, m_memSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_SQ_RING);
+				if (mem == MAP_FAILED)
+					return false;
+				m_mem = static_cast<uint8_t*>(mem);
+				m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+				void *sqes = mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring, IORING_OFF_SQES);
+				if (sqes == MAP_FAILED)
+					return false;
+				m_sqes = static_cast<io_uring_sqe*>(sqes);
+				m_sqTail = reinterpret_cast<unsigned*>(m_mem + params.sq_off.tail);
+				m_sqMask = *reinterpret_cast<unsigned*>(m_mem + params.sq_off.ring_mask);
+				m_sqArray = reinterpret_cast<unsigned*>(m_mem + params.sq_off.array);
+				m_cqHead = reinterpret_cast<unsigned*>(m_mem + params.cq_off.head);
+				m_cqTail = reinterpret_cast<unsigned*>(m_mem + params.cq_off.tail);
+				m_cqMask = *reinterpret_cast<unsigned*>(m_mem + params.cq_off.ring_mask);
+				m_cqes = reinterpret_cast<io_uring_cqe*>(m_mem + params.cq_off.cqes);
+				return true;
+			}
+
+			bool Probe()
+			{
+				const unsigned ops = 256;
+				std::vector<uint8_t> memory(sizeof(io_uring_probe) + ops * sizeof(io_uring_probe_op));
+				io_uring_probe *probe = reinterpret_cast<io_uring_probe*>(memory.data());
+				if (syscall(__NR_io_uring_register, m_ring, IORING_REGISTER_PROBE, probe, ops) != 0)
+					return false;
+				return IsSupported(probe, IORING_OP_WRITE) && IsSupported(probe, IORING_OP_WRITE_FIXED);
+			}
+
+			static bool IsSupported( const io_uring_probe *probe, unsigned op )
+			{
+				return op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+			}
+
+			bool RegisterBuffers( size_t count )
+			{
+				std::vector<iovec> iov(count);
+				for (size_t i = 0; i < count; ++i)
+				{
+					iov[i].iov_base = const_cast<void*>(m_regions[i].data);
+					iov[i].iov_len = m_regions[i].size;
+				}
+				if (syscall(__NR_io_uring_register, m_ring, IORING_REGISTER_BUFFERS, iov.data(), static_cast<unsigned>(count)) != 0)
+					return false;
+				m_regions.resize(count);
+				return true;
+			}
+
+			// returns the index of the registered memory holding the data, -1 if it is not registered
+			int FindBuffer( const void *data, size_t size ) const
+			{
+				const uintptr_t p = reinterpret_cast<uintptr_t>(data);
+				for (size_t i = 0; i < m_regions.size(); ++i)
+				{
+					const uintptr_t begin = reinterpret_cast<uintptr_t>(m_regions[i].data);
+					if (p >= begin && p - begin <= m_regions[i].size && size <= m_regions[i].size - (p - begin))
+						return static_cast<int>(i);
+				}
+				return -1;
+			}
+
+			// waits for the completions of the submitted operations without submitting the others
+			void Drain( size_t count )
+			{
+				while (count)
+				{
+					if (syscall(__NR_io_uring_enter, m_ring, 0u, static_cast<unsigned>(count), IORING_ENTER_GETEVENTS, nullptr, 0) < 0
+						&& errno != EINTR)
+						std::this_thread::yield();
+					count -= std::min(count, Reap());
+				}
+			}
+
+			size_t Reap()
+			{
+				unsigned head = *m_cqHead;
+				const unsigned tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+				size_t count = 0;
+				for (; head != tail; ++head, ++count)
+				{
+					const io_uring_cqe &cqe = m_cqes[head & m_cqMask];
+					if (cqe.user_data < m_ops.size())
+						m_ops[static_cast<size_t>(cqe.user_data)].result = cqe.res;
+				}
+				__atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+				return count;
+			}
+
+			int m_ring = -1;
+			std::atomic<size_t> m_records{0};	// 0 if the ring is not created or failed
+			uint8_t *m_mem = nullptr;
+			size_t m_memSize = 0;
+			io_uring_sqe *m_sqes = nullptr;
+			size_t m_sqesSize = 0;
+			unsigned *m_sqTail = nullptr;
+			unsigned m_sqMask = 0;
+			unsigned *m_sqArray = nullptr;
+			unsigned *m_cqHead = nullptr;
+			unsigned *m_cqTail = nullptr;
+			unsigned m_cqMask = 0;
+			io_uring_cqe *m_cqes = nullptr;
+			std::vector<Op> m_ops;
+			std::vector<Region> m_regions;	// the pages and the buffers registered in this order
+			Staging m_pages;
+			uint8_t *m_pageMemory = nullptr;
+		};
+
+		// writes the records by one submission, called with m_ringMutex locked
+		void WriteRing( Record* records, size_t count, Staging &staging )
+		{
+			Ring::Op *ops = m_ring.GetOps();
+			size_t opCount = 0;
+			for (size_t i = 0; i < count; ++i)
+			{
+				Record &record = records[i];
+				if (record.result == IPX_ERR_OK)
+					record.result = Check(record.slot, record.image);
+				if (record.result != IPX_ERR_OK)
+					continue;
+				// the copy of the unaligned image is written by the calling thread
+				if (!IsAligned(record.image))
+				{
+					record.result = Write(record.slot, record.image, staging);
+					continue;
+				}
+				Chunk chunks[3];
+				const size_t chunkCount = MakeChunks(record.slot, record.image, m_ring.GetPages(i), chunks);
+				uint64_t offset = record.slot.offset;
+				for (size_t k = 0; k < chunkCount; ++k)
+				{
+					Ring::Op op = { chunks[k].data, static_cast<uint32_t>(chunks[k].size), offset, i, 0 };
+					ops[opCount++] = op;
+					offset += chunks[k].size;
+				}
+			}
+			if (!opCount)
+				return;
+			if (!m_ring.Submit(opCount))
+			{
+				// the records of the failed submission are written entirely
+				for (size_t i = 0; i < opCount; ++i)
+				{
+					Record &record = records[ops[i].record];
+					if (!i || ops[i].record != ops[i - 1].record)
+						record.result = Write(record.slot, record.image, staging);
+				}
+				return;
+			}
+			// a regular file is written partially only if the disk is full
+			for (size_t i = 0; i < opCount; ++i)
+			{
+				if (ops[i].result == static_cast<int>(ops[i].size))
+					m_bytes += ops[i].size;
+				else
+					records[ops[i].record].result = Error(IPX_ERR_UNKNOWN);
+			}
+		}
+
+		Ring m_ring;
+		std::mutex m_ringMutex;
+
+#endif
+
+#endif
+
+		Params m_params;
+		bool m_open = false;
+		bool m_direct = false;
+		std::mutex m_mutex;
+		uint64_t m_end = 0;			// offset of the next record
+		uint64_t m_allocated = 0;	// end of the preallocated extents
+		std::atomic<uint64_t> m_bytes{0};
+		std::vector<IndexEntry> m_index;
+		std::vector<bool> m_failed;
+		Staging m_staging;			// the file header, the index and WriteImage
+	};
+
+	/**
+	\brief Reader of the sequence file mapped to the memory
+	\details The images returned by GetImage and CreateImageHeader point to the read-only mapping and are valid until
+	Close. The index of the closed file is used in place, the records of the file without the index (the recording was
+	interrupted) are found when the file is opened. The methods except Open and Close can be called by several threads.
+	*/
+	class Reader
+	{
+	public:
+		//! Expected access to the images, passed to the virtual memory of the system
+		enum Access
+		{
+			AccessNormal = 0,		/*!< The default readahead */
+			AccessSequential = 1,	/*!< Playback, the pages are read ahead aggressively and dropped after the use */
+			AccessRandom = 2		/*!< Scrubbing, the readahead is disabled, use Prefetch */
+		};
+
+		Reader() {}
+		~Reader() { Close(); }
+
+		Reader( const Reader& ) = delete;
+		Reader& operator=( const Reader& ) = delete;
+
+		//! Maps the file and finds the records
+		/*!
+		\param[in] fileName the file name
+		\return Returns the error code, IPX_ERR_NOT_SUPPORTED if it is not a sequence file
+		*/
+		IpxError Open( const char* fileName )
+		{
+			if (!fileName)
+				return Error(IPX_ERR_NULL_POINTER);
+			Close();
+			if (!MapFile(fileName))
+				return Error(IPX_ERR_FILE_NOTFOUND);
+			const IpxError err = ReadIndex();
+			if (err != IPX_ERR_OK)
+				Close();
+			return err;
+		}
+
+		//! Unmaps the file, the images returned by the reader are not valid after it
+		void Close()
+		{
+			UnmapFile();
+			m_entries = nullptr;
+			m_count = 0;
+			m_indexed = false;
+			std::vector<IndexEntry>().swap(m_scanned);
+		}
+
+		//! Returns true if the file is open
+		bool IsOpen() const { return m_data != nullptr; }
+
+		//! Returns true if the file has the index, false if the records were found by Open
+		bool IsIndexed() const { return m_indexed; }
+
+		//! Returns the number of the images
+		uint64_t GetFrameCount() const { return m_count; }
+
+		//! Returns the index entry of the image or nullptr if the frame is out of range
+		const IndexEntry* GetEntry( uint64_t frame ) const { return frame < m_count ? &m_entries[frame] : nullptr; }
+
+		//! Returns the header of the record of the image or nullptr if the frame is out of range or the record is damaged
+		const RecordHeader* GetRecord( uint64_t frame ) const
+		{
+			if (frame >= m_count)
+				return nullptr;
+			const uint64_t offset = m_entries[frame].offset;
+			if (offset % PageSize || offset > m_size || m_size - offset < PageSize)
+				return nullptr;
+			const RecordHeader *record = reinterpret_cast<const RecordHeader*>(m_data + offset);
+			if (record->magic != RecordMagic || m_size - offset - PageSize < record->imageSize)
+				return nullptr;
+			return record;
+		}
+
+		//! Fills the image header, the image data points to the mapping
+		/*!
+		\param[in] frame the number of the image
+		\param[out] image the header, the data must not be changed
+		\return Returns the error code
+		*/
+		IpxError GetImage( uint64_t frame, IpxImage* image ) const
+		{
+			if (!image)
+				return Error(IPX_ERR_NULL_POINTER);
+			if (frame >= m_count)
+				return Error(IPX_ERR_OUT_OF_RANGE);
+			const RecordHeader *record = GetRecord(frame);
+			if (!record)
+				return Error(IPX_ERR_UNKNOWN);
+			*image = IpxImage();
+			if (!IpxInitPixelTypeDescr(record->pixelType, &image->pixelTypeDescr))
+				return Error(IPX_ERR_NOT_SUPPORTED);
+			image->origin = record->origin;
+			image->width = record->width;
+			image->height = record->height;
+			image->rowSize = record->rowSize;
+			image->imageSize = record->imageSize;
+			image->timestamp = record->timestamp;
+			image->imageID = record->imageID;
+			image->imageData = const_cast<char*>(reinterpret_cast<const char*>(record) + PageSize);
+			return IPX_ERR_OK;
+		}
+
+		//! Creates the image header by IpxCreateImageHeader, the image data points to the mapping
+		/*!
+		\param[in] frame the number of the image
+		\param[out] image the header, released by IpxReleaseImageHeader
+		\return Returns the error code
+		*/
+		IpxError CreateImageHeader( uint64_t frame, IpxImage** image ) const
+		{
+			if (!image)
+				return Error(IPX_ERR_NULL_POINTER);
+			IpxImage view;
+			const IpxError err = GetImage(frame, &view);
+			if (err != IPX_ERR_OK)
+				return err;
+			IpxSize size;
+			size.width = view.width;
+			size.height = view.height;
+			const IpxError createErr = IpxCreateImageHeader(image, size, view.pixelTypeDescr.pixelType, view.imageData, view.rowSize, view.origin);
+			if (createErr != IPX_ERR_OK)
+				return createErr;
+			(*image)->imageSize = view.imageSize;
+			(*image)->timestamp = view.timestamp;
+			(*image)->imageID = view.imageID;
+			return IPX_ERR_OK;
+		}
+
+		//! Returns the last image with the timestamp not greater than the given one
+		/*!
+		The timestamps of the recording grow, the image is found by the binary search of the index.
+		\return Returns the frame number, 0 if all the images are later, GetFrameCount() if the file is empty
+		*/
+		uint64_t FindTimestamp( uint64_t timestamp ) const
+		{
+			if (!m_count)
+				return 0;
+			const IndexEntry *end = m_entries + m_count;
+			const IndexEntry *it = std::upper_bound(m_entries, end, timestamp,
+				[]( uint64_t t, const IndexEntry &e ) { return t < e.timestamp; });
+			return it == m_entries ? 0 : static_cast<uint64_t>(it - m_entries) - 1;
+		}
+
+		//! Sets the expected access to the images of the whole file
+		void SetAccess( Access access )
+		{
+#ifndef _WIN32
+			if (!m_data)
+				return;
+			const int advice = access == AccessSequential ? MADV_SEQUENTIAL : (access == AccessRandom ? MADV_RANDOM : MADV_NORMAL);
+			madvise(const_cast<uint8_t*>(m_data), static_cast<size_t>(m_size), advice);
+#else
+			(void)access;
+#endif
+		}
+
+		//! Starts reading the images in the background, so GetImage of them does not wait for the disk
+		/*!
+		\param[in] frame the first image
+		\param[in] count the number of the images
+		*/
+		void Prefetch( uint64_t frame, uint64_t count ) const
+		{
+			if (frame >= m_count || !count)
+				return;
+			const uint64_t last = std::min(m_count, frame + count) - 1;
+			const uint64_t begin = m_entries[frame].offset;
+			const RecordHeader *record = GetRecord(last);
+			const uint64_t end = record ? m_entries[last].offset + PageSize + record->imageSize : m_size;
+			if (begin >= end || end > m_size)
+				return;
+#ifndef _WIN32
+			madvise(const_cast<uint8_t*>(m_data + begin), static_cast<size_t>(end - begin), MADV_WILLNEED);
+#elif defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+			WIN32_MEMORY_RANGE_ENTRY range;
+			range.VirtualAddress = const_cast<uint8_t*>(m_data + begin);
+			range.NumberOfBytes = static_cast<SIZE_T>(end - begin);
+			PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#endif
+		}
+
+	private:
+		static IpxError Error( uint32_t code ) { return IPX_ERR(IPX_CMP_IMG_SERIALIZER, code); }
+
+		IpxError ReadIndex()
+		{
+			if (m_size < PageSize)
+				return Error(IPX_ERR_NOT_SUPPORTED);
+			const FileHeader *header = reinterpret_cast<const FileHeader*>(m_data);
+			if (memcmp(header->magic, FileMagic, sizeof(FileMagic)) != 0 || header->version > Version || header->pageSize != PageSize)
+				return Error(IPX_ERR_NOT_SUPPORTED);
+
+			try
+			{
+				if (header->indexOffset)
+				{
+					const uint64_t offset = header->indexOffset;
+					if (offset > m_size || m_size - offset < sizeof(IndexHeader))
+						return Error(IPX_ERR_UNKNOWN);
+					const IndexHeader *index = reinterpret_cast<const IndexHeader*>(m_data + offset);
+					if (index->magic != IndexMagic || index->entrySize < sizeof(IndexEntry)
+						|| index->count > (m_size - offset - sizeof(IndexHeader)) / index->entrySize)
+						return Error(IPX_ERR_UNKNOWN);
+					const uint8_t *first = m_data + offset + sizeof(IndexHeader);
+					m_count = index->count;
+					m_indexed = true;
+					// the entries of the later versions can be longer
+					if (index->entrySize == sizeof(IndexEntry))
+					{
+						m_entries = reinterpret_cast<const IndexEntry*>(first);
+						return IPX_ERR_OK;
+					}
+					m_scanned.resize(static_cast<size_t>(m_count));
+					for (uint64_t i = 0; i < m_count; ++i)
+						memcpy(&m_scanned[static_cast<size_t>(i)], first + i * index->entrySize, sizeof(IndexEntry));
+				}
+				else
+				{
+					// the records are followed until the first page which is not a complete record
+					for (uint64_t offset = PageSize; m_size - offset >= PageSize; )
+					{
+						const RecordHeader *record = reinterpret_cast<const RecordHeader*>(m_data + offset);
+						if (record->magic != RecordMagic || record->frameNumber != m_scanned.size()
+							|| record->recordSize != GetRecordSize(record->imageSize) || record->recordSize > m_size - offset)
+							break;
+						IndexEntry entry = { offset, record->imageID, record->timestamp };
+						m_scanned.push_back(entry);
+						offset += record->recordSize;
+					}
+					m_count = m_scanned.size();
+				}
+			}
+			catch (const std::bad_alloc&)
+			{
+				return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+			}
+			m_entries = m_scanned.data();
+			return IPX_ERR_OK;
+		}
+
+#ifdef _WIN32
+
+		bool MapFile( const char* fileName )
+		{
+			HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+				return false;
+			LARGE_INTEGER size;
+			HANDLE mapping = nullptr;
+			if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && static_cast<uint64_t>(size.QuadPart) <= SIZE_MAX)
+				mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			CloseHandle(file);
+			if (!mapping)
+				return false;
+			m_data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+			CloseHandle(mapping);
+			m_size = m_data ? static_cast<uint64_t>(size.QuadPart) : 0;
+			return m_data != nullptr;
+		}
+
+		void UnmapFile()
+		{
+			if (m_data)
+				UnmapViewOfFile(m_data);
+			m_data = nullptr;
+			m_size = 0;
+		}
+
+#else
+
+		bool MapFile( const char* fileName )
+		{
+			const int fd = open(fileName, O_RDONLY);
+			if (fd < 0)
+				return false;
+			struct stat st;
+			void *data = MAP_FAILED;
+			if (fstat(fd, &st) == 0 && st.st_size > 0 && static_cast<uint64_t>(st.st_size) <= SIZE_MAX)
+				data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+			// the mapping keeps the file open
+			close(fd);
+			if (data == MAP_FAILED)
+				return false;
+			m_data = static_cast<const uint8_t*>(data);
+			m_size = static_cast<uint64_t>(st.st_size);
+			return true;
+		}
+
+		void UnmapFile()
+		{
+			if (m_data)
+				munmap(const_cast<uint8_t*>(m_data), static_cast<size_t>(m_size));
+			m_data = nullptr;
+			m_size = 0;
+		}
+
+#endif
+
+		const uint8_t *m_data = nullptr;
+		uint64_t m_size = 0;
+		const IndexEntry *m_entries = nullptr;	// the index in the mapping or m_scanned
+		uint64_t m_count = 0;
+		bool m_indexed = false;
+		std::vector<IndexEntry> m_scanned;
+	};
+
+} // end of namespace IpxImageSequence
+
+#endif // __cplusplus
+
+#endif // _IPX_IMAGE_SEQUENCE_H_
@@ -102,6 +102,60 @@
 #define ISP_ADD_PALETTE             "add.palette"               /*!<Add palette to the header if image pixeltype is 8 bit grayscale (default 0)\n\n<b>Type/Range</b>   [int: 0, 1]\note Used by SetParamInt and GetParamInt*/
 /** @}*/
 
+/** \addtogroup ts_ser_async IpxSerializer Asynchronous Recording Parameters
+\brief Defines for the parameters of IpxImageSerializerAsync (IpxImageSerializerAsync.h)
+*  @{
+<table>
+        <caption id="serializer_async_params">IpxSerializer Asynchronous Recording Parameters</caption>
+		<tr><th>Macro<th>Parameter Name<th>Type<th>Description
+		<tr><td rowspan="1"><b>ISP_ASYNC_QUEUE_DEPTH</b><td>"async.queue.depth"<td>[int: 1,1024]<td>maximum number of the images waiting for the write (8 by default)
+		<tr><td rowspan="1"><b>ISP_ASYNC_QUEUE_POLICY</b><td>"async.queue.policy"<td>[int: 0,2]<td>what Save does when the queue is full: ISP_QUEUE_BLOCK, ISP_QUEUE_DROP_OLDEST, ISP_QUEUE_DROP_NEWEST
+		<tr><td rowspan="1"><b>ISP_ASYNC_IO_THREADS</b><td>"async.io.threads"<td>[int: 1,16]<td>number of the writing threads (1 by default)
+		<tr><td rowspan="1"><b>ISP_ASYNC_QUEUE_SIZE</b><td>"async.queue.size"<td>[int] read only<td>number of the images in the queue
+		<tr><td rowspan="1"><b>ISP_ASYNC_QUEUE_HIGH</b><td>"async.queue.high"<td>[int] read only<td>high-water mark of the queue
+		<tr><td rowspan="1"><b>ISP_ASYNC_WRITTEN</b><td>"async.frames.written"<td>[int] read only<td>number of the written images
+		<tr><td rowspan="1"><b>ISP_ASYNC_DROPPED</b><td>"async.frames.dropped"<td>[int] read only<td>number of the images dropped by the queue policy
+		<tr><td rowspan="1"><b>ISP_ASYNC_ERRORS</b><td>"async.write.errors"<td>[int] read only<td>number of the failed writes
+		<tr><td rowspan="1"><b>ISP_ASYNC_WRITE_LAST</b><td>"async.write.last.us"<td>[int] read only<td>duration of the last write, us
+		<tr><td rowspan="1"><b>ISP_ASYNC_WRITE_MAX</b><td>"async.write.max.us"<td>[int] read only<td>maximum duration of the write, us
+		<tr><td rowspan="1"><b>ISP_ASYNC_WRITE_AVG</b><td>"async.write.avg.us"<td>[int] read only<td>average duration of the write, us
+		<tr><td rowspan="1"><b>ISP_ASYNC_LATENCY_MAX</b><td>"async.latency.max.us"<td>[int] read only<td>maximum time from Save to the end of the write, us
+		<tr><td rowspan="1"><b>ISP_ASYNC_SERIES_FPS</b><td>"async.series.fps"<td>[int] read only<td>rate of the images of the file series, 1/100 fps
+		<tr><td rowspan="1"><b>ISP_ASYNC_RESET_STATS</b><td>"async.reset.stats"<td>[command]<td>resets the statistics of the queue and the writes
+		<tr><td rowspan="1"><b>ISP_SEQ_DIRECT_IO</b><td>"seq.direct.io"<td>[int: 0, 1]<td>the sequence file bypasses the page cache (1 by default)
+		<tr><td rowspan="1"><b>ISP_SEQ_PREALLOC_MB</b><td>"seq.prealloc.mb"<td>[int: 0,65536]<td>the sequence file is extended by this size at once, MB (1024 by default)
+		<tr><td rowspan="1"><b>ISP_SEQ_BYTES</b><td>"seq.bytes.written"<td>[int] read only<td>size of the records written to the sequence file
+		<tr><td rowspan="1"><b>ISP_SEQ_URING_DEPTH</b><td>"seq.uring.depth"<td>[int: 0,1024]<td>records of the sequence file submitted to io_uring at once, 0 - pwrite (32 by default)
+		<tr><td rowspan="1"><b>ISP_SEQ_URING_ACTIVE</b><td>"seq.uring.active"<td>[int] read only<td>1 if the sequence file is written by io_uring
+</table>*/
+
+#define ISP_ASYNC_QUEUE_DEPTH       "async.queue.depth"         /*!<Maximum number of the images waiting for the write (8 by default)\n\n<b>Type/Range</b>   [int: 1,1024]\note Used by SetParamInt and GetParamInt*/
+#define ISP_ASYNC_QUEUE_POLICY      "async.queue.policy"        /*!<What Save does when the queue is full (ISP_QUEUE_BLOCK by default)\n\n<b>Type/Range</b>   [int: 0,2]\note Used by SetParamInt and GetParamInt*/
+#define ISP_ASYNC_IO_THREADS        "async.io.threads"          /*!<Number of the writing threads (1 by default)\n\n<b>Type/Range</b>   [int: 1,16]\note Used by SetParamInt and GetParamInt*/
+#define ISP_ASYNC_QUEUE_SIZE        "async.queue.size"          /*!<Number of the images in the queue\n\n<b>Type</b>   [int] read only\note Used by GetParamInt*/
+#define ISP_ASYNC_QUEUE_HIGH        "async.queue.high"          /*!<High-water mark of the queue since the start or ISP_ASYNC_RESET_STATS\n\n<b>Type</b>   [int] read only\note Used by GetParamInt*/
+#define ISP_ASYNC_WRITTEN           "async.frames.written"      /*!<Number of the written images\n\n<b>Type</b>   [int] read only\note Used by GetParamInt*/
+#define ISP_ASYNC_DROPPED           "async.frames.dropped"      /*!<Number of the images dropped by the queue policy\n\n<b>Type</b>   [int] read only\note Used by GetParamInt*/
+#define ISP_ASYNC_ERRORS            "async.write.errors"        /*!<Number of the failed writes\n\n<b>Type</b>   [int] read only\note Used by GetParamInt*/
+#define ISP_ASYNC_WRITE_LAST        "async.write.last.us"       /*!<Duration of the last write in microseconds\n\n<b>Type</b>   [int] read only\note Used by GetParamInt*/
+#define ISP_ASYNC_WRITE_MAX         "async.write.max.us"        /*!<Maximum duration of the write in microseconds\n\n<b>Type</b>   [int] read only\note Used by GetParamInt*/
+#define ISP_ASYNC_WRITE_AVG         "async.write.avg.us"        /*!<Average duration of the write in microseconds\n\n<b>Type</b>   [int] read only\note Used by GetParamInt*/
+#define ISP_ASYNC_LATENCY_MAX       "async.latency.max.us"      /*!<Maximum time from Save to the end of the write in microseconds\n\n<b>Type</b>   [int] read only\note Used by GetParamInt*/
+#define ISP_ASYNC_SERIES_FPS        "async.series.fps"          /*!<Rate of the images written by the file series of StartFileSeriesRecord since its start or ISP_ASYNC_RESET_STATS, in 1/100 frames per second\n\n<b>Type</b>   [int] read only\note Used by GetParamInt*/
+#define ISP_ASYNC_RESET_STATS       "async.reset.stats"         /*!<Resets the statistics of the queue and the writes\note Used by RunCommand*/
+#define ISP_SEQ_DIRECT_IO           "seq.direct.io"             /*!<The sequence file of StartSequenceRecord bypasses the page cache (1 by default)\n\n<b>Type/Range</b>   [int: 0, 1]\note Used by SetParamInt and GetParamInt*/
+#define ISP_SEQ_PREALLOC_MB         "seq.prealloc.mb"           /*!<The sequence file is extended by this size at once, MB (1024 by default, 0 - by every image)\n\n<b>Type/Range</b>   [int: 0,65536]\note Used by SetParamInt and GetParamInt*/
+#define ISP_SEQ_BYTES               "seq.bytes.written"         /*!<Size of the records written to the sequence file since StartSequenceRecord\n\n<b>Type</b>   [int] read only\note Used by GetParamInt*/
+#define ISP_SEQ_URING_DEPTH         "seq.uring.depth"           /*!<Maximum number of the records of the sequence file submitted to io_uring by one system call, 0 - the records are written by pwrite of the I/O threads (32 by default, Linux)\n\n<b>Type/Range</b>   [int: 0,1024]\note Used by SetParamInt and GetParamInt*/
+#define ISP_SEQ_URING_ACTIVE        "seq.uring.active"          /*!<1 if the sequence file of StartSequenceRecord is written by io_uring\n\n<b>Type</b>   [int] read only\note Used by GetParamInt*/
+
+#define ISP_QUEUE_BLOCK             0                           /*!<Save waits for the free place in the queue*/
+#define ISP_QUEUE_DROP_OLDEST       1                           /*!<The oldest image waiting in the queue is dropped*/
+#define ISP_QUEUE_DROP_NEWEST       2                           /*!<The saved image is dropped, Save returns ISP_WRN_DROPPED*/
+
+#define ISP_WRN_DROPPED             IPX_WRN(IPX_CMP_IMG_SERIALIZER, IPX_ERR_BUFFER_TOO_SMALL)  /*!<The image was not queued since the queue is full*/
+/** @}*/
+
 
 #ifdef __cplusplus
 
@@ -0,0 +1,927 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Imaging API SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxImageSerializerAsync.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Header-only IpxImageSerializer writing the images on the background threads
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _IPX_IMAGE_SERIALIZER_ASYNC_H_
+#define _IPX_IMAGE_SERIALIZER_ASYNC_H_
+
+#include "IpxImageSerializer.h"
+#include "IpxToolsImpl.h"
+#include "IpxFrame.h"
+#include "IpxImageSequence.h"
+
+#ifdef __cplusplus
+
+#include <cstdio>
+#include <cstring>
+#include <cctype>
+#include <climits>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <new>
+
+/*!
+\brief IpxImageSerializer writing the images on its own threads
+\details Save and SaveFrame put the image to the queue and return, the images are written by the ISP_ASYNC_IO_THREADS
+threads, so a slow disk does not stall the acquisition thread. SaveFrame keeps the stream buffer of the frame out of the
+input pool until the image is written, Save copies the image to the memory reused by the next images.
+
+When the queue holds ISP_ASYNC_QUEUE_DEPTH images, ISP_ASYNC_QUEUE_POLICY selects whether Save waits, drops the oldest
+queued image or drops the saved one. The frames held by the queue are not available to the camera, so with SaveFrame the
+stream needs ISP_ASYNC_QUEUE_DEPTH buffers more than it uses without recording.
+
+The images with the file name are written as the standalone files by the serializers of the threads, in any order; the
+file name with the ".raw" extension writes the image data as is. The images without the file name go to the recording
+session of StartSeriesRecord or StartMovieRecord, they are written in the order of Save by one serializer, or to the raw
+sequence file of StartSequenceRecord (IpxImageSequence), whose records are written by all the threads at once in the
+places reserved in the order of Save. On Linux the records of the sequence queued together are submitted to io_uring by
+one system call (ISP_SEQ_URING_DEPTH), and the stream buffers given to RegisterBuffers are written by SaveFrame without
+mapping their pages for every write. StartFileSeriesRecord names the session images by their numbers and writes them as
+the standalone files, so the JPEG series is encoded by all the threads at once. The write errors are counted by
+ISP_ASYNC_ERRORS and returned by GetWriteError and FinishRecord. The other parameters are passed to all the serializers
+after the queued images are written.
+\code
+IpxImageSerializerAsync *serializer = IpxImageSerializerAsync::CreateComponent(false);
+serializer->GetComponent()->SetParamInt(ISP_ASYNC_QUEUE_DEPTH, 16);
+serializer->GetComponent()->SetParamInt(ISP_ASYNC_QUEUE_POLICY, ISP_QUEUE_DROP_OLDEST);
+
+IpxCamFrame::FrameQueue frames(stream);
+while (recording)
+{
+	IpxCamFrame::Frame frame = frames.GetFrame(1000);
+	if (frame)
+		serializer->SaveFrame(frame, fileName);		// the buffer is requeued after the write
+}
+serializer->WaitWritten(UINT64_MAX);
+
+int64_t high = 0, dropped = 0;
+serializer->GetComponent()->GetParamInt(ISP_ASYNC_QUEUE_HIGH, &high);
+serializer->GetComponent()->GetParamInt(ISP_ASYNC_DROPPED, &dropped);
+IpxImageSerializerAsync::DeleteComponent(serializer);
+\endcode
+*/
+class IpxImageSerializerAsync final : public IpxImageSerializer
+{
+public:
+
+	//! Creates the component
+	/*!
+	\param[in] enableMovies flag to enable Movies of the recording session
+	*/
+	static IpxImageSerializerAsync* CreateComponent( bool enableMovies = true ) { return new IpxImageSerializerAsync(enableMovies); }
+
+	//! Deletes the component, the queued images are written first
+	static void DeleteComponent( IpxImageSerializerAsync* in ) { delete in; }
+
+	explicit IpxImageSerializerAsync( bool enableMovies = true )
+		: m_component(*this), m_serializer(IpxImageSerializer::CreateComponent(enableMovies))
+	{
+	}
+
+	virtual ~IpxImageSerializerAsync()
+	{
+		StopThreads();
+		if (m_serializer)
+			IpxImageSerializer::DeleteComponent(m_serializer);
+	}
+
+	IpxComponent* GetComponent() override { return &m_component; }
+
+	//! Starts the recording session after the queued images are written
+	IpxError StartSeriesRecord( IpxImage* pSrc, const char* format ) override
+	{
+		if (!m_serializer)
+			return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+		WaitWritten(UINT64_MAX);
+		std::lock_guard<std::mutex> lock(m_sessionMutex);
+		return m_serializer->StartSeriesRecord(pSrc, format);
+	}
+
+	//! Starts the recording session after the queued images are written
+	IpxError StartMovieRecord( IpxImage* pSrc, const char* fileName, double fps ) override
+	{
+		if (!m_serializer)
+			return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+		WaitWritten(UINT64_MAX);
+		std::lock_guard<std::mutex> lock(m_sessionMutex);
+		return m_serializer->StartMovieRecord(pSrc, fileName, fps);
+	}
+
+	//! Starts the recording session to the raw sequence file after the queued images are written
+	/*!
+	The images saved without the file name are written to the file with their metadata until FinishRecord, which writes
+	the index of the file. The file is written with ISP_SEQ_DIRECT_IO, ISP_SEQ_PREALLOC_MB and ISP_SEQ_URING_DEPTH.
+	\param[in] fileName the file name, the existing file is overwritten
+	\return Returns the error code
+	*/
+	IpxError StartSequenceRecord( const char* fileName )
+	{
+		WaitWritten(UINT64_MAX);
+		IpxImageSequence::Writer::Params params;
+		params.directIo = m_component.GetDirectIo();
+		params.preallocBytes = m_component.GetPreallocBytes();
+		params.ringDepth = m_component.GetUringDepth();
+		try
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			params.buffers = m_buffers;
+		}
+		catch (const std::bad_alloc&)
+		{
+			return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+		}
+		const IpxError err = m_sequence.Open(fileName, params);
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_sequenceOn = err == IPX_ERR_OK;
+		return err;
+	}
+
+	//! Starts the recording session to the numbered image files after the queued images are written
+	/*!
+	The images saved without the file name are written as the standalone files until FinishRecord, so the series is
+	encoded by the ISP_ASYNC_IO_THREADS serializers at once, each of them keeps its encoder and ISP_JPEG_QUALITY for all
+	the images. The files are numbered from 0 in the order of Save: the last run of '#' in the pattern is replaced by the
+	number padded with zeros to the length of the run. The rate of the series is reported by ISP_ASYNC_SERIES_FPS.
+	\param[in] pattern the file name pattern, for example "/data/frame_######.jpg"
+	\return Returns the error code
+	*/
+	IpxError StartFileSeriesRecord( const char* pattern )
+	{
+		if (!pattern)
+			return Error(IPX_ERR_NULL_POINTER);
+		const char *last = strrchr(pattern, '#');
+		if (!last)
+			return Error(IPX_ERR_INVALID_ARGUMENT);
+		const char *first = last;
+		while (first > pattern && first[-1] == '#')
+			--first;
+		WaitWritten(UINT64_MAX);
+		std::lock_guard<std::mutex> lock(m_mutex);
+		try
+		{
+			m_seriesPrefix.assign(pattern, first);
+			m_seriesSuffix.assign(last + 1);
+		}
+		catch (const std::bad_alloc&)
+		{
+			return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+		}
+		m_seriesDigits = std::min<size_t>(static_cast<size_t>(last - first) + 1, 20);
+		m_seriesNext = 0;
+		m_seriesOn = true;
+		m_stats.seriesFrames = 0;
+		m_stats.seriesStarted = false;
+		return IPX_ERR_OK;
+	}
+
+	//! Registers the stream buffers with io_uring of the next StartSequenceRecord
+	/*!
+	The images of the registered buffers passed to SaveFrame are written without mapping their pages for every write.
+	The buffers are released by FinishRecord and must not be revoked before it.
+	\param[in] buffers the buffers created by Stream::CreateBuffer or Stream::SetBuffer
+	\return Returns the error code
+	*/
+	IpxError RegisterBuffers( const std::vector<IpxCam::Buffer*> &buffers )
+	{
+		std::vector<IpxImageSequence::Region> regions;
+		try
+		{
+			for (IpxCam::Buffer *buffer : buffers)
+			{
+				if (!buffer)
+					return Error(IPX_ERR_NULL_POINTER);
+				IpxImageSequence::Region region = { buffer->GetBufferPtr(), buffer->GetBufferSize() };
+				regions.push_back(region);
+			}
+		}
+		catch (const std::bad_alloc&)
+		{
+			return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+		}
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_buffers.swap(regions);
+		return IPX_ERR_OK;
+	}
+
+	//! Writes the queued images and ends the recording session
+	/*!
+	\return Returns the first error of the writes since the last GetWriteError, or the error of the session
+	*/
+	IpxError FinishRecord() override
+	{
+		bool series;
+		{
+			// the images saved from now on go to the session serializer, the sequence is closed after the images
+			// queued for it are written
+			std::unique_lock<std::mutex> lock(m_mutex);
+			series = m_seriesOn;
+			m_seriesOn = false;
+			m_sequenceOn = false;
+			m_idleCv.wait(lock, [this]{ return m_recordsPending == 0; });
+			m_buffers.clear();
+		}
+		WaitWritten(UINT64_MAX);
+		IpxError err = IPX_ERR_OK;
+		if (m_sequence.IsOpen())
+			err = m_sequence.Close();
+		else if (!series)
+		{
+			if (!m_serializer)
+				return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+			std::lock_guard<std::mutex> lock(m_sessionMutex);
+			err = m_serializer->FinishRecord();
+		}
+		const IpxError writeErr = GetWriteError();
+		return writeErr != IPX_ERR_OK ? writeErr : err;
+	}
+
+	//! Copies the image to the queue
+	/*!
+	\param[in] image the image, it can be changed or released after the call
+	\param[in] fileName the file name of the standalone image, nullptr - the image of the recording session
+	\return Returns IPX_ERR_OK if the image was queued, ISP_WRN_DROPPED if it was dropped by ISP_QUEUE_DROP_NEWEST
+	*/
+	IpxError Save( IpxImage* image, const char* fileName = 0 ) override
+	{
+		if (!image || !image->imageData)
+			return Error(IPX_ERR_NULL_POINTER);
+		Item item;
+		try
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (!m_spare.empty())
+				{
+					item.storage.swap(m_spare.back());
+					m_spare.pop_back();
+				}
+			}
+			const size_t words = (static_cast<size_t>(image->imageSize) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+			if (item.storage.size() < words)
+				item.storage.resize(words);
+			if (fileName)
+				item.fileName = fileName;
+		}
+		catch (const std::bad_alloc&)
+		{
+			return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+		}
+		memcpy(item.storage.data(), image->imageData, image->imageSize);
+		item.image = *image;
+		item.image.imageData = reinterpret_cast<char*>(item.storage.data());
+		item.image.imageDataOrigin = nullptr;
+		item.image.userData = nullptr;
+		return Enqueue(item);
+	}
+
+	//! Puts the image of the frame to the queue without a copy, the frame is released after the write
+	/*!
+	\param[in] frame the frame
+	\param[in] fileName the file name of the standalone image, nullptr - the image of the recording session
+	\return Returns IPX_ERR_OK if the image was queued, ISP_WRN_DROPPED if it was dropped by ISP_QUEUE_DROP_NEWEST
+	*/
+	IpxError SaveFrame( const IpxCamFrame::Frame &frame, const char* fileName = nullptr )
+	{
+		if (!frame || !frame.GetImage())
+			return Error(IPX_ERR_NULL_POINTER);
+		Item item;
+		try
+		{
+			if (fileName)
+				item.fileName = fileName;
+		}
+		catch (const std::bad_alloc&)
+		{
+			return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+		}
+		item.frame = frame;
+		item.image = *frame.GetImage();
+		return Enqueue(item);
+	}
+
+	IpxError Load( IpxImage* image, const char* fileName ) override
+	{
+		if (!m_serializer)
+			return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+		std::lock_guard<std::mutex> lock(m_sessionMutex);
+		return m_serializer->Load(image, fileName);
+	}
+
+	IpxError GetImageHeader( IpxImage* image, const char* fileName ) override
+	{
+		if (!m_serializer)
+			return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+		std::lock_guard<std::mutex> lock(m_sessionMutex);
+		return m_serializer->GetImageHeader(image, fileName);
+	}
+
+	IpxError Free( IpxImage* image ) override
+	{
+		if (!m_serializer)
+			return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+		std::lock_guard<std::mutex> lock(m_sessionMutex);
+		return m_serializer->Free(image);
+	}
+
+	//! Waits until all the queued images are written
+	/*!
+	\param[in] iTimeout timeout in milliseconds, UINT64_MAX - infinite
+	\return Returns false on timeout
+	*/
+	bool WaitWritten( uint64_t iTimeout )
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		auto written = [this]{ return m_queue.empty() && m_busy == 0; };
+		if (iTimeout == UINT64_MAX)
+		{
+			m_idleCv.wait(lock, written);
+			return true;
+		}
+		return m_idleCv.wait_for(lock, std::chrono::milliseconds(iTimeout), written);
+	}
+
+	//! Returns the first error of the writes since the last call and clears it
+	IpxError GetWriteError()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const IpxError err = m_writeError;
+		m_writeError = IPX_ERR_OK;
+		return err;
+	}
+
+private:
+	struct Item
+	{
+		IpxCamFrame::Frame frame;			// the pinned stream buffer, empty for the copied image
+		IpxImage image;
+		std::vector<uint64_t> storage;		// the copy of the image data
+		std::string fileName;
+		bool sequence = false;				// the image of StartSequenceRecord, set by Enqueue
+		bool series = false;				// the image of StartFileSeriesRecord, set by Enqueue and named by NameSeries
+		std::chrono::steady_clock::time_point queued;
+	};
+
+	// the statistics of the queue and the writes, protected by m_mutex
+	struct Stats
+	{
+		int64_t queueHigh = 0;
+		int64_t written = 0;
+		int64_t dropped = 0;
+		int64_t errors = 0;
+		int64_t writeLast = 0;
+		int64_t writeMax = 0;
+		int64_t writeSum = 0;
+		int64_t latencyMax = 0;
+		int64_t seriesFrames = 0;
+		bool seriesStarted = false;
+		std::chrono::steady_clock::time_point seriesStart;
+		std::chrono::steady_clock::time_point seriesLast;
+	};
+
+	// the own parameters and the statistics, the other parameters are passed to all the serializers
+	class Component : public IpxToolsImpl::ForwardingComponent
+	{
+	public:
+		explicit Component( IpxImageSerializerAsync &owner ) : IpxToolsImpl::ForwardingComponent(IPX_CMP_IMG_SERIALIZER), m_owner(owner)
+		{
+			m_depth = AddParamInt(ISP_ASYNC_QUEUE_DEPTH, 8, 1, 1024);
+			m_policy = AddParamInt(ISP_ASYNC_QUEUE_POLICY, ISP_QUEUE_BLOCK, ISP_QUEUE_BLOCK, ISP_QUEUE_DROP_NEWEST);
+			m_threads = AddParamInt(ISP_ASYNC_IO_THREADS, 1, 1, 16);
+			m_queueSize = AddParamInt(ISP_ASYNC_QUEUE_SIZE, 0, 0, INT64_MAX, true);
+			m_queueHigh = AddParamInt(ISP_ASYNC_QUEUE_HIGH, 0, 0, INT64_MAX, true);
+			m_written = AddParamInt(ISP_ASYNC_WRITTEN, 0, 0, INT64_MAX, true);
+			m_dropped = AddParamInt(ISP_ASYNC_DROPPED, 0, 0, INT64_MAX, true);
+			m_errors = AddParamInt(ISP_ASYNC_ERRORS, 0, 0, INT64_MAX, true);
+			m_writeLast = AddParamInt(ISP_ASYNC_WRITE_LAST, 0, 0, INT64_MAX, true);
+			m_writeMax = AddParamInt(ISP_ASYNC_WRITE_MAX, 0, 0, INT64_MAX, true);
+			m_writeAvg = AddParamInt(ISP_ASYNC_WRITE_AVG, 0, 0, INT64_MAX, true);
+			m_latencyMax = AddParamInt(ISP_ASYNC_LATENCY_MAX, 0, 0, INT64_MAX, true);
+			m_seriesFps = AddParamInt(ISP_ASYNC_SERIES_FPS, 0, 0, INT64_MAX, true);
+			m_directIo = AddParamInt(ISP_SEQ_DIRECT_IO, 1, 0, 1);
+			m_preallocMb = AddParamInt(ISP_SEQ_PREALLOC_MB, 1024, 0, 65536);
+			m_seqBytes = AddParamInt(ISP_SEQ_BYTES, 0, 0, INT64_MAX, true);
+			m_uringDepth = AddParamInt(ISP_SEQ_URING_DEPTH, 32, 0, 1024);
+			m_uringActive = AddParamInt(ISP_SEQ_URING_ACTIVE, 0, 0, 1, true);
+		}
+
+		size_t GetDepth() const { return static_cast<size_t>(GetInt(m_depth)); }
+		int GetPolicy() const { return static_cast<int>(GetInt(m_policy)); }
+		size_t GetThreads() const { return static_cast<size_t>(GetInt(m_threads)); }
+		bool GetDirectIo() const { return GetInt(m_directIo) != 0; }
+		uint64_t GetPreallocBytes() const { return static_cast<uint64_t>(GetInt(m_preallocMb)) << 20; }
+		uint32_t GetUringDepth() const { return static_cast<uint32_t>(GetInt(m_uringDepth)); }
+
+		IpxError RunCommand( const char* name ) override
+		{
+			if (name && strcmp(name, ISP_ASYNC_RESET_STATS) == 0)
+			{
+				m_owner.ResetStats();
+				return IPX_ERR_OK;
+			}
+			return ForwardingComponent::RunCommand(name);
+		}
+
+	protected:
+		IpxError OnSetParamInt( size_t index, int64_t ) override
+		{
+			// the threads are started again by the next image
+			if (index == m_threads)
+				m_owner.StopThreads();
+			return IPX_ERR_OK;
+		}
+
+		int64_t OnGetParamInt( size_t index, int64_t value ) override
+		{
+			std::lock_guard<std::mutex> lock(m_owner.m_mutex);
+			const Stats &s = m_owner.m_stats;
+			if (index == m_queueSize)
+				return static_cast<int64_t>(m_owner.m_queue.size());
+			if (index == m_queueHigh)
+				return s.queueHigh;
+			if (index == m_written)
+				return s.written;
+			if (index == m_dropped)
+				return s.dropped;
+			if (index == m_errors)
+				return s.errors;
+			if (index == m_writeLast)
+				return s.writeLast;
+			if (index == m_writeMax)
+				return s.writeMax;
+			if (index == m_writeAvg)
+				return s.written + s.errors ? s.writeSum / (s.written + s.errors) : 0;
+			if (index == m_latencyMax)
+				return s.latencyMax;
+			if (index == m_seriesFps)
+			{
+				const int64_t us = Elapsed(s.seriesStart, s.seriesLast);
+				return s.seriesFrames && us > 0 ? s.seriesFrames * 100000000 / us : 0;
+			}
+			if (index == m_seqBytes)
+				return static_cast<int64_t>(m_owner.m_sequence.GetBytesWritten());
+			if (index == m_uringActive)
+				return m_owner.m_sequenceOn && m_owner.m_sequence.IsRing() ? 1 : 0;
+			return value;
+		}
+
+		IpxComponent* GetTarget() override { return m_owner.m_serializer ? m_owner.m_serializer->GetComponent() : nullptr; }
+
+		IpxError ForEachOther( const std::function<IpxError( IpxComponent* )> &fn ) override
+		{
+			for (IpxImageSerializer *s : m_owner.m_writers)
+			{
+				const IpxError err = fn(s->GetComponent());
+				if (err != IPX_ERR_OK)
+					return err;
+			}
+			return IPX_ERR_OK;
+		}
+
+		// the serializers are not used by the threads while the value is set, Save waits for it
+		void OnForward() override { m_owner.PauseThreads(); }
+		void OnForwarded() override { m_owner.ResumeThreads(); }
+
+	private:
+		IpxImageSerializerAsync &m_owner;
+		size_t m_depth, m_policy, m_threads;
+		size_t m_queueSize, m_queueHigh, m_written, m_dropped, m_errors;
+		size_t m_writeLast, m_writeMax, m_writeAvg, m_latencyMax, m_seriesFps;
+		size_t m_directIo, m_preallocMb, m_seqBytes, m_uringDepth, m_uringActive;
+	};
+
+	static IpxError Error( uint32_t code ) { return IPX_ERR(IPX_CMP_IMG_SERIALIZER, code); }
+
+	static int64_t Elapsed( std::chrono::steady_clock::time_point t0, std::chrono::steady_clock::time_point t1 )
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+	}
+
+	static bool IsRaw( const std::string &fileName )
+	{
+		static const char ext[] = ".raw";
+		const size_t n = sizeof(ext) - 1;
+		if (fileName.size() < n)
+			return false;
+		for (size_t i = 0; i < n; ++i)
+		{
+			if (tolower(static_cast<unsigned char>(fileName[fileName.size() - n + i])) != ext[i])
+				return false;
+		}
+		return true;
+	}
+
+	static IpxError WriteRaw( const IpxImage &image, const std::string &fileName )
+	{
+		FILE *fp = fopen(fileName.c_str(), "wb");
+		if (!fp)
+			return Error(IPX_ERR_ACCESS_DENIED);
+		const bool ok = fwrite(image.imageData, 1, image.imageSize, fp) == image.imageSize;
+		return (fclose(fp) == 0 && ok) ? IPX_ERR_OK : Error(IPX_ERR_UNKNOWN);
+	}
+
+	// writes the standalone image by the serializer of the thread
+	static IpxError WriteFile( IpxImageSerializer *serializer, Item &item )
+	{
+		if (IsRaw(item.fileName))
+			return WriteRaw(item.image, item.fileName);
+		return serializer->Save(&item.image, item.fileName.c_str());
+	}
+
+	// names the image of the file series by the next number, called with m_mutex locked
+	IpxError NameSeries( Item &item )
+	{
+		char number[24];
+		snprintf(number, sizeof(number), "%0*llu", static_cast<int>(m_seriesDigits), static_cast<unsigned long long>(m_seriesNext++));
+		try
+		{
+			item.fileName = m_seriesPrefix + number + m_seriesSuffix;
+		}
+		catch (const std::bad_alloc&)
+		{
+			return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+		}
+		if (!m_stats.seriesStarted)
+		{
+			m_stats.seriesStarted = true;
+			m_stats.seriesStart = std::chrono::steady_clock::now();
+		}
+		return IPX_ERR_OK;
+	}
+
+	// starts the threads and their serializers, called with m_mutex locked
+	IpxError StartThreads()
+	{
+		if (!m_threads.empty())
+			return IPX_ERR_OK;
+		if (!m_serializer)
+			return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+		const size_t threads = m_component.GetThreads();
+		try
+		{
+			while (m_writers.size() < threads)
+			{
+				IpxImageSerializer *s = IpxImageSerializer::CreateComponent(false);
+				if (!s)
+					break;
+				m_writers.push_back(s);
+				if (m_component.ApplyLog(s->GetComponent()) != IPX_ERR_OK)
+					break;
+			}
+			if (m_writers.size() == threads)
+			{
+				for (size_t i = 0; i < threads; ++i)
+					m_threads.push_back(std::thread(&IpxImageSerializerAsync::Run, this, m_writers[i]));
+				return IPX_ERR_OK;
+			}
+		}
+		catch (const std::bad_alloc&)
+		{
+		}
+		catch (const std::system_error&)
+		{
+		}
+
+		// the started threads have no images yet
+		m_stop = true;
+		m_stopping = true;
+		m_cv.notify_all();
+		m_mutex.unlock();
+		for (auto &t : m_threads)
+			t.join();
+		m_mutex.lock();
+		m_threads.clear();
+		m_stop = false;
+		DeleteWriters();
+		m_stopping = false;
+		m_spaceCv.notify_all();
+		return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+	}
+
+	// writes the queued images and stops the threads
+	void StopThreads()
+	{
+		PauseThreads();
+		ResumeThreads();
+	}
+
+	// writes the queued images, stops the threads and deletes their serializers, Save waits for ResumeThreads
+	void PauseThreads()
+	{
+		std::vector<std::thread> threads;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_spaceCv.wait(lock, [this]{ return !m_stopping; });
+			m_stopping = true;
+			m_stop = true;
+			threads.swap(m_threads);
+		}
+		m_cv.notify_all();
+		for (auto &t : threads)
+			t.join();
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = false;
+		DeleteWriters();
+	}
+
+	void ResumeThreads()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = false;
+		}
+		m_spaceCv.notify_all();
+	}
+
+	void DeleteWriters()
+	{
+		for (IpxImageSerializer *s : m_writers)
+			IpxImageSerializer::DeleteComponent(s);
+		m_writers.clear();
+	}
+
+	IpxError Enqueue( Item &item )
+	{
+		Item dropped;
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (m_stopping || m_queue.size() >= m_component.GetDepth())
+		{
+			// Save waits for the stopped threads also when the images are dropped
+			const int policy = m_stopping ? ISP_QUEUE_BLOCK : m_component.GetPolicy();
+			if (policy == ISP_QUEUE_DROP_NEWEST)
+			{
+				++m_stats.dropped;
+				Recycle(item);
+				return ISP_WRN_DROPPED;
+			}
+			if (policy == ISP_QUEUE_DROP_OLDEST)
+			{
+				// the frame is released after the mutex
+				dropped = std::move(m_queue.front());
+				m_queue.pop_front();
+				++m_stats.dropped;
+				EndRecord(dropped);
+				Recycle(dropped);
+				continue;
+			}
+			m_spaceCv.wait(lock);
+		}
+
+		// the threads stopped while Save waited have written the queue
+		const IpxError err = StartThreads();
+		if (err != IPX_ERR_OK)
+			return err;
+		// the session image goes to the recording started before Save, FinishRecord waits for it
+		item.sequence = item.fileName.empty() && m_sequenceOn;
+		item.series = item.fileName.empty() && !m_sequenceOn && m_seriesOn;
+		try
+		{
+			item.queued = std::chrono::steady_clock::now();
+			m_queue.push_back(std::move(item));
+		}
+		catch (const std::bad_alloc&)
+		{
+			return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+		}
+		if (m_queue.back().sequence || m_queue.back().series)
+			++m_recordsPending;
+		m_stats.queueHigh = std::max(m_stats.queueHigh, static_cast<int64_t>(m_queue.size()));
+		m_cv.notify_one();
+		return IPX_ERR_OK;
+	}
+
+	// counts the image of the sequence or the file series written or dropped, called with m_mutex locked
+	void EndRecord( const Item &item )
+	{
+		if ((item.sequence || item.series) && --m_recordsPending == 0)
+			m_idleCv.notify_all();
+	}
+
+	// keeps the copy memory for the next images, called with m_mutex locked
+	void Recycle( Item &item )
+	{
+		if (item.storage.empty() || m_spare.size() >= m_component.GetDepth())
+			return;
+		try
+		{
+			m_spare.push_back(std::vector<uint64_t>());
+			m_spare.back().swap(item.storage);
+		}
+		catch (const std::bad_alloc&)
+		{
+		}
+	}
+
+	// takes the sequence images following the first one to write them by one submission, called with m_mutex locked
+	void TakeBatch( std::vector<Item> &batch, std::vector<IpxImageSequence::Writer::Record> &records )
+	{
+		const size_t limit = m_sequence.GetBatchSize();
+		try
+		{
+			records.reserve(limit);
+			batch.reserve(limit - 1);
+		}
+		catch (const std::bad_alloc&)
+		{
+			return;
+		}
+		while (batch.size() + 1 < limit && !m_queue.empty() && m_queue.front().sequence)
+		{
+			batch.push_back(std::move(m_queue.front()));
+			m_queue.pop_front();
+		}
+	}
+
+	// reserves the record of the image taken by TakeBatch, called with m_mutex locked
+	IpxImageSequence::Writer::Record Reserve( const Item &item )
+	{
+		IpxImageSequence::Writer::Record record;
+		record.slot.frameNumber = UINT64_MAX;	// Commit ignores the record if it is not reserved
+		record.image = &item.image;
+		record.result = m_sequence.Reserve(&item.image, &record.slot);
+		return record;
+	}
+
+	// updates the statistics by the written image, called with m_mutex locked
+	void Finish( Item &item, IpxError err, std::chrono::steady_clock::time_point t0, std::chrono::steady_clock::time_point t1 )
+	{
+		const int64_t us = Elapsed(t0, t1);
+		m_stats.writeLast = us;
+		m_stats.writeMax = std::max(m_stats.writeMax, us);
+		m_stats.writeSum += us;
+		m_stats.latencyMax = std::max(m_stats.latencyMax, Elapsed(item.queued, t1));
+		if (err == IPX_ERR_OK)
+		{
+			++m_stats.written;
+			if (item.series)
+			{
+				++m_stats.seriesFrames;
+				m_stats.seriesLast = t1;
+			}
+		}
+		else
+		{
+			++m_stats.errors;
+			if (m_writeError == IPX_ERR_OK)
+				m_writeError = err;
+		}
+		Recycle(item);
+	}
+
+	// the thread of the serializer, exits when stopped and the queue is empty
+	void Run( IpxImageSerializer *serializer )
+	{
+		IpxImageSequence::Staging staging;
+		std::vector<Item> batch;		// the sequence images written with the first one by io_uring
+		std::vector<IpxImageSequence::Writer::Record> records;
+		std::unique_lock<std::mutex> lock(m_mutex);
+		for (;;)
+		{
+			m_cv.wait(lock, [this]{ return m_stop || !m_queue.empty(); });
+			if (m_queue.empty())
+				return;
+			Item item = std::move(m_queue.front());
+			m_queue.pop_front();
+			// the session images are written in the order they are taken from the queue, the records of the sequence
+			// are placed in this order
+			const bool sequence = item.sequence;
+			if (sequence && m_sequence.IsRing())
+				TakeBatch(batch, records);
+			const size_t count = 1 + batch.size();
+			m_busy += count;
+			IpxImageSequence::Writer::Slot slot;
+			IpxError err = IPX_ERR_OK;
+			if (!batch.empty())
+			{
+				records.push_back(Reserve(item));
+				for (const Item &next : batch)
+					records.push_back(Reserve(next));
+			}
+			else if (sequence)
+				err = m_sequence.Reserve(&item.image, &slot);
+			// the images of the file series are numbered in this order and written by all the threads
+			else if (item.series)
+				err = NameSeries(item);
+			const uint64_t ticket = item.fileName.empty() && !sequence && !item.series ? m_sessionTaken++ : 0;
+			if (count > 1)
+				m_spaceCv.notify_all();
+			else
+				m_spaceCv.notify_one();
+			lock.unlock();
+
+			const auto t0 = std::chrono::steady_clock::now();
+			if (!records.empty())
+			{
+				m_sequence.WriteRecords(records.data(), records.size(), staging);
+				for (const IpxImageSequence::Writer::Record &record : records)
+					m_sequence.Commit(record.slot, record.result == IPX_ERR_OK);
+				err = records[0].result;
+			}
+			else if (sequence)
+			{
+				if (err == IPX_ERR_OK)
+				{
+					IpxImageSequence::Writer::Record record = { slot, &item.image, IPX_ERR_OK };
+					m_sequence.WriteRecords(&record, 1, staging);
+					err = record.result;
+					m_sequence.Commit(slot, err == IPX_ERR_OK);
+				}
+			}
+			else if (item.series)
+			{
+				if (err == IPX_ERR_OK)
+					err = WriteFile(serializer, item);
+			}
+			else if (item.fileName.empty())
+				err = WriteSession(item, ticket);
+			else
+				err = WriteFile(serializer, item);
+			const auto t1 = std::chrono::steady_clock::now();
+			item.frame.Reset();
+			for (Item &next : batch)
+				next.frame.Reset();
+
+			lock.lock();
+			// the images of the batch share the duration of the submission
+			Finish(item, err, t0, t1);
+			EndRecord(item);
+			for (size_t i = 0; i < batch.size(); ++i)
+			{
+				Finish(batch[i], records[i + 1].result, t0, t1);
+				EndRecord(batch[i]);
+			}
+			batch.clear();
+			records.clear();
+			m_busy -= count;
+			if (m_busy == 0 && m_queue.empty())
+				m_idleCv.notify_all();
+		}
+	}
+
+	IpxError WriteSession( Item &item, uint64_t ticket )
+	{
+		std::unique_lock<std::mutex> lock(m_sessionMutex);
+		m_sessionCv.wait(lock, [this, ticket]{ return m_sessionWritten == ticket; });
+		const IpxError err = m_serializer->Save(&item.image, nullptr);
+		++m_sessionWritten;
+		m_sessionCv.notify_all();
+		return err;
+	}
+
+	void ResetStats()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stats = Stats();
+		m_stats.queueHigh = static_cast<int64_t>(m_queue.size());
+	}
+
+	Component m_component;
+	IpxImageSerializer *m_serializer;				// the recording session, the parameters and Load
+	std::vector<IpxImageSerializer*> m_writers;		// the standalone images, one per thread
+	std::vector<std::thread> m_threads;
+
+	std::mutex m_mutex;
+	std::condition_variable m_cv;			// the images are queued or the threads are stopped
+	std::condition_variable m_spaceCv;		// an image is taken from the queue or m_stopping is cleared
+	std::condition_variable m_idleCv;		// all the images are written
+	std::deque<Item> m_queue;
+	std::vector<std::vector<uint64_t>> m_spare;
+	size_t m_busy = 0;
+	size_t m_recordsPending = 0;			// the images of the sequence or the file series queued or being written
+	bool m_stop = false;
+	bool m_stopping = false;				// the threads are stopped and not started by Save until ResumeThreads
+	uint64_t m_sessionTaken = 0;
+	IpxError m_writeError = IPX_ERR_OK;
+	Stats m_stats;
+
+	std::mutex m_sessionMutex;
+	std::condition_variable m_sessionCv;
+	uint64_t m_sessionWritten = 0;
+
+	IpxImageSequence::Writer m_sequence;
+	bool m_sequenceOn = false;				// Enqueue sends the session images to m_sequence, protected by m_mutex
+	std::vector<IpxImageSequence::Region> m_buffers;	// RegisterBuffers, protected by m_mutex
+
+	// StartFileSeriesRecord, protected by m_mutex
+	bool m_seriesOn = false;
+	std::string m_seriesPrefix;
+	std::string m_seriesSuffix;
+	size_t m_seriesDigits = 0;
+	uint64_t m_seriesNext = 0;
+};
+
+#endif // __cplusplus
+
+#endif // _IPX_IMAGE_SERIALIZER_ASYNC_H_
@@ -0,0 +1,454 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Camera SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxPreTrigger.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Pre-trigger capture of the frames around an event
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IPX_PRE_TRIGGER_H
+#define IPX_PRE_TRIGGER_H
+
+#include "IpxCameraApi.h"
+#include "IpxFrame.h"
+
+#ifdef __cplusplus
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+
+/*! \namespace IpxCamCapture
+    \brief A namespace provides the pre-trigger capture: the stream buffers hold the last frames and the frames around
+    the trigger are handed out as a clip.
+
+    \details While armed, the capture keeps the last preFrames frames (and not older than preTime) in the stream buffers
+    themselves, the older buffers are queued back to the stream, so no image is copied. On Trigger or on the GenICam event
+    the pre-trigger window is frozen, postFrames more frames are collected and the clip is passed to the application:
+    \code
+    IpxCamCapture::CaptureParams params;
+    params.preFrames = 100;
+    params.postFrames = 50;
+    IpxCamCapture::PreTriggerCapture capture(device, params);
+    capture.CreateBuffers();
+    stream->StartAcquisition();
+    genParams->ExecuteCommand("AcquisitionStart");
+    capture.Start();
+    ...
+    capture.Trigger();                              // a truck appeared
+    IpxCamCapture::Clip clip = capture.GetClip(5000);
+    for (auto &frame : clip.frames)                 // in the order of the frames, clip.triggerIndex is the first post-trigger one
+        Save(frame.GetImage());
+    \endcode
+    The buffers of the clip return to the stream when the clip is destroyed, the capture is re-armed immediately after
+    the clip is completed.
+*/
+namespace IpxCamCapture
+{
+    //! Parameters of the pre-trigger capture
+    struct CaptureParams
+    {
+        CaptureParams() : preFrames(32), preTime(0), postFrames(32), reserve(4), clips(1), tickFrequency(1000000000.0), grabTimeout(100) {}
+
+        uint32_t preFrames;     //!< maximum number of the frames before the trigger, 0 - the clip starts at the trigger
+        uint64_t preTime;       //!< maximum age of the frames before the trigger relative to the trigger, ns, 0 - no limit
+        uint32_t postFrames;    //!< number of the frames after the trigger
+        uint32_t reserve;       //!< number of the buffers always left queued in the stream, so the camera never runs out of buffers
+        uint32_t clips;         //!< number of the clips the application holds at once, while the next one is captured
+        double tickFrequency;   //!< timestamp ticks per second of the camera (GevTimestampTickFrequency)
+        uint64_t grabTimeout;   //!< timeout of GetBuffer of the capture thread, ms
+    };
+
+    //! Frames captured around the trigger
+    struct Clip
+    {
+        Clip() : triggerIndex(0), triggerTimestamp(0), id(0), truncated(false) {}
+
+        std::vector<IpxCamFrame::Frame> frames; //!< frames in the order of acquisition
+        size_t triggerIndex;        //!< index of the first frame after the trigger, equals the number of the pre-trigger frames
+        uint64_t triggerTimestamp;  //!< camera timestamp of the trigger in ticks
+        uint64_t id;                //!< sequential number of the clip
+        bool truncated;             //!< true if the pre-trigger window was shortened because the stream ran out of buffers
+    };
+
+    //! An enumeration of the capture states
+    enum State
+    {
+        StateIdle = 0,      /*!< The capture thread is not running */
+        StateArmed = 1,     /*!< The last frames are kept, waiting for the trigger */
+        StateTriggered = 2  /*!< The post-trigger frames are collected */
+    };
+
+    /**
+    \brief Pre-trigger capture of one stream
+    \details The capture thread is the only consumer of the stream, the application must not call GetBuffer while it runs.
+    */
+    class PreTriggerCapture
+    {
+    public:
+
+        //! Constructor
+        /*!
+        \param[in] device the device, the capture uses its first stream
+        \param[in] params the capture parameters
+        */
+        PreTriggerCapture( IpxCam::Device *device, const CaptureParams &params = CaptureParams() )
+            : m_device(device), m_stream(device && device->GetNumStreams() ? device->GetStreamByIndex(0) : nullptr)
+            , m_frames(m_stream), m_params(params), m_running(false), m_state(StateIdle)
+            , m_trigger(TriggerNone), m_triggerTimestamp(0), m_eventId(0), m_eventRegistered(false)
+            , m_numTriggers(0), m_numMissed(0), m_clipId(0), m_head(0), m_count(0)
+        {
+            if (m_params.postFrames == 0)
+                m_params.postFrames = 1;
+            if (m_params.reserve == 0)
+                m_params.reserve = 1;
+            if (m_params.clips == 0)
+                m_params.clips = 1;
+            m_history.resize(GetNumBuffers());
+        }
+
+        ~PreTriggerCapture()
+        {
+            Stop();
+            SetEventTrigger(false);
+        }
+
+        PreTriggerCapture( const PreTriggerCapture& ) = delete;
+        PreTriggerCapture& operator=( const PreTriggerCapture& ) = delete;
+
+        //! Returns the number of the buffers the capture needs: the pre and post-trigger frames of every clip and the reserve
+        /*!
+        If the application holds more clips, the pre-trigger window of the next clip is shortened (Clip::truncated) and
+        the post-trigger frames wait for the buffers of the released clips.
+        */
+        size_t GetNumBuffers() const
+        {
+            return (static_cast<size_t>(m_params.preFrames) + m_params.postFrames) * m_params.clips + m_params.reserve;
+        }
+
+        //! Creates and queues the missing buffers, so the stream has GetNumBuffers buffers
+        /*!
+        The buffers are released by the application with ReleaseBufferQueue as usual.
+        \return Returns IPX_CAM_ERR_OK or the error of CreateBuffer
+        */
+        IpxCamErr CreateBuffers()
+        {
+            if (!m_stream)
+                return IPX_CAM_ERR_NO_DEVICE;
+            const size_t size = m_stream->GetBufferSize();
+            for (size_t i = m_stream->GetNumAnnounced(); i < GetNumBuffers(); ++i)
+            {
+                IpxCamErr err = IPX_CAM_ERR_OK;
+                if (!m_stream->CreateBuffer(size, nullptr, &err))
+                    return err != IPX_CAM_ERR_OK ? err : IPX_CAM_ERR_UNKNOWN;
+            }
+            return IPX_CAM_ERR_OK;
+        }
+
+        //! Starts the capture thread, the acquisition must be started by the application
+        IpxCamErr Start()
+        {
+            if (!m_stream)
+                return IPX_CAM_ERR_NO_DEVICE;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_running)
+                return IPX_CAM_ERR_INVALID_STATE;
+            m_running = true;
+            m_trigger = TriggerNone;
+            m_state = StateArmed;
+            m_thread = std::thread(&PreTriggerCapture::Run, this);
+            return IPX_CAM_ERR_OK;
+        }
+
+        //! Stops the capture thread and releases the kept frames and the clip not taken by the application
+        void Stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_running)
+                    return;
+                m_running = false;
+            }
+            m_cv.notify_all();
+            if (m_thread.joinable())
+                m_thread.join();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_ready.clear();
+            m_state = StateIdle;
+        }
+
+        //! Triggers the capture
+        /*!
+        The call only sets the request, it can be made from any thread including the event callbacks.
+        \param[in] timestamp the camera timestamp of the event in ticks, the frames not later than it are the pre-trigger
+        frames. 0 - the trigger is at the last received frame.
+        \return Returns IPX_CAM_ERR_OK or IPX_CAM_ERR_INVALID_STATE if the capture is not armed, the trigger is then counted as missed
+        */
+        IpxCamErr Trigger( uint64_t timestamp = 0 )
+        {
+            // the claimed trigger publishes its timestamp before the capture thread sees it
+            int expected = TriggerNone;
+            if (m_state != StateArmed || !m_trigger.compare_exchange_strong(expected, TriggerClaimed, std::memory_order_acq_rel))
+            {
+                ++m_numMissed;
+                return IPX_CAM_ERR_INVALID_STATE;
+            }
+            m_triggerTimestamp.store(timestamp, std::memory_order_relaxed);
+            m_trigger.store(TriggerPending, std::memory_order_release);
+            return IPX_CAM_ERR_OK;
+        }
+
+        //! Enables the trigger by the GenICam event of the device
+        /*!
+        The GigE Vision event data carries the event ID and the timestamp, the timestamp becomes the trigger point.
+        \param[in] enable true to register the event callback, false to unregister it
+        \param[in] eventId the event ID to react on (see EventSelector), 0 - any event
+        \return Returns the error of RegisterEvent2
+        */
+        IpxCamErr SetEventTrigger( bool enable, uint16_t eventId = 0 )
+        {
+            if (!m_device)
+                return IPX_CAM_ERR_NO_DEVICE;
+            m_eventId = eventId;
+            if (enable == m_eventRegistered)
+                return IPX_CAM_ERR_OK;
+            IpxCamErr err = enable ? m_device->RegisterEvent2(IpxCam::Device::GenICamEvent, &PreTriggerCapture::OnEvent, this)
+                : m_device->UnRegisterEvent2(IpxCam::Device::GenICamEvent, &PreTriggerCapture::OnEvent, this);
+            if (err == IPX_CAM_ERR_OK)
+                m_eventRegistered = enable;
+            return err;
+        }
+
+        //! Waits for the completed clip
+        /*!
+        \param[in] iTimeout timeout in milliseconds, UINT64_MAX - infinite
+        \param[out] err returns IPX_CAM_ERR_OK, IPX_CAM_ERR_TIMEOUT or IPX_CAM_ERR_INVALID_STATE if the capture was stopped
+        \return Returns the clip, the frames are empty on the error
+        */
+        Clip GetClip( uint64_t iTimeout, IpxCamErr *err = nullptr )
+        {
+            Clip clip;
+            std::unique_lock<std::mutex> lock(m_mutex);
+            auto ready = [this]{ return !m_ready.empty() || !m_running; };
+            if (iTimeout == UINT64_MAX)
+                m_cv.wait(lock, ready);
+            else
+                m_cv.wait_for(lock, std::chrono::milliseconds(iTimeout), ready);
+
+            IpxCamErr result = IPX_CAM_ERR_OK;
+            if (!m_ready.empty())
+            {
+                clip = std::move(m_ready.front());
+                m_ready.pop_front();
+            }
+            else
+                result = m_running ? IPX_CAM_ERR_TIMEOUT : IPX_CAM_ERR_INVALID_STATE;
+            if (err)
+                *err = result;
+            return clip;
+        }
+
+        State GetState() const { return m_state; }
+
+        //! Returns the number of the accepted triggers
+        uint64_t GetNumTriggers() const { return m_numTriggers; }
+
+        //! Returns the number of the triggers ignored because the previous one was not completed or the capture was not armed
+        uint64_t GetNumMissedTriggers() const { return m_numMissed; }
+
+        const CaptureParams& GetParams() const { return m_params; }
+
+    private:
+        // the request of Trigger, the capture thread takes it when it is pending
+        enum TriggerRequest
+        {
+            TriggerNone,
+            TriggerClaimed,
+            TriggerPending
+        };
+
+
+        static void IPXCAM_CALL OnEvent( uint32_t eventType, const void *eventData, size_t eventSize, void *pPrivate )
+        {
+            auto self = static_cast<PreTriggerCapture*>(pPrivate);
+            if (eventType != IpxCam::Device::GenICamEvent || !eventData)
+                return;
+
+            // GigE Vision EVENTDATA: the event ID at the byte 10, the timestamp at the byte 16, big endian
+            auto data = static_cast<const uint8_t*>(eventData);
+            uint16_t id = 0;
+            uint64_t timestamp = 0;
+            if (eventSize >= 24 && data[0] == 0x42)
+            {
+                id = static_cast<uint16_t>(data[10] << 8 | data[11]);
+                for (int i = 16; i < 24; ++i)
+                    timestamp = timestamp << 8 | data[i];
+            }
+            if (self->m_eventId == 0 || self->m_eventId == id)
+                self->Trigger(timestamp);
+        }
+
+        // the history ring of the kept frames, accessed by the capture thread only
+        IpxCamFrame::Frame& At( size_t index ) { return m_history[(m_head + index) % m_history.size()]; }
+
+        void PopFront()
+        {
+            m_history[m_head].Reset();
+            m_head = (m_head + 1) % m_history.size();
+            --m_count;
+        }
+
+        // moves the pre-trigger window and the already received post-trigger frames to the clip
+        void Freeze( Clip *clip, uint64_t timestamp )
+        {
+            const uint64_t last = m_count ? At(m_count - 1).GetTimestamp() : 0;
+            const uint64_t trigger = timestamp ? timestamp : last;
+
+            size_t split = m_count;
+            while (split > 0 && At(split - 1).GetTimestamp() > trigger)
+                --split;
+
+            // the frames older than the window are released
+            const uint64_t maxAge = static_cast<uint64_t>(static_cast<double>(m_params.preTime) * m_params.tickFrequency / 1000000000.0);
+            size_t first = split > m_params.preFrames ? split - m_params.preFrames : 0;
+            while (maxAge && first < split && trigger - At(first).GetTimestamp() > maxAge)
+                ++first;
+            for (size_t i = 0; i < first; ++i)
+                PopFront();
+            split -= first;
+
+            clip->frames.clear();
+            clip->frames.reserve(split + m_params.postFrames);
+            while (m_count)
+            {
+                clip->frames.push_back(std::move(At(0)));
+                PopFront();
+            }
+            clip->triggerIndex = split;
+            clip->triggerTimestamp = trigger;
+            clip->truncated = m_truncated;
+        }
+
+        void Complete( Clip *clip )
+        {
+            clip->id = ++m_clipId;
+            // the trigger of the finished clip is cleared before the next one is accepted
+            m_trigger = TriggerNone;
+            m_truncated = false;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_ready.push_back(std::move(*clip));
+                m_state = StateArmed;
+            }
+            *clip = Clip();
+            m_cv.notify_all();
+        }
+
+        void Run()
+        {
+            const size_t numBuffers = GetNumBuffers();
+            Clip clip;
+            m_truncated = false;
+
+            while (m_running)
+            {
+                if (m_state == StateArmed && m_trigger.load(std::memory_order_acquire) == TriggerPending)
+                {
+                    ++m_numTriggers;
+                    Freeze(&clip, m_triggerTimestamp.load(std::memory_order_relaxed));
+                    m_state = StateTriggered;
+                    if (clip.frames.size() - clip.triggerIndex >= m_params.postFrames)
+                    {
+                        clip.frames.resize(clip.triggerIndex + m_params.postFrames);
+                        Complete(&clip);
+                    }
+                }
+
+                IpxCamErr err = IPX_CAM_ERR_OK;
+                auto buffer = m_stream->GetBuffer(m_params.grabTimeout, &err);
+                if (!buffer)
+                {
+                    if (err != IPX_CAM_ERR_TIMEOUT)
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    continue;
+                }
+
+                IpxCamFrame::Frame frame = m_frames.Wrap(buffer);
+                if (m_state == StateTriggered)
+                {
+                    clip.frames.push_back(std::move(frame));
+                    if (clip.frames.size() - clip.triggerIndex >= m_params.postFrames)
+                    {
+                        Complete(&clip);
+                        continue;
+                    }
+                    // the earlier clips are still held, the oldest pre-trigger frames give their buffers to the post-trigger ones
+                    while (clip.triggerIndex && m_frames.GetNumOutstanding() + m_params.reserve > numBuffers)
+                    {
+                        clip.frames.erase(clip.frames.begin());
+                        --clip.triggerIndex;
+                        clip.truncated = true;
+                    }
+                    continue;
+                }
+
+                // armed: the new frame replaces the oldest one once the window is full, without the pre-trigger frames
+                // the last one is kept for the trigger timestamp older than it
+                if (m_count && m_count >= m_params.preFrames)
+                    PopFront();
+                m_history[(m_head + m_count) % m_history.size()] = std::move(frame);
+                ++m_count;
+
+                // the clips held by the application take the buffers, the window shrinks to keep the reserve queued
+                while (m_count > 1 && m_frames.GetNumOutstanding() + m_params.reserve > numBuffers)
+                {
+                    PopFront();
+                    m_truncated = true;
+                }
+            }
+
+            while (m_count)
+                PopFront();
+            clip = Clip();
+        }
+
+        IpxCam::Device *m_device;
+        IpxCam::Stream *m_stream;
+        IpxCamFrame::FrameQueue m_frames;
+        CaptureParams m_params;
+
+        std::thread m_thread;
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::atomic<bool> m_running;
+        std::atomic<State> m_state;
+        std::deque<Clip> m_ready;
+
+        std::atomic<int> m_trigger;
+        std::atomic<uint64_t> m_triggerTimestamp;
+        std::atomic<uint16_t> m_eventId;
+        bool m_eventRegistered;
+        std::atomic<uint64_t> m_numTriggers;
+        std::atomic<uint64_t> m_numMissed;
+        uint64_t m_clipId;
+
+        std::vector<IpxCamFrame::Frame> m_history;
+        size_t m_head;
+        size_t m_count;
+        bool m_truncated;
+    };
+
+} // end of namespace IpxCamCapture
+
+#endif // __cplusplus
+
+#endif // IPX_PRE_TRIGGER_H
@@ -0,0 +1,342 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Imaging API SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxRoiConverter.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Header-only conversion of the IpxRect regions of the image to the compact images
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _IPX_ROI_CONVERTER_H_
+#define _IPX_ROI_CONVERTER_H_
+
+#include "IpxBayer.h"
+#include "IpxTrueSense.h"
+#include "IpxImageConverter.h"
+#include "IpxToolsImpl.h"
+#include "IpxUnpackCpu.h"
+
+#ifdef __cplusplus
+
+#include <cstring>
+#include <vector>
+#include <new>
+
+/*!
+\brief Views of the rectangles of the image
+\details The view is an IpxImage header pointing into the source data, its rows keep the source rowSize. The origin
+of the view must be on the boundary of the packed pixel group, see GetAlignment. The Bayer views starting at the odd
+column or row get the pixel type of the CFA order seen from the origin, for example the (1, 0) view of
+II_PIX_BAYRG12 is II_PIX_BAYGR12. The origin of the TrueSense view is aligned to the 4x4 pattern, so the view keeps
+the source pixel type.
+*/
+namespace IpxRoi
+{
+	//! Returns the Bayer type of the view starting at (x, y) of the Bayer image, 0 - not a Bayer type
+	inline uint32_t GetShiftedBayerType( uint32_t pixelType, uint32_t x, uint32_t y )
+	{
+		// GR, RG, GB, BG of the same depth and packing
+		static const uint32_t types[][4] =
+		{
+			{ II_PIX_BAYGR8, II_PIX_BAYRG8, II_PIX_BAYGB8, II_PIX_BAYBG8 },
+			{ II_PIX_BAYGR10, II_PIX_BAYRG10, II_PIX_BAYGB10, II_PIX_BAYBG10 },
+			{ II_PIX_BAYGR12, II_PIX_BAYRG12, II_PIX_BAYGB12, II_PIX_BAYBG12 },
+			{ II_PIX_BAYGR14, II_PIX_BAYRG14, II_PIX_BAYGB14, II_PIX_BAYBG14 },
+			{ II_PIX_BAYGR16, II_PIX_BAYRG16, II_PIX_BAYGB16, II_PIX_BAYBG16 },
+			{ II_PIX_BAYGR10_PACKED_PFNC, II_PIX_BAYRG10_PACKED_PFNC, II_PIX_BAYGB10_PACKED_PFNC, II_PIX_BAYBG10_PACKED_PFNC },
+			{ II_PIX_BAYGR10_PACKED_GEV, II_PIX_BAYRG10_PACKED_GEV, II_PIX_BAYGB10_PACKED_GEV, II_PIX_BAYBG10_PACKED_GEV },
+			{ II_PIX_BAYGR12_PACKED_PFNC, II_PIX_BAYRG12_PACKED_PFNC, II_PIX_BAYGB12_PACKED_PFNC, II_PIX_BAYBG12_PACKED_PFNC },
+			{ II_PIX_BAYGR12_PACKED_GEV, II_PIX_BAYRG12_PACKED_GEV, II_PIX_BAYGB12_PACKED_GEV, II_PIX_BAYBG12_PACKED_GEV },
+		};
+		// the red pixel in the 2x2 block of GR, RG, GB, BG and the index of the type by the red pixel [y][x]
+		static const int redX[4] = { 1, 0, 0, 1 };
+		static const int redY[4] = { 0, 0, 1, 1 };
+		static const int order[2][2] = { { 1, 0 }, { 2, 3 } };
+		for (const uint32_t *row : types)
+			for (int i = 0; i < 4; ++i)
+				if (row[i] == pixelType)
+					return row[order[(redY[i] + y) & 1][(redX[i] + x) & 1]];
+		return 0;
+	}
+
+	//! Returns the alignment of the origin of the view in pixels, false - the views of the type are not supported
+	/*!
+	\param[in] pixelType the source pixel type
+	\param[out] alignX the column of the origin is a multiple of it
+	\param[out] alignY the row of the origin is a multiple of it
+	\param[in] taps the taps of the FLEX camera, see IpxUnpackKernels::GetLayout
+	*/
+	inline bool GetAlignment( uint32_t pixelType, uint32_t *alignX, uint32_t *alignY, int taps = 1 )
+	{
+		const uint32_t bits = II_GET_PIXEL_BITS_SIZE(pixelType);
+		if (!bits)
+			return false;
+		*alignY = II_IS_SPARSE_CFA_PIXEL(pixelType) ? 4 : 1;
+		if (II_IS_SPARSE_CFA_PIXEL(pixelType))
+		{
+			*alignX = 4;
+			return true;
+		}
+		if ((pixelType & II_PIXEL_ALIGNMENT_PACK_MASK) == II_ALIGN_PACKED_FLEX)
+		{
+			int layout = 0, depth = 0;
+			if (!IpxUnpackKernels::GetLayout(pixelType, taps, &layout, &depth))
+				return false;
+			if (layout == IpxUnpackKernels::LayoutWord)
+				*alignX = depth == 10 ? uint32_t(IpxUnpackKernels::Block<IpxUnpackKernels::LayoutWord, 10>::Word)
+					: uint32_t(IpxUnpackKernels::Block<IpxUnpackKernels::LayoutWord, 12>::Word);
+			else
+				*alignX = layout == IpxUnpackKernels::LayoutStream ? (depth == 10 ? 4 : 2) : 1;
+			return true;
+		}
+		// the smallest number of pixels filling the whole bytes, the pairs of pixels share the chroma of YUV 4:2:2
+		uint32_t x = 1;
+		while ((x * bits) % 8)
+			++x;
+		if (II_GET_PIXEL_CHROMATICITY(pixelType) == II_PIX_YUV && pixelType != II_PIX_YUV444_8 && x < 2)
+			x = 2;
+		*alignX = x;
+		return true;
+	}
+
+	//! Returns the byte offset of the pixel x in the row of the type, x is aligned by GetAlignment
+	inline size_t GetRowOffset( uint32_t pixelType, uint32_t x, int taps = 1 )
+	{
+		int layout = 0, depth = 0;
+		if ((pixelType & II_PIXEL_ALIGNMENT_PACK_MASK) == II_ALIGN_PACKED_FLEX
+			&& IpxUnpackKernels::GetLayout(pixelType, taps, &layout, &depth))
+			return IpxUnpackKernels::GetPackedRowBytes(pixelType, x, taps);
+		return size_t(x) * II_GET_PIXEL_BITS_SIZE(pixelType) / 8;
+	}
+
+	//! Returns the bytes of the row of width pixels of the type, the partial byte or word is counted
+	inline size_t GetRowBytes( uint32_t pixelType, uint32_t width, int taps = 1 )
+	{
+		int layout = 0, depth = 0;
+		if ((pixelType & II_PIXEL_ALIGNMENT_PACK_MASK) == II_ALIGN_PACKED_FLEX
+			&& IpxUnpackKernels::GetLayout(pixelType, taps, &layout, &depth))
+			return IpxUnpackKernels::GetPackedRowBytes(pixelType, width, taps);
+		return (size_t(width) * II_GET_PIXEL_BITS_SIZE(pixelType) + 7) / 8;
+	}
+
+	//! Sets the header of the view of the rectangle of the source image, no data is copied
+	/*!
+	\param[in] src the source image
+	\param[in] rect the rectangle inside the source, the origin is aligned by GetAlignment
+	\param[out] view the view, imageDataOrigin is nullptr
+	\param[in] taps the taps of the FLEX camera
+	\return false if the rectangle is outside the source, not aligned or the type does not support the views
+	*/
+	inline bool GetView( const IpxImage *src, const IpxRect &rect, IpxImage *view, int taps = 1 )
+	{
+		uint32_t alignX = 0, alignY = 0;
+		const uint32_t type = src->pixelTypeDescr.pixelType;
+		if (!src->imageData || !GetAlignment(type, &alignX, &alignY, taps))
+			return false;
+		if (rect.x < 0 || rect.y < 0 || rect.width <= 0 || rect.height <= 0
+			|| uint32_t(rect.x) % alignX || uint32_t(rect.y) % alignY
+			|| uint32_t(rect.width) > src->width || uint32_t(rect.x) > src->width - uint32_t(rect.width)
+			|| uint32_t(rect.height) > src->height || uint32_t(rect.y) > src->height - uint32_t(rect.height))
+			return false;
+
+		uint32_t viewType = type;
+		if (II_IS_BAYER_CFA_PIXEL(type))
+		{
+			viewType = GetShiftedBayerType(type, uint32_t(rect.x), uint32_t(rect.y));
+			if (!viewType)
+				return false;
+		}
+		*view = *src;
+		if (!IpxInitPixelTypeDescr(viewType, &view->pixelTypeDescr))
+			return false;
+		view->width = uint32_t(rect.width);
+		view->height = uint32_t(rect.height);
+		view->imageData = src->imageData + size_t(rect.y) * src->rowSize + GetRowOffset(type, uint32_t(rect.x), taps);
+		view->imageDataOrigin = nullptr;
+		// the last row of the view ends at its last pixel, the source may end there too
+		const size_t offset = size_t(view->imageData - src->imageData);
+		size_t size = size_t(src->rowSize) * (view->height - 1) + GetRowBytes(type, view->width, taps);
+		if (src->imageSize > offset && size > src->imageSize - offset)
+			size = src->imageSize - offset;
+		view->imageSize = uint32_t(size);
+		return true;
+	}
+
+	//! Copies the rectangle at (x, y) of the unpacked image to the image of the same type and of the rectangle size
+	inline void CopyRect( const IpxImage *src, uint32_t x, uint32_t y, IpxImage *dst )
+	{
+		const size_t bpp = II_GET_PIXEL_BITS_SIZE(src->pixelTypeDescr.pixelType) / 8;
+		const char *s = src->imageData + size_t(y) * src->rowSize + x * bpp;
+		for (uint32_t r = 0; r < dst->height; ++r)
+			::memcpy(dst->imageData + size_t(r) * dst->rowSize, s + size_t(r) * src->rowSize, dst->width * bpp);
+	}
+}
+
+/*!
+\brief Converts the IpxRect regions of the image by IpxBayer, IpxTrueSense or IpxImageConverter
+\details Every region is converted to its own compact output image of the region size, so only the pixels of the
+regions and their margins are processed, not the whole sensor. The component converts the IpxRoi view of the
+region directly to the output when the region origin is aligned and the margin is 0. Otherwise the component
+converts the view enlarged by the margin and aligned by IpxRoi::GetAlignment, and the region is copied from it to
+the output. With the margin not smaller than the reach of the algorithm, 2 pixels for DEBAYER_ALGO_TYPE and 16 pixels
+for the TrueSense filters, the region gets the same values as in the converted full image; with the margin 0, the
+region edges are interpolated as the image edges.
+
+The output pixel types are set by the caller. The output data is allocated by the converter if
+imageData is nullptr or the image does not fit, and is owned by the converter until ReleaseData.
+\code
+IpxRoiConverter roi(bayer);			// IpxBayer *bayer
+IpxRect rects[2] = { IpxRect(101, 33, 640, 480), IpxRect(3000, 2000, 256, 256) };
+IpxImage outputs[2];
+outputs[0].pixelTypeDescr.pixelType = outputs[1].pixelTypeDescr.pixelType = II_PIX_RGB8;
+IpxError err = roi.ConvertRois(raw, rects, 2, outputs);	// outputs[0] is 640x480, outputs[1] is 256x256
+\endcode
+*/
+class IpxRoiConverter
+{
+public:
+	//! Default margin of IpxBayer, the 5x5 reach of the demosaicing
+	static const int DefaultMargin = 2;
+	//! Default margin of IpxTrueSense, the halo of its filters as the default TS_STRIPE_HALO of IpxTrueSenseStriped
+	static const int TrueSenseMargin = 16;
+
+	explicit IpxRoiConverter( IpxBayer *bayer ) : m_bayer(bayer), m_margin(DefaultMargin), m_cmp(IPX_CMP_BAYER_DEMOSAICING) {}
+	explicit IpxRoiConverter( IpxTrueSense *trueSense ) : m_trueSense(trueSense), m_margin(TrueSenseMargin), m_cmp(IPX_CMP_TS_DEMOSAICING) {}
+	//! The pixel-wise conversions need no margin
+	explicit IpxRoiConverter( IpxImageConverter *converter ) : m_converter(converter), m_margin(0), m_cmp(IPX_CMP_IMG_CONVERTER) {}
+
+	//! Sets the pixels around the region converted with it, clipped by the image
+	void SetMargin( int margin ) { m_margin = margin > 0 ? margin : 0; }
+	int GetMargin() const { return m_margin; }
+
+	//! Sets the taps of the FLEX camera for the FLEX packed sources, see IpxUnpackKernels::GetLayout
+	void SetFlexTaps( int taps ) { m_taps = taps > 0 ? taps : 1; }
+
+	//! Converts the regions of the source image to the output images
+	/*!
+	\param[in] src the source image
+	\param[in] rects the regions inside the source, any origin
+	\param[in] count the number of the regions and the outputs
+	\param[in,out] outputs the output images, the pixel types are set by the caller
+	\return IPX_ERR_INVALID_ARGUMENT of the component for the regions outside the source, the error of the component
+	*/
+	IpxError ConvertRois( const IpxImage *src, const IpxRect *rects, size_t count, IpxImage *outputs )
+	{
+		if (!src || (count && (!rects || !outputs)))
+			return Error(IPX_ERR_INVALID_ARGUMENT);
+		if (m_storage.size() < count)
+			m_storage.resize(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			IpxError err = Convert(src, rects[i], &outputs[i], m_storage[i]);
+			if (err != IPX_ERR_OK)
+				return err;
+		}
+		return IPX_ERR_OK;
+	}
+
+	//! Converts one region, the output data allocated by the converter is reused by the next call
+	IpxError ConvertRoi( const IpxImage *src, const IpxRect &rect, IpxImage *output )
+	{
+		return ConvertRois(src, &rect, 1, output);
+	}
+
+	//! Releases the data allocated for the outputs and the enlarged regions
+	void ReleaseData()
+	{
+		std::vector<std::vector<uint64_t>>().swap(m_storage);
+		std::vector<uint64_t>().swap(m_scratchData);
+	}
+
+private:
+	IpxError Error( uint32_t code ) const { return IPX_ERR(m_cmp, code); }
+
+	IpxError Convert( const IpxImage *src, const IpxRect &rect, IpxImage *output, std::vector<uint64_t> &storage )
+	{
+		uint32_t alignX = 0, alignY = 0;
+		if (!src->imageData || !output || !IpxRoi::GetAlignment(src->pixelTypeDescr.pixelType, &alignX, &alignY, m_taps))
+			return Error(IPX_ERR_INVALID_ARGUMENT);
+		if (rect.x < 0 || rect.y < 0 || rect.width <= 0 || rect.height <= 0
+			|| uint32_t(rect.width) > src->width || uint32_t(rect.x) > src->width - uint32_t(rect.width)
+			|| uint32_t(rect.height) > src->height || uint32_t(rect.y) > src->height - uint32_t(rect.height))
+			return Error(IPX_ERR_INVALID_ARGUMENT);
+
+		// the region enlarged by the margin, clipped by the image and aligned
+		const uint32_t m = uint32_t(m_margin);
+		const uint32_t x1 = uint32_t(rect.x) + uint32_t(rect.width), y1 = uint32_t(rect.y) + uint32_t(rect.height);
+		const uint32_t ox = (uint32_t(rect.x) > m ? uint32_t(rect.x) - m : 0) / alignX * alignX;
+		const uint32_t oy = (uint32_t(rect.y) > m ? uint32_t(rect.y) - m : 0) / alignY * alignY;
+		const IpxRect outer(int(ox), int(oy), int((src->width - x1 > m ? x1 + m : src->width) - ox),
+			int((src->height - y1 > m ? y1 + m : src->height) - oy));
+
+		IpxImage view;
+		if (!IpxRoi::GetView(src, outer, &view, m_taps))
+			return Error(IPX_ERR_INVALID_ARGUMENT);
+		const uint32_t outType = output->pixelTypeDescr.pixelType;
+		if (!Fits(output, outType, uint32_t(rect.width), uint32_t(rect.height))
+			&& !IpxToolsImpl::InitOwnedImage(output, outType, uint32_t(rect.width), uint32_t(rect.height), storage))
+			return Error(IPX_ERR_INVALID_ARGUMENT);
+
+		IpxError err = IPX_ERR_OK;
+		if (outer.x == rect.x && outer.y == rect.y && outer.width == rect.width && outer.height == rect.height)
+			err = ConvertView(&view, output);
+		else
+		{
+			// the enlarged region is converted to the scratch image of the output type
+			if (II_GET_PIXEL_BITS_SIZE(outType) % 8)
+				return Error(IPX_ERR_NOT_SUPPORTED);
+			IpxImage scratch;
+			if (!IpxToolsImpl::InitOwnedImage(&scratch, outType, view.width, view.height, m_scratchData))
+				return Error(IPX_ERR_INVALID_ARGUMENT);
+			err = ConvertView(&view, &scratch);
+			if (err == IPX_ERR_OK && scratch.pixelTypeDescr.pixelType != outType)
+				err = Error(IPX_ERR_NOT_SUPPORTED);
+			if (err == IPX_ERR_OK)
+				IpxRoi::CopyRect(&scratch, uint32_t(rect.x) - ox, uint32_t(rect.y) - oy, output);
+		}
+		output->timestamp = src->timestamp;
+		output->imageID = src->imageID;
+		return err;
+	}
+
+	IpxError ConvertView( IpxImage *view, IpxImage *output )
+	{
+		try
+		{
+			if (m_bayer)
+				return m_bayer->ConvertImage(view, output);
+			if (m_trueSense)
+				return m_trueSense->ConvertImage(view, output);
+			if (m_converter)
+				return m_converter->ConvertImage(view, output);
+		}
+		catch (const std::bad_alloc&)
+		{
+			return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+		}
+		return Error(IPX_ERR_INVALID_ARGUMENT);
+	}
+
+	static bool Fits( const IpxImage *image, uint32_t pixelType, uint32_t width, uint32_t height )
+	{
+		return image->imageData && image->pixelTypeDescr.pixelType == pixelType && image->width == width
+			&& image->height == height && image->rowSize >= IpxGetRowSizeUnaligned(pixelType, width)
+			&& uint64_t(image->imageSize) >= uint64_t(image->rowSize) * height;
+	}
+
+	IpxBayer *m_bayer = nullptr;
+	IpxTrueSense *m_trueSense = nullptr;
+	IpxImageConverter *m_converter = nullptr;
+	int m_margin;
+	int m_cmp;
+	int m_taps = 1;
+	std::vector<std::vector<uint64_t>> m_storage;	// the outputs allocated by the converter
+	std::vector<uint64_t> m_scratchData;			// the enlarged region
+};
+
+#endif // __cplusplus
+
+#endif // _IPX_ROI_CONVERTER_H_
@@ -0,0 +1,433 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Camera SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxStreamStats.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Lock-free statistics of the received stream buffers
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IPX_STREAM_STATS_H
+#define IPX_STREAM_STATS_H
+
+#include "IpxCameraApi.h"
+#include "IpxImage.h"
+
+#ifdef __cplusplus
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/*! \namespace IpxCamStats
+    \brief A namespace provides the statistics of the stream: frame ID gaps, rolling frame rate and bandwidth,
+    inter-frame interval histogram and the log of the last stream events.
+
+    \details The receiving thread calls Update for every buffer, the update costs a few relaxed atomic stores and
+    does not allocate. Any other thread can query the statistics while the acquisition runs:
+    \code
+    IpxCamStats::StreamStats stats(IpxCamStats::GetTickFrequency(device));
+    ...
+    auto buffer = stream->GetBuffer(1000);
+    stats.Update(buffer);
+    stream->QueueBuffer(buffer);
+    ...
+    // monitoring thread
+    auto s = stats.GetSnapshot();
+    printf("%.2f FPS %.1f MiB/s dropped %llu p99 %llu ns\n", s.fps, s.bandwidth, s.dropped, stats.GetIntervalPercentile(99.0));
+    \endcode
+*/
+namespace IpxCamStats
+{
+    //! An enumeration of the logged stream events
+    enum EventType
+    {
+        EventGap = 0,           /*!< Frame IDs are missing before the frame, count is the number of missing frames */
+        EventIncomplete = 1,    /*!< The frame was delivered incomplete */
+        EventTriggerLost = 2    /*!< The interval before the frame exceeds the expected one, a trigger pulse was lost or ignored */
+    };
+
+    //! Stream event
+    struct Event
+    {
+        EventType type;
+        uint64_t frameId;       //!< frame ID of the buffer the event was detected on
+        uint64_t count;         //!< number of the missing frames for EventGap, 1 otherwise
+        uint64_t timestamp;     //!< timestamp of the buffer in ticks
+    };
+
+    //! Bin of the inter-frame interval histogram
+    struct HistogramBin
+    {
+        uint64_t lower;         //!< lower bound of the interval, ns, inclusive
+        uint64_t upper;         //!< upper bound of the interval, ns, exclusive
+        uint64_t count;         //!< number of the intervals in the bin
+    };
+
+    //! Statistics of the stream at the moment of the query
+    struct Snapshot
+    {
+        uint64_t frames;        //!< received buffers
+        uint64_t bytes;         //!< received image bytes
+        uint64_t dropped;       //!< frames missing in the frame ID sequence
+        uint64_t gaps;          //!< number of the frame ID gaps
+        uint64_t incomplete;    //!< incomplete buffers
+        uint64_t triggerLost;   //!< intervals exceeding the expected interval
+        uint64_t lastFrameId;   //!< frame ID of the last buffer
+        uint64_t lastTimestamp; //!< timestamp of the last buffer in ticks
+        double fps;             //!< rolling frame rate by the camera timestamps over the last WindowSize frames
+        double bandwidth;       //!< rolling bandwidth, MiB/s
+        uint64_t minInterval;   //!< minimum inter-frame interval, ns
+        uint64_t maxInterval;   //!< maximum inter-frame interval, ns
+        uint64_t meanInterval;  //!< mean inter-frame interval, ns
+    };
+
+    //! Returns the timestamp tick frequency of the device (GevTimestampTickFrequency), 1 GHz if not available
+    inline double GetTickFrequency( IpxCam::Device *device )
+    {
+        IpxCamErr err = IPX_CAM_ERR_OK;
+        auto params = device ? device->GetCameraParameters() : nullptr;
+        int64_t freq = params ? params->GetIntegerValue("GevTimestampTickFrequency", &err) : 0;
+        return err == IPX_CAM_ERR_OK && freq > 0 ? static_cast<double>(freq) : 1000000000.0;
+    }
+
+    /**
+    \brief Statistics of one stream
+    \details Update must be called by one thread at a time, usually the thread receiving the buffers of the stream.
+    The queries can be called by any number of threads concurrently with Update. The values of the snapshot are read
+    one by one, so they may belong to neighbouring frames.
+    */
+    class StreamStats
+    {
+    public:
+
+        static const size_t WindowSize = 64;    //!< number of the frames of the rolling frame rate and bandwidth
+        static const size_t EventCapacity = 256; //!< number of the last events kept in the log
+        static const size_t NumBins = 256;      //!< number of the histogram bins, 4 bins per power of 2
+
+        //! Constructor
+        /*!
+        \param[in] tickFrequency the timestamp ticks per second, see GetTickFrequency
+        \param[in] expectedInterval the expected interval between the frames in ticks (trigger period), 0 - do not detect lost triggers
+        */
+        explicit StreamStats( double tickFrequency = 1000000000.0, uint64_t expectedInterval = 0 )
+            : m_tickNs(1000000000.0 / tickFrequency), m_expected(expectedInterval), m_resetRequest(false)
+        {
+            Clear();
+        }
+
+        StreamStats( const StreamStats& ) = delete;
+        StreamStats& operator=( const StreamStats& ) = delete;
+
+        //! Sets the expected interval between the frames in ticks, the longer intervals than 1.5 of it are EventTriggerLost
+        void SetExpectedInterval( uint64_t ticks ) { m_expected.store(ticks, std::memory_order_relaxed); }
+
+        //! Updates the statistics by the received buffer
+        void Update( IpxCam::Buffer *buffer )
+        {
+            if (!buffer)
+                return;
+            IpxImage *image = buffer->GetImage();
+            Update(buffer->GetFrameID(), buffer->GetTimestamp(),
+                image ? image->imageSize : buffer->GetBufferSize(), buffer->IsIncomplete());
+        }
+
+        //! Updates the statistics by the frame
+        /*!
+        \param[in] frameId the frame ID (block ID) of the buffer
+        \param[in] timestamp the timestamp of the buffer in ticks
+        \param[in] bytes the size of the image data
+        \param[in] incomplete true if the buffer is incomplete
+        */
+        void Update( uint64_t frameId, uint64_t timestamp, uint64_t bytes, bool incomplete )
+        {
+            if (m_resetRequest.load(std::memory_order_relaxed) && m_resetRequest.exchange(false, std::memory_order_acquire))
+                Clear();
+
+            const uint64_t frames = m_frames.load(std::memory_order_relaxed);
+            const uint64_t prevId = m_lastFrameId.load(std::memory_order_relaxed);
+            const uint64_t prevTimestamp = m_lastTimestamp.load(std::memory_order_relaxed);
+
+            // the frame ID restarts on AcquisitionStart or wraps around, only the forward jumps are the gaps
+            if (frames && frameId > prevId + 1)
+            {
+                const uint64_t missing = frameId - prevId - 1;
+                Add(m_dropped, missing);
+                Add(m_gaps, 1);
+                Log(EventGap, frameId, missing, timestamp);
+            }
+            if (incomplete)
+            {
+                Add(m_incomplete, 1);
+                Log(EventIncomplete, frameId, 1, timestamp);
+            }
+
+            if (frames && timestamp > prevTimestamp)
+            {
+                const uint64_t ticks = timestamp - prevTimestamp;
+                const uint64_t expected = m_expected.load(std::memory_order_relaxed);
+                if (expected && ticks > expected + (expected >> 1))
+                {
+                    Add(m_triggerLost, 1);
+                    Log(EventTriggerLost, frameId, 1, timestamp);
+                }
+
+                const uint64_t ns = static_cast<uint64_t>(static_cast<double>(ticks) * m_tickNs);
+                Add(m_bins[BinIndex(ns)], 1);
+                Add(m_intervals, 1);
+                Add(m_intervalSum, ns);
+                if (ns < m_minInterval.load(std::memory_order_relaxed))
+                    m_minInterval.store(ns, std::memory_order_relaxed);
+                if (ns > m_maxInterval.load(std::memory_order_relaxed))
+                    m_maxInterval.store(ns, std::memory_order_relaxed);
+            }
+
+            // rolling window, the new frame replaces the oldest one
+            const size_t slot = static_cast<size_t>(frames % WindowSize);
+            m_windowBytes += bytes - m_windowSize[slot];
+            m_windowTimestamp[slot] = timestamp;
+            m_windowSize[slot] = bytes;
+            const uint64_t n = frames + 1 < WindowSize ? frames + 1 : WindowSize;
+            const size_t oldest = n < WindowSize ? 0 : (slot + 1) % WindowSize;
+            if (n > 1 && timestamp > m_windowTimestamp[oldest])
+            {
+                // the span starts at the oldest frame, so its bytes are not counted
+                const double seconds = static_cast<double>(timestamp - m_windowTimestamp[oldest]) * m_tickNs / 1000000000.0;
+                m_fps.store(static_cast<double>(n - 1) / seconds, std::memory_order_relaxed);
+                m_bandwidth.store(static_cast<double>(m_windowBytes - m_windowSize[oldest]) / seconds / 1048576.0,
+                    std::memory_order_relaxed);
+            }
+
+            Add(m_bytes, bytes);
+            m_lastFrameId.store(frameId, std::memory_order_relaxed);
+            m_lastTimestamp.store(timestamp, std::memory_order_relaxed);
+            m_frames.store(frames + 1, std::memory_order_release);
+        }
+
+        //! Returns the current statistics
+        Snapshot GetSnapshot() const
+        {
+            Snapshot s;
+            s.frames = m_frames.load(std::memory_order_acquire);
+            s.bytes = m_bytes.load(std::memory_order_relaxed);
+            s.dropped = m_dropped.load(std::memory_order_relaxed);
+            s.gaps = m_gaps.load(std::memory_order_relaxed);
+            s.incomplete = m_incomplete.load(std::memory_order_relaxed);
+            s.triggerLost = m_triggerLost.load(std::memory_order_relaxed);
+            s.lastFrameId = m_lastFrameId.load(std::memory_order_relaxed);
+            s.lastTimestamp = m_lastTimestamp.load(std::memory_order_relaxed);
+            s.fps = m_fps.load(std::memory_order_relaxed);
+            s.bandwidth = m_bandwidth.load(std::memory_order_relaxed);
+            const uint64_t intervals = m_intervals.load(std::memory_order_relaxed);
+            s.minInterval = intervals ? m_minInterval.load(std::memory_order_relaxed) : 0;
+            s.maxInterval = m_maxInterval.load(std::memory_order_relaxed);
+            s.meanInterval = intervals ? m_intervalSum.load(std::memory_order_relaxed) / intervals : 0;
+            return s;
+        }
+
+        //! Returns the non-empty bins of the inter-frame interval histogram
+        std::vector<HistogramBin> GetHistogram() const
+        {
+            std::vector<HistogramBin> bins;
+            for (size_t i = 0; i < NumBins; ++i)
+            {
+                const uint64_t count = m_bins[i].load(std::memory_order_relaxed);
+                if (!count)
+                    continue;
+                HistogramBin bin;
+                BinBounds(i, &bin.lower, &bin.upper);
+                bin.count = count;
+                bins.push_back(bin);
+            }
+            return bins;
+        }
+
+        //! Returns the interval percentile by the histogram, ns
+        /*!
+        \param[in] percent the percentile, 0..100
+        \return Returns the upper bound of the bin, the error is less than 25%
+        */
+        uint64_t GetIntervalPercentile( double percent ) const
+        {
+            uint64_t total = 0;
+            uint64_t counts[NumBins];
+            for (size_t i = 0; i < NumBins; ++i)
+                total += counts[i] = m_bins[i].load(std::memory_order_relaxed);
+            if (!total)
+                return 0;
+
+            const double rank = percent / 100.0 * static_cast<double>(total);
+            uint64_t accumulated = 0;
+            for (size_t i = 0; i < NumBins; ++i)
+            {
+                accumulated += counts[i];
+                if (counts[i] && static_cast<double>(accumulated) >= rank)
+                {
+                    uint64_t lower, upper;
+                    BinBounds(i, &lower, &upper);
+                    return upper;
+                }
+            }
+            return m_maxInterval.load(std::memory_order_relaxed);
+        }
+
+        //! Returns the last events in the order of occurrence
+        /*!
+        \param[out] lost receives the number of the events overwritten in the log
+        \return Returns up to EventCapacity last events
+        */
+        std::vector<Event> GetEvents( uint64_t *lost = nullptr ) const
+        {
+            std::vector<Event> events;
+            const uint64_t end = m_eventSeq.load(std::memory_order_acquire);
+            const uint64_t begin = end > EventCapacity ? end - EventCapacity : 0;
+            for (uint64_t seq = begin; seq < end; ++seq)
+            {
+                const EventSlot &slot = m_events[seq % EventCapacity];
+                const uint64_t stamp = slot.stamp.load(std::memory_order_acquire);
+                Event event;
+                event.type = static_cast<EventType>(slot.type.load(std::memory_order_relaxed));
+                event.frameId = slot.frameId.load(std::memory_order_relaxed);
+                event.count = slot.count.load(std::memory_order_relaxed);
+                event.timestamp = slot.timestamp.load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                // the slot was overwritten by a newer event while it was read
+                if (stamp != seq + 1 || slot.stamp.load(std::memory_order_relaxed) != stamp)
+                    continue;
+                events.push_back(event);
+            }
+            if (lost)
+                *lost = begin;
+            return events;
+        }
+
+        //! Requests the reset of the statistics, the thread calling Update clears them before the next frame
+        void Reset() { m_resetRequest.store(true, std::memory_order_release); }
+
+    private:
+
+        struct EventSlot
+        {
+            std::atomic<uint64_t> stamp;    // sequence number + 1 of the event in the slot, 0 while written
+            std::atomic<uint32_t> type;
+            std::atomic<uint64_t> frameId;
+            std::atomic<uint64_t> count;
+            std::atomic<uint64_t> timestamp;
+        };
+
+        // the counters have the single writer, load and store is cheaper than the locked read-modify-write
+        static void Add( std::atomic<uint64_t> &counter, uint64_t value )
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        void Log( EventType type, uint64_t frameId, uint64_t count, uint64_t timestamp )
+        {
+            const uint64_t seq = m_eventSeq.load(std::memory_order_relaxed);
+            EventSlot &slot = m_events[seq % EventCapacity];
+            slot.stamp.store(0, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.type.store(static_cast<uint32_t>(type), std::memory_order_relaxed);
+            slot.frameId.store(frameId, std::memory_order_relaxed);
+            slot.count.store(count, std::memory_order_relaxed);
+            slot.timestamp.store(timestamp, std::memory_order_relaxed);
+            slot.stamp.store(seq + 1, std::memory_order_release);
+            m_eventSeq.store(seq + 1, std::memory_order_release);
+        }
+
+        // 4 bins per power of 2: the bin is selected by the highest bit and the next two bits of the interval
+        static size_t BinIndex( uint64_t ns )
+        {
+            if (ns < 4)
+                return static_cast<size_t>(ns);
+#ifdef _MSC_VER
+            unsigned long msb;
+            _BitScanReverse64(&msb, ns);
+#else
+            const unsigned msb = 63 - static_cast<unsigned>(__builtin_clzll(ns));
+#endif
+            return static_cast<size_t>(4 * (msb - 1) + ((ns >> (msb - 2)) & 3));
+        }
+
+        static void BinBounds( size_t index, uint64_t *lower, uint64_t *upper )
+        {
+            if (index < 4)
+            {
+                *lower = index;
+                *upper = index + 1;
+                return;
+            }
+            const unsigned msb = static_cast<unsigned>(index / 4 + 1);
+            const uint64_t sub = index % 4;
+            *lower = (4 + sub) << (msb - 2);
+            *upper = msb == 63 && sub == 3 ? UINT64_MAX : (5 + sub) << (msb - 2);
+        }
+
+        // called by the updating thread only
+        void Clear()
+        {
+            m_frames.store(0, std::memory_order_relaxed);
+            m_bytes.store(0, std::memory_order_relaxed);
+            m_dropped.store(0, std::memory_order_relaxed);
+            m_gaps.store(0, std::memory_order_relaxed);
+            m_incomplete.store(0, std::memory_order_relaxed);
+            m_triggerLost.store(0, std::memory_order_relaxed);
+            m_lastFrameId.store(0, std::memory_order_relaxed);
+            m_lastTimestamp.store(0, std::memory_order_relaxed);
+            m_fps.store(0.0, std::memory_order_relaxed);
+            m_bandwidth.store(0.0, std::memory_order_relaxed);
+            m_intervals.store(0, std::memory_order_relaxed);
+            m_intervalSum.store(0, std::memory_order_relaxed);
+            m_minInterval.store(UINT64_MAX, std::memory_order_relaxed);
+            m_maxInterval.store(0, std::memory_order_relaxed);
+            for (auto &bin : m_bins)
+                bin.store(0, std::memory_order_relaxed);
+            for (auto &slot : m_events)
+                slot.stamp.store(0, std::memory_order_relaxed);
+            m_eventSeq.store(0, std::memory_order_release);
+            for (size_t i = 0; i < WindowSize; ++i)
+                m_windowTimestamp[i] = m_windowSize[i] = 0;
+            m_windowBytes = 0;
+        }
+
+        const double m_tickNs;
+        std::atomic<uint64_t> m_expected;
+        std::atomic<bool> m_resetRequest;
+
+        std::atomic<uint64_t> m_frames;
+        std::atomic<uint64_t> m_bytes;
+        std::atomic<uint64_t> m_dropped;
+        std::atomic<uint64_t> m_gaps;
+        std::atomic<uint64_t> m_incomplete;
+        std::atomic<uint64_t> m_triggerLost;
+        std::atomic<uint64_t> m_lastFrameId;
+        std::atomic<uint64_t> m_lastTimestamp;
+        std::atomic<double> m_fps;
+        std::atomic<double> m_bandwidth;
+        std::atomic<uint64_t> m_intervals;
+        std::atomic<uint64_t> m_intervalSum;
+        std::atomic<uint64_t> m_minInterval;
+        std::atomic<uint64_t> m_maxInterval;
+        std::atomic<uint64_t> m_bins[NumBins];
+
+        EventSlot m_events[EventCapacity];
+        std::atomic<uint64_t> m_eventSeq;
+
+        // the rolling window is accessed by the updating thread only
+        uint64_t m_windowTimestamp[WindowSize];
+        uint64_t m_windowSize[WindowSize];
+        uint64_t m_windowBytes;
+    };
+
+} // end of namespace IpxCamStats
+
+#endif // __cplusplus
+
+#endif // IPX_STREAM_STATS_H
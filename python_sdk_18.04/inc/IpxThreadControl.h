@@ -0,0 +1,267 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Camera SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxThreadControl.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// CPU affinity and scheduling control of the acquisition threads
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IPX_THREAD_CONTROL_H
+#define IPX_THREAD_CONTROL_H
+
+#include "IpxCameraErr.h"
+
+#ifdef __cplusplus
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/resource.h>
+#endif
+
+/*! \namespace IpxCamThread
+    \brief A namespace provides the CPU affinity and the scheduling control of the threads by the thread ID.
+
+    \details The thread ID is the kernel thread ID on Linux (gettid) and the thread ID on Windows, the same value
+    as reported by the StreamThreadId parameter of the virtual stream, top -H and Process Explorer.
+*/
+namespace IpxCamThread
+{
+    //! An enumeration of the scheduling policies
+    enum Policy : int64_t
+    {
+        PolicyOther = 0,    /*!< Time-sharing scheduling, the priority is the nice value -20..19 (Windows: -2..2 thread priority) */
+        PolicyFifo = 1,     /*!< Real-time SCHED_FIFO, the priority is 1..99 (Windows: time critical) */
+        PolicyRoundRobin = 2 /*!< Real-time SCHED_RR, the priority is 1..99 (Windows: time critical) */
+    };
+
+    //! Number of the CPUs the affinity can address
+#ifdef _WIN32
+    const int MaxCpus = static_cast<int>(sizeof(DWORD_PTR) * 8);
+#else
+    const int MaxCpus = CPU_SETSIZE;
+#endif
+
+    //! Returns the ID of the calling thread
+    inline int64_t GetCurrentThreadId()
+    {
+#ifdef _WIN32
+        return static_cast<int64_t>(::GetCurrentThreadId());
+#else
+        return static_cast<int64_t>(syscall(SYS_gettid));
+#endif
+    }
+
+    //! Parses the CPU list in the format of taskset/cpuset, for example "0-3,8,10-11"
+    /*!
+    \param[in] list the CPU list, empty string means no CPUs
+    \param[out] cpus receives the CPU numbers
+    \return Returns false if the list is malformed or a CPU is not less than MaxCpus
+    */
+    inline bool ParseCpuList( const char *list, std::vector<int> *cpus )
+    {
+        cpus->clear();
+        const char *p = list ? list : "";
+        while (*p)
+        {
+            while (*p == ' ' || *p == ',')
+                ++p;
+            if (!*p)
+                break;
+
+            char *end = nullptr;
+            long first = strtol(p, &end, 10);
+            if (end == p || first < 0 || first >= MaxCpus)
+                return false;
+            long last = first;
+            p = end;
+            if (*p == '-')
+            {
+                last = strtol(p + 1, &end, 10);
+                if (end == p + 1 || last < first || last >= MaxCpus)
+                    return false;
+                p = end;
+            }
+            if (*p && *p != ',' && *p != ' ')
+                return false;
+            for (long cpu = first; cpu <= last; ++cpu)
+                cpus->push_back(static_cast<int>(cpu));
+        }
+        return true;
+    }
+
+    //! Sets the CPU affinity of the thread
+    /*!
+    \param[in] threadId the thread ID
+    \param[in] cpus CPU numbers, the thread is allowed to run on. Empty list - all the CPUs
+    \param[out] error receives the description of the system error
+    \return Returns IPX_CAM_ERR_OK, IPX_CAM_ERR_INVALID_ARGUMENT for the CPU out of range or IPX_CAM_ERR_INVALID_STATE if the system refused the affinity
+    */
+    inline IpxCamErr SetAffinity( int64_t threadId, const std::vector<int> &cpus, std::string *error = nullptr )
+    {
+#ifdef _WIN32
+        DWORD_PTR mask = 0;
+        for (int cpu : cpus)
+        {
+            if (cpu < 0 || cpu >= MaxCpus)
+                return IPX_CAM_ERR_INVALID_ARGUMENT;
+            mask |= DWORD_PTR(1) << cpu;
+        }
+        if (cpus.empty())
+        {
+            DWORD_PTR system = 0;
+            GetProcessAffinityMask(GetCurrentProcess(), &mask, &system);
+        }
+        HANDLE thread = OpenThread(THREAD_SET_INFORMATION | THREAD_QUERY_INFORMATION, FALSE, static_cast<DWORD>(threadId));
+        bool ok = thread && SetThreadAffinityMask(thread, mask) != 0;
+        if (thread)
+            CloseHandle(thread);
+        if (!ok && error)
+            *error = "SetThreadAffinityMask failed";
+        return ok ? IPX_CAM_ERR_OK : IPX_CAM_ERR_INVALID_STATE;
+#else
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : cpus)
+        {
+            if (cpu < 0 || cpu >= MaxCpus)
+                return IPX_CAM_ERR_INVALID_ARGUMENT;
+            CPU_SET(cpu, &set);
+        }
+        if (cpus.empty())
+        {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                CPU_SET(cpu, &set);
+        }
+        if (sched_setaffinity(static_cast<pid_t>(threadId), sizeof(set), &set) != 0)
+        {
+            if (error)
+                *error = std::string("sched_setaffinity: ") + strerror(errno);
+            return IPX_CAM_ERR_INVALID_STATE;
+        }
+        return IPX_CAM_ERR_OK;
+#endif
+    }
+
+    //! Returns the CPUs the thread is allowed to run on in the CPU list format
+    inline std::string GetAffinity( int64_t threadId )
+    {
+        std::string result;
+#ifndef _WIN32
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(static_cast<pid_t>(threadId), sizeof(set), &set) != 0)
+            return result;
+
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (!CPU_ISSET(cpu, &set))
+                continue;
+            int last = cpu;
+            while (last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, &set))
+                ++last;
+            if (!result.empty())
+                result += ",";
+            result += std::to_string(cpu);
+            if (last != cpu)
+                result += "-" + std::to_string(last);
+            cpu = last;
+        }
+#else
+        (void)threadId;
+#endif
+        return result;
+    }
+
+    //! Gets the range of the priority accepted for the scheduling policy
+    /*!
+    \param[in] policy the scheduling policy
+    \param[out] minPriority receives the lowest valid priority
+    \param[out] maxPriority receives the highest valid priority
+    \details The nice value range -20..19 for PolicyOther, the sched_get_priority_min/max range of the real-time policy
+    */
+    inline void GetPriorityRange( Policy policy, int64_t *minPriority, int64_t *maxPriority )
+    {
+        *minPriority = -20;
+        *maxPriority = 19;
+        if (policy != PolicyFifo && policy != PolicyRoundRobin)
+            return;
+#ifdef _WIN32
+        *minPriority = 1;
+        *maxPriority = 99;
+#else
+        const int sysPolicy = policy == PolicyFifo ? SCHED_FIFO : SCHED_RR;
+        *minPriority = sched_get_priority_min(sysPolicy);
+        *maxPriority = sched_get_priority_max(sysPolicy);
+#endif
+    }
+
+    //! Sets the scheduling policy and the priority of the thread
+    /*!
+    \param[in] threadId the thread ID
+    \param[in] policy the scheduling policy
+    \param[in] priority nice value for PolicyOther, real-time priority for PolicyFifo and PolicyRoundRobin
+    \param[out] error receives the description of the system error
+    \return Returns IPX_CAM_ERR_OK, IPX_CAM_ERR_INVALID_ARGUMENT for the priority out of range or IPX_CAM_ERR_INVALID_STATE
+    if the system refused the scheduling (real-time scheduling usually requires CAP_SYS_NICE or RLIMIT_RTPRIO)
+    */
+    inline IpxCamErr SetScheduling( int64_t threadId, Policy policy, int64_t priority, std::string *error = nullptr )
+    {
+        const bool realtime = policy == PolicyFifo || policy == PolicyRoundRobin;
+        int64_t minPriority, maxPriority;
+        GetPriorityRange(policy, &minPriority, &maxPriority);
+        if (priority < minPriority || priority > maxPriority)
+            return IPX_CAM_ERR_INVALID_ARGUMENT;
+
+#ifdef _WIN32
+        int winPriority = realtime ? THREAD_PRIORITY_TIME_CRITICAL
+            : static_cast<int>(-std::max<int64_t>(-2, std::min<int64_t>(2, priority / 5)));
+        HANDLE thread = OpenThread(THREAD_SET_INFORMATION, FALSE, static_cast<DWORD>(threadId));
+        bool ok = thread && SetThreadPriority(thread, winPriority);
+        if (thread)
+            CloseHandle(thread);
+        if (!ok && error)
+            *error = "SetThreadPriority failed";
+        return ok ? IPX_CAM_ERR_OK : IPX_CAM_ERR_INVALID_STATE;
+#else
+        sched_param param;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = realtime ? static_cast<int>(priority) : 0;
+        const int sysPolicy = policy == PolicyFifo ? SCHED_FIFO : (policy == PolicyRoundRobin ? SCHED_RR : SCHED_OTHER);
+        if (sched_setscheduler(static_cast<pid_t>(threadId), sysPolicy, &param) != 0)
+        {
+            if (error)
+                *error = std::string("sched_setscheduler: ") + strerror(errno);
+            return IPX_CAM_ERR_INVALID_STATE;
+        }
+        // the nice value of the thread, Linux applies it per thread ID
+        if (!realtime && setpriority(PRIO_PROCESS, static_cast<id_t>(threadId), static_cast<int>(priority)) != 0)
+        {
+            if (error)
+                *error = std::string("setpriority: ") + strerror(errno);
+            return IPX_CAM_ERR_INVALID_STATE;
+        }
+        return IPX_CAM_ERR_OK;
+#endif
+    }
+
+} // end of namespace IpxCamThread
+
+#endif // __cplusplus
+
+#endif // IPX_THREAD_CONTROL_H
@@ -0,0 +1,851 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Imaging API SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxToolsImpl.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Helpers for the header-only implementations of IpxTools components
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _IPX_TOOLS_IMPL_H_
+#define _IPX_TOOLS_IMPL_H_
+
+#include "IpxImage.h"
+#include "IpxToolsBase.h"
+
+#ifdef __cplusplus
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cinttypes>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <exception>
+#include <system_error>
+#include <condition_variable>
+
+// Per-function instruction set selection, the SIMD kernels are compiled for the target ISA
+// and called only after the run-time check, so the rest of the application keeps the baseline flags
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#define IPX_TOOLS_X86_DISPATCH 1
+	#define IPX_TARGET_SSE41	__attribute__((target("sse4.1")))
+	#define IPX_TARGET_AVX2		__attribute__((target("avx2")))
+	#define IPX_TARGET_AVX512	__attribute__((target("avx512f,avx512bw")))
+	#define IPX_FORCE_INLINE	inline __attribute__((always_inline))
+	#include <immintrin.h>
+#else
+	#define IPX_TOOLS_X86_DISPATCH 0
+	#define IPX_FORCE_INLINE	inline
+#endif
+
+/*! \namespace IpxToolsImpl
+	\brief A namespace provides the building blocks of the header-only IpxTools components.
+
+	\details ParamComponent implements the IpxComponent parameter interface for the integer parameters, so the component
+	only declares its parameters and reads the values. GetCpuIsa returns the instruction set level of the CPU used by the
+	run-time dispatch of the SIMD kernels. WorkerPool runs the tasks of a conversion on the persistent threads.
+*/
+namespace IpxToolsImpl
+{
+	//! Instruction set levels of the SIMD kernels
+	enum CpuIsa
+	{
+		IsaScalar = 1,	/*!< Portable C++ code */
+		IsaSse41 = 2,	/*!< SSE4.1, 128-bit vectors */
+		IsaAvx2 = 3,	/*!< AVX2, 256-bit vectors */
+		IsaAvx512 = 4	/*!< AVX-512 F and BW, 512-bit vectors */
+	};
+
+	//! Returns the highest instruction set level supported by the CPU and the operating system
+	inline int GetCpuIsa()
+	{
+#if IPX_TOOLS_X86_DISPATCH
+		static const int isa = []
+		{
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+				return static_cast<int>(IsaAvx512);
+			if (__builtin_cpu_supports("avx2"))
+				return static_cast<int>(IsaAvx2);
+			if (__builtin_cpu_supports("sse4.1"))
+				return static_cast<int>(IsaSse41);
+			return static_cast<int>(IsaScalar);
+		}();
+		return isa;
+#else
+		return IsaScalar;
+#endif
+	}
+
+	//! Returns the name of the instruction set level
+	inline const char* GetIsaName( int isa )
+	{
+		switch (isa)
+		{
+		case IsaSse41: return "SSE4.1";
+		case IsaAvx2: return "AVX2";
+		case IsaAvx512: return "AVX-512";
+		default: return "Scalar";
+		}
+	}
+
+	/**
+	\brief Implementation of IpxComponent for the components with the integer parameters
+	\details The derived class declares the parameters with AddParamInt and reads them with GetInt. OnSetParamInt is
+	called before the new value is stored and can reject it. The string, bool and the AsString methods are mapped to the
+	integer parameters, the float, array and command methods return IPX_ERR_NOT_SUPPORTED. The components with the SIMD
+	kernels declare the pair of the instruction set parameters with AddIsaParams and read the level with GetIsa.
+	*/
+	class ParamComponent : public IpxComponent
+	{
+	public:
+		explicit ParamComponent( uint8_t typeId ) : m_typeId(typeId) {}
+
+		uint8_t GetComponentTypeID() override { return m_typeId; }
+
+		size_t GetParamCount() override { return m_params.size(); }
+
+		IpxError GetParamName( uint32_t index, char* name, uint32_t* size ) override
+		{
+			if (index >= m_params.size())
+				return Error(IPX_ERR_OUT_OF_RANGE);
+			return CopyString(m_params[index].name, name, size);
+		}
+
+		IpxError GetParamAsString( const char* name, char* param, uint32_t* size, const char *format=nullptr ) override
+		{
+			int64_t value = 0;
+			IpxError err = GetParamInt(name, &value);
+			if (err != IPX_ERR_OK)
+				return err;
+			char text[32];
+			snprintf(text, sizeof(text), format ? format : "%" PRIi64, value);
+			return CopyString(text, param, size);
+		}
+
+		IpxError SetParamAsString( const char* name, char* param ) override
+		{
+			if (!param)
+				return Error(IPX_ERR_NULL_POINTER);
+			char *end = nullptr;
+			int64_t value = strtoll(param, &end, 0);
+			if (end == param || *end)
+				return Error(IPX_ERR_INVALID_ARGUMENT);
+			return SetParamInt(name, value);
+		}
+
+		IpxError SetParamBool( const char* name, bool param ) override { return SetParamInt(name, param ? 1 : 0); }
+
+		IpxError SetParamInt( const char* name, int64_t param ) override
+		{
+			Param *p = Find(name);
+			if (!p)
+				return Error(IPX_ERR_INVALID_ARGUMENT);
+			if (p->readOnly)
+				return Error(IPX_ERR_ACCESS_DENIED);
+			if (param < p->min || param > p->max)
+				return Error(IPX_ERR_OUT_OF_RANGE);
+			const size_t index = static_cast<size_t>(p - m_params.data());
+			IpxError err = index == m_forceIsa ? ForceIsa(param) : OnSetParamInt(index, param);
+			if (err == IPX_ERR_OK)
+				p->value = param;
+			return err;
+		}
+
+		IpxError SetParamFloat( const char*, double ) override { return Error(IPX_ERR_NOT_SUPPORTED); }
+		IpxError SetParamString( const char* name, char* param ) override { return SetParamAsString(name, param); }
+		IpxError SetParamArray( const char*, void*, uint32_t ) override { return Error(IPX_ERR_NOT_SUPPORTED); }
+
+		IpxError GetParamBool( const char* name, bool* param ) override
+		{
+			int64_t value = 0;
+			IpxError err = GetParamInt(name, &value);
+			if (err == IPX_ERR_OK && param)
+				*param = value != 0;
+			return err;
+		}
+
+		IpxError GetParamInt( const char* name, int64_t* param ) override
+		{
+			Param *p = Find(name);
+			if (!p)
+				return Error(IPX_ERR_INVALID_ARGUMENT);
+			if (!param)
+				return Error(IPX_ERR_NULL_POINTER);
+			*param = OnGetParamInt(static_cast<size_t>(p - m_params.data()), p->value);
+			return IPX_ERR_OK;
+		}
+
+		IpxError GetParamFloat( const char*, double* ) override { return Error(IPX_ERR_NOT_SUPPORTED); }
+		IpxError GetParamString( const char* name, char* param, uint32_t* size ) override { return GetParamAsString(name, param, size); }
+		IpxError GetParamArray( const char*, void*, uint32_t* ) override { return Error(IPX_ERR_NOT_SUPPORTED); }
+		IpxError RunCommand( const char* ) override { return Error(IPX_ERR_NOT_SUPPORTED); }
+
+		//! Returns the instruction set level of the kernels, IpxToolsImpl::CpuIsa
+		int GetIsa() const { return m_activeIsa < m_params.size() ? static_cast<int>(GetInt(m_activeIsa)) : GetCpuIsa(); }
+
+	protected:
+		//! Declares the integer parameter, returns its index for GetInt
+		size_t AddParamInt( const char* name, int64_t value, int64_t min, int64_t max, bool readOnly = false )
+		{
+			Param p;
+			p.name = name;
+			p.value = value;
+			p.min = min;
+			p.max = max;
+			p.readOnly = readOnly;
+			m_params.push_back(p);
+			return m_params.size() - 1;
+		}
+
+		//! Declares the parameters of the instruction set of the kernels
+		/*!
+		\param[in] force the level set by the application, 0 - the level of the CPU, the higher level than the CPU one is
+			rejected with IPX_ERR_NOT_SUPPORTED
+		\param[in] active the read-only level used by the kernels
+		*/
+		void AddIsaParams( const char* force, const char* active )
+		{
+			m_forceIsa = AddParamInt(force, 0, 0, IsaAvx512);
+			m_activeIsa = AddParamInt(active, GetCpuIsa(), IsaScalar, IsaAvx512, true);
+		}
+
+		//! Returns the current value of the parameter by its index
+		int64_t GetInt( size_t index ) const { return m_params[index].value; }
+
+		//! Stores the value of the parameter bypassing the range and the read-only checks
+		void SetInt( size_t index, int64_t value ) { m_params[index].value = value; }
+
+		//! Validates the new value of the parameter, the value is stored if IPX_ERR_OK is returned
+		virtual IpxError OnSetParamInt( size_t, int64_t ) { return IPX_ERR_OK; }
+
+		//! Returns the value reported by GetParamInt, the read-only status parameters override it
+		virtual int64_t OnGetParamInt( size_t, int64_t value ) { return value; }
+
+		//! Returns the error code of the component
+		IpxError Error( uint32_t code ) const { return IPX_ERR(m_typeId, code); }
+
+	private:
+		struct Param
+		{
+			std::string name;
+			int64_t value;
+			int64_t min;
+			int64_t max;
+			bool readOnly;
+		};
+
+		Param* Find( const char* name )
+		{
+			if (!name)
+				return nullptr;
+			for (auto &p : m_params)
+			{
+				if (p.name == name)
+					return &p;
+			}
+			return nullptr;
+		}
+
+		IpxError ForceIsa( int64_t isa )
+		{
+			if (isa > GetCpuIsa())
+				return Error(IPX_ERR_NOT_SUPPORTED);
+			SetInt(m_activeIsa, isa ? isa : GetCpuIsa());
+			return IPX_ERR_OK;
+		}
+
+		IpxError CopyString( const std::string &text, char* dst, uint32_t* size ) const
+		{
+			if (!size)
+				return Error(IPX_ERR_NULL_POINTER);
+			const uint32_t required = static_cast<uint32_t>(text.size() + 1);
+			if (!dst || *size < required)
+			{
+				*size = required;
+				return Error(IPX_ERR_BUFFER_TOO_SMALL);
+			}
+			memcpy(dst, text.c_str(), required);
+			*size = required;
+			return IPX_ERR_OK;
+		}
+
+		uint8_t m_typeId;
+		std::vector<Param> m_params;
+		size_t m_forceIsa = SIZE_MAX;	// the indices of the parameters of AddIsaParams
+		size_t m_activeIsa = SIZE_MAX;
+	};
+
+	/**
+	\brief The parameter value passed by a wrapping component to the components it owns
+	\details The wrapper keeps the values in ParamLog and sets them to the owned components created later.
+	*/
+	struct ParamSetting
+	{
+		enum Type { Int, Float, String, AsString, Array };
+
+		ParamSetting( const char* n, int64_t value ) : name(n ? n : ""), type(Int), integer(value), real(0) {}
+
+		//! Sets the value to the component with the setter of the type
+		IpxError Apply( IpxComponent *c ) const
+		{
+			switch (type)
+			{
+			case Float: return c->SetParamFloat(name.c_str(), real);
+			case String: return c->SetParamString(name.c_str(), const_cast<char*>(text.c_str()));
+			case AsString: return c->SetParamAsString(name.c_str(), const_cast<char*>(text.c_str()));
+			case Array: return c->SetParamArray(name.c_str(), const_cast<uint8_t*>(data.data()), static_cast<uint32_t>(data.size()));
+			default: return c->SetParamInt(name.c_str(), integer);
+			}
+		}
+
+		std::string name;
+		Type type;
+		int64_t integer;
+		double real;
+		std::string text;
+		std::vector<uint8_t> data;
+	};
+
+	//! The parameter values passed so far in the order of the calls, the last value of the name wins
+	class ParamLog
+	{
+	public:
+		//! Stores the value, returns false if the memory is not available
+		bool Store( const ParamSetting &s )
+		{
+			try
+			{
+				for (auto it = m_settings.begin(); it != m_settings.end(); ++it)
+				{
+					if (it->name == s.name)
+					{
+						m_settings.erase(it);
+						break;
+					}
+				}
+				m_settings.push_back(s);
+			}
+			catch (const std::bad_alloc&)
+			{
+				return false;
+			}
+			return true;
+		}
+
+		//! Sets all the stored values to the component, stops on the first error
+		IpxError Apply( IpxComponent *c ) const
+		{
+			for (const ParamSetting &s : m_settings)
+			{
+				const IpxError err = s.Apply(c);
+				if (err != IPX_ERR_OK)
+					return err;
+			}
+			return IPX_ERR_OK;
+		}
+
+	private:
+		std::vector<ParamSetting> m_settings;
+	};
+
+	/**
+	\brief Implementation of IpxComponent for the components wrapping the components of the library
+	\details The parameters declared by AddParamInt are the own parameters of the wrapper. The values of the other
+	parameters are set to the target component returned by GetTarget and to the other owned components visited by
+	ForEachOther, and are kept in the log for the components created later; the getters and the parameter names of the
+	target follow the own ones.
+	*/
+	class ForwardingComponent : public ParamComponent
+	{
+	public:
+		explicit ForwardingComponent( uint8_t typeId ) : ParamComponent(typeId) {}
+
+		size_t GetParamCount() override
+		{
+			IpxComponent *target = GetTarget();
+			return GetOwnCount() + (target ? target->GetParamCount() : 0);
+		}
+
+		IpxError GetParamName( uint32_t index, char* name, uint32_t* size ) override
+		{
+			if (index < GetOwnCount() || !GetTarget())
+				return ParamComponent::GetParamName(index, name, size);
+			return GetTarget()->GetParamName(static_cast<uint32_t>(index - GetOwnCount()), name, size);
+		}
+
+		IpxError SetParamInt( const char* name, int64_t param ) override
+		{
+			if (IsOwn(name))
+				return ParamComponent::SetParamInt(name, param);
+			return Forward(ParamSetting(name, param));
+		}
+
+		IpxError SetParamBool( const char* name, bool param ) override { return SetParamInt(name, param ? 1 : 0); }
+
+		IpxError SetParamFloat( const char* name, double param ) override
+		{
+			ParamSetting s(name, 0);
+			s.type = ParamSetting::Float;
+			s.real = param;
+			return Forward(s);
+		}
+
+		IpxError SetParamString( const char* name, char* param ) override
+		{
+			if (IsOwn(name))
+				return ParamComponent::SetParamString(name, param);
+			if (!param)
+				return Error(IPX_ERR_NULL_POINTER);
+			ParamSetting s(name, 0);
+			s.type = ParamSetting::String;
+			s.text = param;
+			return Forward(s);
+		}
+
+		IpxError SetParamAsString( const char* name, char* param ) override
+		{
+			if (IsOwn(name))
+				return ParamComponent::SetParamAsString(name, param);
+			if (!param)
+				return Error(IPX_ERR_NULL_POINTER);
+			ParamSetting s(name, 0);
+			s.type = ParamSetting::AsString;
+			s.text = param;
+			return Forward(s);
+		}
+
+		IpxError SetParamArray( const char* name, void* param, uint32_t size ) override
+		{
+			if (!param)
+				return Error(IPX_ERR_NULL_POINTER);
+			ParamSetting s(name, 0);
+			s.type = ParamSetting::Array;
+			s.data.assign(static_cast<const uint8_t*>(param), static_cast<const uint8_t*>(param) + size);
+			return Forward(s);
+		}
+
+		IpxError RunCommand( const char* name ) override
+		{
+			IpxComponent *target = GetTarget();
+			if (!target)
+				return Error(IPX_ERR_NOT_SUPPORTED);
+			OnForward();
+			IpxError err = target->RunCommand(name);
+			if (err == IPX_ERR_OK)
+				err = ForEachOther([name]( IpxComponent *c ) { return c->RunCommand(name); });
+			OnForwarded();
+			return err;
+		}
+
+		IpxError GetParamInt( const char* name, int64_t* param ) override
+		{
+			if (IsOwn(name) || !GetTarget())
+				return ParamComponent::GetParamInt(name, param);
+			return GetTarget()->GetParamInt(name, param);
+		}
+
+		IpxError GetParamBool( const char* name, bool* param ) override
+		{
+			if (IsOwn(name) || !GetTarget())
+				return ParamComponent::GetParamBool(name, param);
+			return GetTarget()->GetParamBool(name, param);
+		}
+
+		IpxError GetParamFloat( const char* name, double* param ) override
+		{
+			if (!GetTarget())
+				return ParamComponent::GetParamFloat(name, param);
+			return GetTarget()->GetParamFloat(name, param);
+		}
+
+		IpxError GetParamString( const char* name, char* param, uint32_t* size ) override
+		{
+			if (IsOwn(name) || !GetTarget())
+				return ParamComponent::GetParamString(name, param, size);
+			return GetTarget()->GetParamString(name, param, size);
+		}
+
+		IpxError GetParamAsString( const char* name, char* param, uint32_t* size, const char *format=nullptr ) override
+		{
+			if (IsOwn(name) || !GetTarget())
+				return ParamComponent::GetParamAsString(name, param, size, format);
+			return GetTarget()->GetParamAsString(name, param, size, format);
+		}
+
+		IpxError GetParamArray( const char* name, void* param, uint32_t* size ) override
+		{
+			if (!GetTarget())
+				return ParamComponent::GetParamArray(name, param, size);
+			return GetTarget()->GetParamArray(name, param, size);
+		}
+
+		//! Sets the values passed so far to the component created by the wrapper
+		IpxError ApplyLog( IpxComponent *c ) const { return m_log.Apply(c); }
+
+	protected:
+		//! Returns the component answering the getters of the forwarded parameters, nullptr if it was not created
+		virtual IpxComponent* GetTarget() = 0;
+
+		//! Calls fn for the owned components other than the target, stops on the first error
+		virtual IpxError ForEachOther( const std::function<IpxError( IpxComponent* )> &fn ) = 0;
+
+		//! Called before the value or the command is passed to the owned components, for example to wait until they are idle
+		virtual void OnForward() {}
+
+		//! Called after the value or the command was passed, also if it failed
+		virtual void OnForwarded() {}
+
+		//! Returns true for the own parameter
+		bool IsOwn( const char* name )
+		{
+			int64_t value;
+			return name && ParamComponent::GetParamInt(name, &value) == IPX_ERR_OK;
+		}
+
+		//! Sets the value to all the owned components, the value rejected by the target is not passed to the others
+		IpxError Forward( const ParamSetting &s )
+		{
+			if (s.name.empty())
+				return Error(IPX_ERR_INVALID_ARGUMENT);
+			if (IsOwn(s.name.c_str()))
+				return Error(IPX_ERR_NOT_SUPPORTED);
+			IpxComponent *target = GetTarget();
+			if (!target)
+				return Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+			OnForward();
+			IpxError err = s.Apply(target);
+			if (err == IPX_ERR_OK)
+				err = ForEachOther([&s]( IpxComponent *c ) { return s.Apply(c); });
+			if (err == IPX_ERR_OK && !m_log.Store(s))
+				err = Error(IPX_ERR_NOT_ENOUGH_MEMORY);
+			OnForwarded();
+			return err;
+		}
+
+	private:
+		size_t GetOwnCount() { return ParamComponent::GetParamCount(); }
+
+		ParamLog m_log;
+	};
+
+	/**
+	\brief Persistent threads executing the tasks of the parallel loops
+	\details The threads are created once and wait for the work, Run does not create threads. The calling thread of Run
+	executes the tasks too, so the pool for N threads starts N - 1 threads. The tasks are taken in order by the free
+	threads, so the unequal tasks are balanced. Several threads can call Run at the same time, the jobs are served in
+	the order of the calls, so the components of several cameras can share one pool returned by GetShared instead of
+	starting the threads for every CPU each.
+	*/
+	class WorkerPool
+	{
+	public:
+		//! The task function, task is the index of the task, worker is 0 for the calling thread and 1...N for the pool threads
+		typedef std::function<void( int task, int worker )> TaskFn;
+
+		//! Creates the pool
+		/*!
+		\param[in] threads total number of the threads used by Run including the calling thread, 0 - the number of CPUs
+		*/
+		explicit WorkerPool( int threads = 0 ) { Start(threads); }
+
+		~WorkerPool() { Stop(); }
+
+		WorkerPool( const WorkerPool& ) = delete;
+		WorkerPool& operator=( const WorkerPool& ) = delete;
+
+		//! Returns the number of the threads used by Run including the calling thread
+		int GetNumThreads() const { return static_cast<int>(m_threads.size()) + 1; }
+
+		//! Returns the number of CPUs, at least 1
+		static int GetNumCpus()
+		{
+			const unsigned n = std::thread::hardware_concurrency();
+			return n ? static_cast<int>(n) : 1;
+		}
+
+		//! Returns the pool for the number of CPUs shared by the components of the process
+		/*!
+		The pool is created by the first call and deleted when the last reference is released.
+		*/
+		static std::shared_ptr<WorkerPool> GetShared()
+		{
+			static std::mutex mutex;
+			static std::weak_ptr<WorkerPool> shared;
+			std::lock_guard<std::mutex> lock(mutex);
+			std::shared_ptr<WorkerPool> pool = shared.lock();
+			if (!pool)
+			{
+				pool = std::make_shared<WorkerPool>();
+				shared = pool;
+			}
+			return pool;
+		}
+
+		//! Runs the tasks 0...tasks-1 and returns when all of them are done
+		/*!
+		\param[in] tasks number of the tasks
+		\param[in] fn the task function
+		\param[in] maxThreads limits the number of the threads used by this call including the calling thread, 0 - all
+
+		The exception of a task skips the tasks not started yet and is rethrown when all the threads have left the job,
+		the first one if several tasks fail.
+		*/
+		void Run( int tasks, const TaskFn &fn, int maxThreads = 0 )
+		{
+			if (tasks <= 0)
+				return;
+			int helpers = static_cast<int>(m_threads.size());
+			if (maxThreads > 0)
+				helpers = std::min(helpers, maxThreads - 1);
+			helpers = std::min(helpers, tasks - 1);
+
+			Job job(fn, tasks, helpers);
+			if (helpers > 0)
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_jobs.push_back(&job);
+				m_cv.notify_all();
+			}
+			Work(job, 0);
+			if (helpers > 0)
+			{
+				// the job lives on this stack, so wait until no pool thread refers to it
+				std::unique_lock<std::mutex> lock(m_mutex);
+				Remove(&job);
+				m_doneCv.wait(lock, [&job]{ return job.active == 0; });
+			}
+			if (job.error)
+				std::rethrow_exception(job.error);
+		}
+
+	private:
+		struct Job
+		{
+			Job( const TaskFn &f, int n, int h ) : fn(f), tasks(n), helpers(h), next(0), active(0) {}
+
+			const TaskFn &fn;
+			const int tasks;
+			const int helpers;			// pool threads allowed to join the job
+			std::atomic<int> next;		// next task to take
+			int active;					// pool threads working on the job, guarded by the mutex
+			std::mutex errorMutex;
+			std::exception_ptr error;	// the first exception of the tasks
+		};
+
+		void Start( int threads )
+		{
+			const int total = threads > 0 ? threads : GetNumCpus();
+			m_stop = false;
+			for (int i = 1; i < total; ++i)
+			{
+				try
+				{
+					m_threads.emplace_back(&WorkerPool::Thread, this, i);
+				}
+				catch (const std::system_error&)
+				{
+					break;	// run with the threads created so far
+				}
+			}
+		}
+
+		void Stop()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_stop = true;
+				m_cv.notify_all();
+			}
+			for (auto &t : m_threads)
+				t.join();
+			m_threads.clear();
+		}
+
+		static void Work( Job &job, int worker )
+		{
+			for (int task = job.next++; task < job.tasks; task = job.next++)
+			{
+				try
+				{
+					job.fn(task, worker);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(job.errorMutex);
+					if (!job.error)
+						job.error = std::current_exception();
+					job.next = job.tasks;
+				}
+			}
+		}
+
+		// the first job with the free tasks and the free helper slot, called under the mutex
+		Job* Find()
+		{
+			for (Job *job : m_jobs)
+			{
+				if (job->next.load() < job->tasks && job->active < job->helpers)
+					return job;
+			}
+			return nullptr;
+		}
+
+		void Remove( Job *job )
+		{
+			for (auto it = m_jobs.begin(); it != m_jobs.end(); ++it)
+			{
+				if (*it == job)
+				{
+					m_jobs.erase(it);
+					break;
+				}
+			}
+		}
+
+		void Thread( int worker )
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			for (;;)
+			{
+				Job *job = nullptr;
+				m_cv.wait(lock, [this, &job]{ return m_stop || (job = Find()) != nullptr; });
+				if (!job)
+					return;
+				++job->active;
+				lock.unlock();
+				Work(*job, worker);
+				lock.lock();
+				// all the tasks are taken, the remaining threads do not need the job
+				Remove(job);
+				if (--job->active == 0)
+					m_doneCv.notify_all();
+			}
+		}
+
+		std::vector<std::thread> m_threads;
+		std::deque<Job*> m_jobs;
+		std::mutex m_mutex;
+		std::condition_variable m_cv;
+		std::condition_variable m_doneCv;
+		bool m_stop;
+	};
+
+	/**
+	\brief Worker pool of the component converting the image by the stripes of the rows
+	\details The pool is the one set by SetWorkerPool, the shared pool of the process or the own pool of the component.
+	The own pool grows with the number of the threads, the smaller number is set per call. RunStripes keeps the
+	reference to the pool, so the shared pool lives as long as the component.
+	*/
+	class ComponentPool
+	{
+	public:
+		//! Sets the pool of the component, nullptr - the shared or the own pool
+		void SetWorkerPool( const std::shared_ptr<WorkerPool> &pool ) { m_userPool = pool; }
+
+		//! Returns the pool of the component, the own pool is created if it is needed
+		/*!
+		\param[in] shared the shared pool of the process is selected
+		\param[in] threads the number of the threads of a call, 0 - the number of CPUs
+		*/
+		std::shared_ptr<WorkerPool> GetWorkerPool( bool shared, int threads )
+		{
+			if (m_userPool)
+				return m_userPool;
+			if (shared)
+				return WorkerPool::GetShared();
+
+			threads = GetThreads(threads);
+			if (!m_ownPool || m_ownPool->GetNumThreads() < threads)
+			{
+				m_ownPool.reset();
+				m_ownPool = std::make_shared<WorkerPool>(threads);
+			}
+			return m_ownPool;
+		}
+
+		//! Returns the pool selected now without creating it, nullptr - the own pool is not created
+		std::shared_ptr<WorkerPool> GetCurrentPool( bool shared ) const
+		{
+			if (m_userPool)
+				return m_userPool;
+			return shared ? WorkerPool::GetShared() : m_ownPool;
+		}
+
+		//! Returns the number of the threads of a call including the calling one, 0 - the number of CPUs
+		static int GetThreads( int threads ) { return threads > 0 ? threads : WorkerPool::GetNumCpus(); }
+
+		//! Converts the rows 0...height-1 by the stripes on the pool
+		/*!
+		\param[in] shared the shared pool of the process is selected
+		\param[in] threads the number of the threads of the call, 0 - the number of CPUs
+		\param[in] height the number of the rows
+		\param[in,out] scratch the memory of each worker, 0 - the calling thread, resized to the workers of the pool
+		\param[in] getRows returns the rows of the stripe for the number of the threads used by the call
+		\param[in] convert converts the rows y0...y1-1 with the memory of the worker
+		*/
+		template<typename Scratch, typename GetRows, typename Convert>
+		void RunStripes( bool shared, int threads, int height, std::vector<Scratch> &scratch, GetRows getRows, Convert convert )
+		{
+			threads = GetThreads(threads);
+			m_pool = GetWorkerPool(shared, threads);
+			if (scratch.size() < static_cast<size_t>(m_pool->GetNumThreads()))
+				scratch.resize(m_pool->GetNumThreads());
+
+			threads = std::min(threads, m_pool->GetNumThreads());
+			const int rows = getRows(threads);
+			const int stripes = (height + rows - 1) / rows;
+			m_pool->Run(stripes, [&]( int stripe, int worker )
+			{
+				const int y0 = stripe * rows;
+				convert(y0, std::min(height, y0 + rows), scratch[worker]);
+			}, threads);
+		}
+
+	private:
+		std::shared_ptr<WorkerPool> m_pool;		// the pool used by the conversions
+		std::shared_ptr<WorkerPool> m_ownPool;	// created by the component, unless the pool is shared
+		std::shared_ptr<WorkerPool> m_userPool;	// set by SetWorkerPool
+	};
+
+	//! Fills the image header for the data owned by the component
+	/*!
+	\param[out] image the image header
+	\param[in] pixelType pixel type of the image
+	\param[in] width width in pixels
+	\param[in] height height in pixels
+	\param[in,out] storage the memory of the image data, resized if the image does not fit
+	\return Returns false for the unknown pixel type
+	*/
+	inline bool InitOwnedImage( IpxImage* image, uint32_t pixelType, uint32_t width, uint32_t height, std::vector<uint64_t> &storage )
+	{
+		if (!IpxInitPixelTypeDescr(pixelType, &image->pixelTypeDescr))
+			return false;
+		image->width = width;
+		image->height = height;
+		image->rowSize = IpxGetRowSize(pixelType, width);
+		image->imageSize = image->rowSize * height;
+		if (storage.size() * sizeof(uint64_t) < image->imageSize)
+			storage.resize((image->imageSize + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+		image->imageData = reinterpret_cast<char*>(storage.data());
+		image->imageDataOrigin = nullptr;
+		return true;
+	}
+
+} // end of namespace IpxToolsImpl
+
+#endif // __cplusplus
+
+#endif // _IPX_TOOLS_IMPL_H_
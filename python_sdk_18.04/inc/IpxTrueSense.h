@@ -315,6 +315,30 @@
 #define TS_LOW_LUMA_NOISE	"lowLumaNoise"	/*!< Low Noise threshold \n\n<b>Type/Range</b>    [float: DBL_MIN-DBL_MAX]\note Used by SetParamFloat and GetParamFloat*/
 /*! @}*/
 
+/*! \addtogroup ts_10 TS Stripe Parameters
+ *  \brief Defines for the parameters of IpxTrueSenseStriped
+ *  @{
+<table>
+        <caption id="truesense_stripe_params">TS Stripe Parameters</caption>
+		<tr><th>Macro<th>Parameter Name<th>Type<th>Description
+		<tr><td rowspan="1"><b>TS_SHARED_POOL</b><td>"shared_pool"<td>[int: 0,1]<td>Use the worker threads shared by all the components of the process instead of the own threads
+		<tr><td rowspan="1"><b>TS_STRIPE_ROWS</b><td>"stripeRows"<td>[int: 0-65536]<td>Rows of the stripe, a multiple of 4. 0 - selected by the image height and TS_THREADS_NUM
+		<tr><td rowspan="1"><b>TS_STRIPE_HALO</b><td>"stripeHalo"<td>[int: 0-256]<td>Rows converted above and below the stripe and dropped, a multiple of 4. Default value is 16
+		<tr><td rowspan="1"><b>TS_TIME_TOTAL</b><td>"timeTotalUs"<td>[int: read-only]<td>Microseconds of the last ConvertImage
+		<tr><td rowspan="1"><b>TS_TIME_CONVERT</b><td>"timeConvertUs"<td>[int: read-only]<td>Microseconds of the TrueSense passes of all the stripes of the last frame, summed over the threads
+		<tr><td rowspan="1"><b>TS_TIME_STRIPE_MAX</b><td>"timeStripeMaxUs"<td>[int: read-only]<td>Microseconds of the slowest stripe of the last frame
+		<tr><td rowspan="1"><b>TS_TIME_COPY</b><td>"timeCopyUs"<td>[int: read-only]<td>Microseconds of copying the stripes to the output of the last frame, summed over the threads
+</table>*/
+
+#define TS_SHARED_POOL		"shared_pool"		/*!< Use the worker threads shared by all the components of the process instead of the own threads\n\n<b>Type/Range</b>    [int: 0,1]\note Used by SetParamInt and GetParamInt of IpxTrueSenseStriped*/
+#define TS_STRIPE_ROWS		"stripeRows"		/*!< Rows of the stripe, a multiple of 4, 0 - automatic\n\n<b>Type/Range</b>    [int: 0-65536]\note Used by SetParamInt and GetParamInt of IpxTrueSenseStriped*/
+#define TS_STRIPE_HALO		"stripeHalo"		/*!< Rows converted above and below the stripe and dropped, a multiple of 4\n\n<b>Type/Range</b>    [int: 0-256]\note Used by SetParamInt and GetParamInt of IpxTrueSenseStriped*/
+#define TS_TIME_TOTAL		"timeTotalUs"		/*!< Microseconds of the last ConvertImage\n\n<b>Type/Range</b>    [int: read-only]\note Used by GetParamInt of IpxTrueSenseStriped*/
+#define TS_TIME_CONVERT		"timeConvertUs"		/*!< Microseconds of the TrueSense passes of the last frame summed over the threads\n\n<b>Type/Range</b>    [int: read-only]\note Used by GetParamInt of IpxTrueSenseStriped*/
+#define TS_TIME_STRIPE_MAX	"timeStripeMaxUs"	/*!< Microseconds of the slowest stripe of the last frame\n\n<b>Type/Range</b>    [int: read-only]\note Used by GetParamInt of IpxTrueSenseStriped*/
+#define TS_TIME_COPY		"timeCopyUs"		/*!< Microseconds of copying the stripes to the output of the last frame summed over the threads\n\n<b>Type/Range</b>    [int: read-only]\note Used by GetParamInt of IpxTrueSenseStriped*/
+/*! @}*/
+
 #ifdef __cplusplus
 /*! \addtogroup Class_IpxTrueSense IpxTrueSense C++ Class
  * \brief C++ Class for IpxTrueSense
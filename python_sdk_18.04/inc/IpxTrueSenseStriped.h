@@ -0,0 +1,426 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Imaging API SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxTrueSenseStriped.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Header-only IpxTrueSense running the stripes of the image on the worker pool
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _IPX_TRUE_SENSE_STRIPED_H_
+#define _IPX_TRUE_SENSE_STRIPED_H_
+
+#include "IpxTrueSense.h"
+#include "IpxToolsImpl.h"
+
+#ifdef __cplusplus
+
+#include <cstring>
+#include <climits>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <new>
+
+/*!
+\brief IpxTrueSense converting the horizontal stripes of the image on the worker pool
+\details Every thread of IpxTrueSense::ConvertImage starts its own threads, so several KAC cameras start the threads
+for every CPU each, and the image memory of the passes is allocated by the conversion. This component converts the
+stripes of the image by the IpxTrueSense instances of the worker pool, one instance per pool thread with
+TS_THREADS_NUM = 1, so the cameras sharing the pool (TS_SHARED_POOL or SetWorkerPool) use as many threads as the pool.
+
+Every stripe is converted with TS_STRIPE_HALO rows above and below it, which are dropped, so the filters see the same
+neighbours as in the full image if their radius does not exceed the halo; all the stripe views have the same size and
+start at the rows of the 4x4 CFA phase. The outputs of the stripes are the scratch images allocated by AllocData, one
+per pool thread, and are reused by the next frames of the same size: ConvertImage does not allocate the memory, unless
+the size or the type changes, and with TS_NOREALLOC it fails with IPX_ERR_TS_NO_MEMORY instead.
+
+The image is converted as a whole by one IpxTrueSense with TS_THREADS_NUM threads if the height is not a multiple
+of 4, the stripes would not be shorter than the image or TS_NORM_EN is on, since the normalization uses the statistics
+of the whole image.
+
+The passes of IpxTrueSense are not visible from outside the library, so TS_TIME_CONVERT reports the time of all the
+passes of the frame and TS_TIME_STRIPE_MAX the slowest stripe; comparing them with TS_IMP_FILTER_ENABLED and
+TS_SHARPNESS_ENABLED off and on shows the cost of each filter. The other parameters are passed to all the instances.
+\code
+IpxTrueSenseStriped *ts = IpxTrueSenseStriped::CreateComponent();
+ts->GetComponent()->SetParamInt(TS_SHARED_POOL, 1);		// one pool for all the cameras
+ts->GetComponent()->SetParamInt(TS_THREADS_NUM, 4);		// at most 4 threads for each frame
+ts->GetComponent()->SetParamInt(TS_IMP_FILTER_ENABLED, 1);
+
+IpxImage rgb;
+IpxInitImageHeader(&rgb, IpxSize(0, 0), II_PIX_RGB8, nullptr, 0, 0);
+ts->AllocData(raw, &rgb);									// the output and the scratch images of the threads
+IpxError err = ts->ConvertImage(raw, &rgb);
+
+int64_t total = 0, passes = 0;
+ts->GetComponent()->GetParamInt(TS_TIME_TOTAL, &total);
+ts->GetComponent()->GetParamInt(TS_TIME_CONVERT, &passes);
+...
+IpxTrueSenseStriped::DeleteComponent(ts);
+\endcode
+*/
+class IpxTrueSenseStriped final : public IpxTrueSense
+{
+public:
+
+	//! Creates the component
+	static IpxTrueSenseStriped* CreateComponent() { return new IpxTrueSenseStriped(); }
+
+	//! Deletes the component and the data allocated by it
+	static void DeleteComponent( IpxTrueSenseStriped* in ) { delete in; }
+
+	IpxTrueSenseStriped() : m_component(*this), m_frame(IpxTrueSense::CreateComponent()) {}
+
+	virtual ~IpxTrueSenseStriped()
+	{
+		m_pool.reset();		// the pool threads do not use the instances after Run, release the references first
+		for (auto &w : m_workers)
+			IpxTrueSense::DeleteComponent(w.ts);
+		if (m_frame)
+			IpxTrueSense::DeleteComponent(m_frame);
+	}
+
+	IpxComponent* GetComponent() override { return &m_component; }
+
+	IpxError ConvertImage( const IpxImage* pSrc, IpxImage* pDst ) override
+	{
+		const auto start = std::chrono::steady_clock::now();
+		if (!pSrc || !pDst || !pSrc->imageData)
+			return IPX_ERR_TS_INVALID_ARGUMENT;
+		if (!m_frame)
+			return IPX_ERR_TS_NO_MEMORY;
+
+		Layout layout;
+		GetLayout(pSrc, &layout);
+		m_component.ResetTimes();
+		if (layout.stripes < 2)
+		{
+			const IpxError err = m_frame->ConvertImage(pSrc, pDst);
+			m_component.SetTimes(Elapsed(start), 0, 0, 0);
+			return err;
+		}
+
+		if (!FitsLayout(pSrc, layout, pDst))
+		{
+			if (m_component.GetNoRealloc())
+				return IPX_ERR_TS_NO_MEMORY;
+			const IpxError err = AllocData(pSrc, pDst);
+			if (err != IPX_ERR_OK)
+				return err;
+		}
+
+		std::atomic<int64_t> convertUs(0), copyUs(0), stripeMaxUs(0);
+		std::atomic<uint32_t> result(IPX_ERR_OK);
+		const size_t rowBytes = IpxGetRowSizeUnaligned(pDst->pixelTypeDescr.pixelType, pDst->width);
+		m_pool->Run(layout.stripes, [&]( int stripe, int worker )
+		{
+			const auto t0 = std::chrono::steady_clock::now();
+			Worker &w = m_workers[worker];
+			const int y0 = stripe * layout.rows, y1 = std::min(layout.height, y0 + layout.rows);
+			const int viewY = layout.GetViewY(y0);
+			IpxImage view = GetView(pSrc, viewY, layout.viewRows);
+			const IpxError err = w.ts->ConvertImage(&view, &w.scratch);
+			const auto t1 = std::chrono::steady_clock::now();
+			if (err != IPX_ERR_OK)
+			{
+				uint32_t ok = IPX_ERR_OK;
+				result.compare_exchange_strong(ok, static_cast<uint32_t>(err));
+				return;
+			}
+			for (int y = y0; y < y1; ++y)
+				memcpy(pDst->imageData + size_t(y) * pDst->rowSize, w.scratch.imageData + size_t(y - viewY) * w.scratch.rowSize, rowBytes);
+
+			const int64_t stripeUs = Elapsed(t0, t1);
+			convertUs += stripeUs;
+			copyUs += Elapsed(t1);
+			for (int64_t max = stripeMaxUs.load(); stripeUs > max && !stripeMaxUs.compare_exchange_weak(max, stripeUs); )
+				;
+		}, GetThreads());
+
+		m_component.SetTimes(Elapsed(start), convertUs.load(), stripeMaxUs.load(), copyUs.load());
+		if (result.load() != IPX_ERR_OK)
+			return static_cast<IpxError>(result.load());
+		pDst->timestamp = pSrc->timestamp;
+		pDst->imageID = pSrc->imageID;
+		return IPX_ERR_OK;
+	}
+
+	//! Allocates the destination image and the scratch images of the stripes of all the pool threads
+	/*!
+	The memory of the destination is owned by the component until ReleaseData, the scratch images are owned by the
+	IpxTrueSense instances of the threads. The pixel type of pDst selects the output type as in IpxTrueSense.
+	*/
+	IpxError AllocData( const IpxImage* pSrc, IpxImage* pDst ) override
+	{
+		if (!pSrc || !pDst)
+			return IPX_ERR_TS_INVALID_ARGUMENT;
+		if (!m_frame)
+			return IPX_ERR_TS_NO_MEMORY;
+
+		Layout layout;
+		GetLayout(pSrc, &layout);
+		if (layout.stripes < 2)
+			return m_frame->AllocData(pSrc, pDst);
+
+		m_allocated = Layout();
+		try
+		{
+			m_pool = GetWorkerPool();
+			const size_t workers = static_cast<size_t>(m_pool->GetNumThreads());
+			while (m_workers.size() < workers)
+			{
+				m_workers.push_back(Worker());
+				m_workers.back().ts = IpxTrueSense::CreateComponent();
+				if (!m_workers.back().ts)
+				{
+					m_workers.pop_back();
+					return IPX_ERR_TS_NO_MEMORY;
+				}
+				const IpxError err = m_component.Apply(m_workers.back().ts, true);
+				if (err != IPX_ERR_OK)
+					return err;
+			}
+
+			const IpxImage view = GetView(pSrc, 0, layout.viewRows);
+			for (size_t i = 0; i < workers; ++i)
+			{
+				IpxImage &scratch = m_workers[i].scratch;
+				scratch = IpxImage();
+				scratch.pixelTypeDescr.pixelType = pDst->pixelTypeDescr.pixelType;
+				const IpxError err = m_workers[i].ts->AllocData(&view, &scratch);
+				if (err != IPX_ERR_OK)
+					return err;
+			}
+			const IpxImage &scratch = m_workers[0].scratch;
+			if (!IpxToolsImpl::InitOwnedImage(pDst, scratch.pixelTypeDescr.pixelType, scratch.width, pSrc->height, m_data))
+				return IPX_ERR_TS_INVALID_ARGUMENT;
+		}
+		catch (const std::bad_alloc&)
+		{
+			return IPX_ERR_TS_NO_MEMORY;
+		}
+
+		m_allocated = layout;
+		m_allocated.srcType = pSrc->pixelTypeDescr.pixelType;
+		m_allocated.workers = m_pool->GetNumThreads();
+		return IPX_ERR_OK;
+	}
+
+	void ReleaseData() override
+	{
+		for (auto &w : m_workers)
+		{
+			w.ts->ReleaseData();
+			w.scratch = IpxImage();
+		}
+		if (m_frame)
+			m_frame->ReleaseData();
+		std::vector<uint64_t>().swap(m_data);
+		m_allocated = Layout();
+	}
+
+	//! Sets the worker pool used by the component, for example the pool of IpxBayerCpu
+	/*!
+	\param[in] pool the pool, nullptr - the pool selected by TS_SHARED_POOL
+	*/
+	void SetWorkerPool( const std::shared_ptr<IpxToolsImpl::WorkerPool> &pool )
+	{
+		m_pools.SetWorkerPool(pool);
+	}
+
+	//! Returns the worker pool used by the component, the pool is created if it is needed
+	std::shared_ptr<IpxToolsImpl::WorkerPool> GetWorkerPool()
+	{
+		return m_pools.GetWorkerPool(m_component.GetSharedPool(), m_component.GetThreads());
+	}
+
+private:
+	// the stripes of the image, all the views of the stripes have viewRows rows
+	struct Layout
+	{
+		int height = 0;
+		int rows = 0;		// rows of the stripe, the last one can be shorter
+		int halo = 0;
+		int viewRows = 0;
+		int stripes = 0;	// 0 or 1 - the image is converted as a whole
+		uint32_t srcType = 0;	// the source of AllocData
+		uint32_t width = 0;
+		int workers = 0;
+
+		// the first row of the view of the stripe starting at y0, the view is shifted inside the image at the borders
+		int GetViewY( int y0 ) const { return std::min(std::max(0, y0 - halo), height - viewRows); }
+	};
+
+	struct Worker
+	{
+		IpxTrueSense *ts = nullptr;
+		IpxImage scratch;
+	};
+
+	// the own integer parameters and the timing counters, the other parameters are passed to all the instances
+	class Component : public IpxToolsImpl::ForwardingComponent
+	{
+	public:
+		explicit Component( IpxTrueSenseStriped &owner ) : IpxToolsImpl::ForwardingComponent(IPX_CMP_TS_DEMOSAICING), m_owner(owner)
+		{
+			m_threads = AddParamInt(TS_THREADS_NUM, 0, 0, 32);
+			m_noRealloc = AddParamInt(TS_NOREALLOC, 0, 0, 1);
+			m_sharedPool = AddParamInt(TS_SHARED_POOL, 0, 0, 1);
+			m_rows = AddParamInt(TS_STRIPE_ROWS, 0, 0, 65536);
+			m_halo = AddParamInt(TS_STRIPE_HALO, 16, 0, 256);
+			m_timeTotal = AddParamInt(TS_TIME_TOTAL, 0, 0, INT64_MAX, true);
+			m_timeConvert = AddParamInt(TS_TIME_CONVERT, 0, 0, INT64_MAX, true);
+			m_timeStripeMax = AddParamInt(TS_TIME_STRIPE_MAX, 0, 0, INT64_MAX, true);
+			m_timeCopy = AddParamInt(TS_TIME_COPY, 0, 0, INT64_MAX, true);
+		}
+
+		int GetThreads() const { return static_cast<int>(GetInt(m_threads)); }
+		bool GetNoRealloc() const { return GetInt(m_noRealloc) != 0; }
+		bool GetSharedPool() const { return GetInt(m_sharedPool) != 0; }
+		int GetRows() const { return static_cast<int>(GetInt(m_rows)); }
+		int GetHalo() const { return static_cast<int>(GetInt(m_halo)); }
+
+		void ResetTimes() { SetTimes(0, 0, 0, 0); }
+
+		void SetTimes( int64_t total, int64_t convert, int64_t stripeMax, int64_t copy )
+		{
+			SetInt(m_timeTotal, total);
+			SetInt(m_timeConvert, convert);
+			SetInt(m_timeStripeMax, stripeMax);
+			SetInt(m_timeCopy, copy);
+		}
+
+		//! Sets the parameters passed so far to the new instance of the stripes
+		IpxError Apply( IpxTrueSense *ts, bool stripe ) const
+		{
+			IpxComponent *c = ts->GetComponent();
+			const IpxError err = ApplyLog(c);
+			if (err != IPX_ERR_OK)
+				return err;
+			return stripe ? c->SetParamInt(TS_THREADS_NUM, 1) : IPX_ERR_OK;
+		}
+
+		IpxError SetParamInt( const char* name, int64_t param ) override
+		{
+			const IpxError err = ForwardingComponent::SetParamInt(name, param);
+			if (err != IPX_ERR_OK || !name)
+				return err;
+			// the whole image is converted by the threads and into the memory of the library
+			if ((strcmp(name, TS_THREADS_NUM) == 0 || strcmp(name, TS_NOREALLOC) == 0) && GetTarget())
+				GetTarget()->SetParamInt(name, param);
+			return err;
+		}
+
+	protected:
+		IpxError OnSetParamInt( size_t index, int64_t value ) override
+		{
+			if ((index == m_rows || index == m_halo) && (value & 3))
+				return Error(IPX_ERR_INVALID_ARGUMENT);
+			return IPX_ERR_OK;
+		}
+
+		IpxComponent* GetTarget() override { return m_owner.m_frame ? m_owner.m_frame->GetComponent() : nullptr; }
+
+		IpxError ForEachOther( const std::function<IpxError( IpxComponent* )> &fn ) override
+		{
+			for (auto &w : m_owner.m_workers)
+			{
+				const IpxError err = fn(w.ts->GetComponent());
+				if (err != IPX_ERR_OK)
+					return err;
+			}
+			return IPX_ERR_OK;
+		}
+
+	private:
+		IpxTrueSenseStriped &m_owner;
+		size_t m_threads, m_noRealloc, m_sharedPool, m_rows, m_halo;
+		size_t m_timeTotal, m_timeConvert, m_timeStripeMax, m_timeCopy;
+	};
+
+	int GetThreads() const
+	{
+		return IpxToolsImpl::ComponentPool::GetThreads(m_component.GetThreads());
+	}
+
+	static int64_t Elapsed( std::chrono::steady_clock::time_point t0, std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now() )
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+	}
+
+	// TS_NORM_EN is passed to the instances by any of the set methods, the whole image instance reports it
+	bool IsNormalized() const
+	{
+		int64_t value = 0;
+		return m_frame && m_frame->GetComponent()->GetParamInt(TS_NORM_EN, &value) == IPX_ERR_OK && value != 0;
+	}
+
+	// the stripes of the source, every thread gets 2 stripes to balance them, the stripe is at least 2 halos high
+	void GetLayout( const IpxImage* pSrc, Layout *layout ) const
+	{
+		const int height = pSrc->height > INT_MAX ? 0 : static_cast<int>(pSrc->height);
+		const int threads = GetThreads();
+		layout->height = height;
+		layout->width = pSrc->width;
+		layout->halo = m_component.GetHalo();
+		layout->rows = m_component.GetRows();
+		if (layout->rows == 0)
+		{
+			if (threads < 2)
+				return;
+			const int share = (height + 2 * threads - 1) / (2 * threads);
+			layout->rows = (std::max(std::max(share, 2 * layout->halo), 64) + 3) & ~3;
+		}
+		layout->viewRows = std::min(height, layout->rows + 2 * layout->halo);
+		if ((height & 3) || height <= layout->viewRows || IsNormalized())
+			return;
+		layout->stripes = (height + layout->rows - 1) / layout->rows;
+	}
+
+	// the scratch images were allocated by AllocData for the source and the layout, the destination has the data of
+	// their type and the image size, allocated by the component or by the application
+	bool FitsLayout( const IpxImage* pSrc, const Layout &layout, const IpxImage* pDst ) const
+	{
+		const Layout &a = m_allocated;
+		if (!m_pool || a.stripes < 2 || a.srcType != pSrc->pixelTypeDescr.pixelType || a.width != pSrc->width
+			|| a.height != layout.height || a.rows != layout.rows || a.halo != layout.halo || a.workers != m_pool->GetNumThreads()
+			|| m_pool != GetCurrentPool())
+			return false;
+		const IpxImage &scratch = m_workers[0].scratch;
+		const uint32_t type = scratch.pixelTypeDescr.pixelType;
+		return pDst->imageData && pDst->pixelTypeDescr.pixelType == type && pDst->width == scratch.width && pDst->height == pSrc->height
+			&& pDst->rowSize >= IpxGetRowSizeUnaligned(type, scratch.width) && uint64_t(pDst->imageSize) >= uint64_t(pDst->rowSize) * pDst->height;
+	}
+
+	// the pool selected now, the pool of AllocData is reallocated when the selection changes
+	std::shared_ptr<IpxToolsImpl::WorkerPool> GetCurrentPool() const
+	{
+		return m_pools.GetCurrentPool(m_component.GetSharedPool());
+	}
+
+	static IpxImage GetView( const IpxImage* pSrc, int y, int rows )
+	{
+		IpxImage view = *pSrc;
+		view.imageData = pSrc->imageData ? pSrc->imageData + size_t(y) * pSrc->rowSize : nullptr;
+		view.imageDataOrigin = nullptr;
+		view.height = static_cast<uint32_t>(rows);
+		view.imageSize = pSrc->rowSize * static_cast<uint32_t>(rows);
+		return view;
+	}
+
+	Component m_component;
+	IpxTrueSense *m_frame;				// converts the whole image and keeps the values of the parameters
+	std::vector<Worker> m_workers;		// per worker of the pool, 0 - the calling thread
+	std::vector<uint64_t> m_data;
+	Layout m_allocated;
+	std::shared_ptr<IpxToolsImpl::WorkerPool> m_pool;	// the pool of AllocData
+	IpxToolsImpl::ComponentPool m_pools;				// selects the pool by SetWorkerPool and TS_SHARED_POOL
+};
+
+#endif // __cplusplus
+
+#endif // _IPX_TRUE_SENSE_STRIPED_H_
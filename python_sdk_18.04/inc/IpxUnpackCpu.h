@@ -0,0 +1,492 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Imaging API SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxUnpackCpu.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Header-only SIMD unpackers of the packed mono and Bayer pixel types
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef _IPX_UNPACK_CPU_H_
+#define _IPX_UNPACK_CPU_H_
+
+#include "IpxImageUnpacker.h"
+#include "IpxToolsImpl.h"
+
+#ifdef __cplusplus
+
+#include <cstring>
+#include <climits>
+#include <algorithm>
+
+/*! \namespace IpxUnpackKernels
+	\brief A namespace provides the row unpackers of the packed mono and Bayer pixel types.
+
+	\details The unpackers convert a packed row to 16 bits per pixel or directly to 8 bits per pixel, the 8-bit value is
+	the packed value shifted right by (depth - 8). The packed types have 3 layouts:
+	- GEV (Mono10Packed, Mono12Packed, BayerXX10Packed, BayerXX12Packed): 2 pixels in 3 bytes, the bytes 0 and 2 keep
+	  the high 8 bits of the pixels, the byte 1 keeps the low bits of the first pixel in the low nibble and of the second
+	  one in the high nibble
+	- PFNC (Mono10p, Mono12p, BayerXX10p, BayerXX12p): the little-endian bit stream
+	- FLEX (Mono10_FLExPacked, Mono12_FLExPacked): the 64-bit little-endian words with 6 pixels of 10 bits or 5 pixels
+	  of 12 bits and the unused high bits, as given by the block sizes of IpxGetRAWRowSize for 1 tap; the 10-bit 8-tap
+	  and the 12-bit multi-tap blocks have no unused bits and are the PFNC bit stream. Mono8_FLExPacked is 8 bits per pixel.
+
+	The vector unpackers gather the 2 bytes of every pixel to a 16-bit lane by pshufb. The multiplication by the power
+	of 2 of the lane moves the pixel bits to the top of the lane, the shift right by (16 - depth) returns the 16-bit
+	value and the shift by 8 returns the 8-bit one. The GEV lanes take the high byte and the nibble separately.
+	All the instruction set levels produce the same result, the tail of the row is unpacked by the scalar code.
+*/
+namespace IpxUnpackKernels
+{
+	typedef void (*Unpack16Fn)( const uint8_t *src, uint16_t *dst, int width );
+	typedef void (*Unpack8Fn)( const uint8_t *src, uint8_t *dst, int width );
+
+	//! Bit layouts of the packed types
+	enum Layout
+	{
+		LayoutPlain8 = 0,	//!< 8 bits per pixel
+		LayoutGev = 1,		//!< 2 pixels in 3 bytes, GigE Vision
+		LayoutStream = 2,	//!< little-endian bit stream, PFNC
+		LayoutWord = 3		//!< pixels in 64-bit little-endian words, FLEX
+	};
+
+	//! The unpackers of the pixel type
+	struct Unpacker
+	{
+		Unpack16Fn to16;	//!< unpacks to 16 bits per pixel
+		Unpack8Fn to8;		//!< unpacks to 8 bits per pixel
+		int depth;			//!< bits of the pixel
+		int layout;			//!< Layout
+	};
+
+	//! The pixels and the bytes of the unpacked block, the vector kernels unpack the whole blocks
+	template<int L, int D>
+	struct Block
+	{
+		enum
+		{
+			Word = L == LayoutWord ? (D == 10 ? 6 : 5) : 0,			// pixels in the 64-bit word
+			Pixels = L == LayoutWord ? (D == 10 ? 48 : 80) : 16,	// 2 vectors of 8 pixels at least, one AVX2 vector
+			Bytes = L == LayoutWord ? Pixels / Word * 8 : (L == LayoutGev ? 24 : 2 * D),
+			Vectors = Pixels / 8
+		};
+
+		//! Bit offset of the pixel p in the block, LayoutStream and LayoutWord
+		static int Bit( int p ) { return L == LayoutWord ? 64 * (p / Word) + D * (p % Word) : D * p; }
+
+		//! Bytes of the packed row, the partial byte is counted
+		static size_t RowBytes( int width )
+		{
+			const size_t w = static_cast<size_t>(width);
+			if (L == LayoutGev)
+				return w / 2 * 3 + (w & 1) * 2;
+			if (L == LayoutWord)
+				return w / Word * 8 + ((w % Word) * D + 7) / 8;
+			return (w * D + 7) / 8;
+		}
+	};
+
+	//! Returns the pixel p of the block, the bytes of other pixels are not read
+	template<int L, int D>
+	inline uint16_t GetPixel( const uint8_t *block, int p )
+	{
+		const int lowMask = (1 << (D - 8)) - 1;
+		if (L == LayoutGev)
+		{
+			const uint8_t *b = block + 3 * (p >> 1);
+			return static_cast<uint16_t>((p & 1) ? ((b[2] << (D - 8)) | ((b[1] >> 4) & lowMask)) : ((b[0] << (D - 8)) | (b[1] & lowMask)));
+		}
+		const int bit = Block<L, D>::Bit(p);
+		const int v = block[bit >> 3] | (block[(bit >> 3) + 1] << 8);
+		return static_cast<uint16_t>((v >> (bit & 7)) & ((1 << D) - 1));
+	}
+
+	//! Unpacks the pixels [x, width) of the row, x is the first pixel of the block
+	template<int L, int D>
+	inline void Unpack16From( const uint8_t *src, uint16_t *dst, int x, int width )
+	{
+		typedef Block<L, D> B;
+		for (const uint8_t *block = src + x / B::Pixels * B::Bytes; x < width; x += B::Pixels, block += B::Bytes)
+		{
+			const int n = std::min<int>(B::Pixels, width - x);
+			for (int p = 0; p < n; ++p)
+				dst[x + p] = GetPixel<L, D>(block, p);
+		}
+	}
+
+	template<int L, int D>
+	inline void Unpack8From( const uint8_t *src, uint8_t *dst, int x, int width )
+	{
+		typedef Block<L, D> B;
+		for (const uint8_t *block = src + x / B::Pixels * B::Bytes; x < width; x += B::Pixels, block += B::Bytes)
+		{
+			const int n = std::min<int>(B::Pixels, width - x);
+			for (int p = 0; p < n; ++p)
+				dst[x + p] = static_cast<uint8_t>(GetPixel<L, D>(block, p) >> (D - 8));
+		}
+	}
+
+	template<int L, int D>
+	void Unpack16Scalar( const uint8_t *src, uint16_t *dst, int width ) { Unpack16From<L, D>(src, dst, 0, width); }
+
+	template<int L, int D>
+	void Unpack8Scalar( const uint8_t *src, uint8_t *dst, int width ) { Unpack8From<L, D>(src, dst, 0, width); }
+
+	inline void Plain8To16( const uint8_t *src, uint16_t *dst, int width )
+	{
+		for (int x = 0; x < width; ++x)
+			dst[x] = src[x];
+	}
+
+	inline void Plain8To8( const uint8_t *src, uint8_t *dst, int width ) { memcpy(dst, src, width); }
+
+	//! The pshufb masks, the multipliers and the load offsets of the 8-pixel vectors of the block
+	template<int L, int D>
+	struct Tables
+	{
+		typedef Block<L, D> B;
+
+		Tables() : loadEnd(0)
+		{
+			for (int v = 0; v < B::Vectors; ++v)
+			{
+				const int p0 = 8 * v;
+				offset[v] = L == LayoutGev ? 3 * (p0 >> 1) : B::Bit(p0) >> 3;
+				for (int k = 0; k < 8; ++k)
+				{
+					const int p = p0 + k;
+					int lo, hi;
+					if (L == LayoutGev)
+					{
+						// the high byte of the pixel above the byte of the low bits, the nibble of the even pixel moves up by 4
+						lo = 3 * (p >> 1) + 1;
+						hi = (p & 1) ? lo + 1 : lo - 1;
+						mul[v][k] = (p & 1) ? 1 : 16;
+					}
+					else
+					{
+						const int bit = B::Bit(p);
+						lo = bit >> 3;
+						hi = lo + 1;
+						mul[v][k] = static_cast<uint16_t>(1 << (16 - D - (bit & 7)));
+					}
+					shuffle[v][2 * k] = static_cast<int8_t>(lo - offset[v]);
+					shuffle[v][2 * k + 1] = static_cast<int8_t>(hi - offset[v]);
+				}
+				loadEnd = std::max(loadEnd, offset[v] + 16);
+			}
+		}
+
+		static const Tables& Get()
+		{
+			static const Tables tables;
+			return tables;
+		}
+
+		int8_t shuffle[B::Vectors][16];
+		uint16_t mul[B::Vectors][8];
+		int offset[B::Vectors];
+		int loadEnd;	// the bytes of the block read by the 16-byte loads
+	};
+
+#if IPX_TOOLS_X86_DISPATCH
+	// 8 pixels of the 16-byte window, the pixel bits at the top of the lanes or the GEV lanes of 2 bytes
+	template<int L, int D> IPX_TARGET_SSE41 IPX_FORCE_INLINE
+	__m128i Gather( const uint8_t *window, const int8_t *shuffle )
+	{
+		return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(window)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle)));
+	}
+
+	template<int L, int D> IPX_TARGET_SSE41 IPX_FORCE_INLINE
+	__m128i To16( __m128i v, const uint16_t *mul )
+	{
+		const __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mul));
+		if (L == LayoutGev)
+		{
+			const __m128i high = _mm_and_si128(_mm_srli_epi16(v, 16 - D), _mm_set1_epi16(static_cast<short>(0xFF << (D - 8))));
+			const __m128i low = _mm_and_si128(_mm_srli_epi16(_mm_mullo_epi16(v, m), 4), _mm_set1_epi16((1 << (D - 8)) - 1));
+			return _mm_or_si128(high, low);
+		}
+		return _mm_srli_epi16(_mm_mullo_epi16(v, m), 16 - D);
+	}
+
+	template<int L, int D> IPX_TARGET_SSE41 IPX_FORCE_INLINE
+	__m128i To8( __m128i v, const uint16_t *mul )
+	{
+		if (L == LayoutGev)
+			return _mm_srli_epi16(v, 8);
+		return _mm_srli_epi16(_mm_mullo_epi16(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(mul))), 8);
+	}
+
+	template<int L, int D> IPX_TARGET_SSE41
+	void Unpack16Sse( const uint8_t *src, uint16_t *dst, int width )
+	{
+		typedef Block<L, D> B;
+		const Tables<L, D> &t = Tables<L, D>::Get();
+		const size_t bytes = B::RowBytes(width);
+		int x = 0;
+		for (size_t off = 0; x + B::Pixels <= width && off + t.loadEnd <= bytes; x += B::Pixels, off += B::Bytes)
+		{
+			for (int v = 0; v < B::Vectors; ++v)
+			{
+				const __m128i g = Gather<L, D>(src + off + t.offset[v], t.shuffle[v]);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x + 8 * v), To16<L, D>(g, t.mul[v]));
+			}
+		}
+		Unpack16From<L, D>(src, dst, x, width);
+	}
+
+	template<int L, int D> IPX_TARGET_SSE41
+	void Unpack8Sse( const uint8_t *src, uint8_t *dst, int width )
+	{
+		typedef Block<L, D> B;
+		const Tables<L, D> &t = Tables<L, D>::Get();
+		const size_t bytes = B::RowBytes(width);
+		int x = 0;
+		for (size_t off = 0; x + B::Pixels <= width && off + t.loadEnd <= bytes; x += B::Pixels, off += B::Bytes)
+		{
+			for (int v = 0; v < B::Vectors; v += 2)
+			{
+				const __m128i a = To8<L, D>(Gather<L, D>(src + off + t.offset[v], t.shuffle[v]), t.mul[v]);
+				const __m128i b = To8<L, D>(Gather<L, D>(src + off + t.offset[v + 1], t.shuffle[v + 1]), t.mul[v + 1]);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x + 8 * v), _mm_packus_epi16(a, b));
+			}
+		}
+		Unpack8From<L, D>(src, dst, x, width);
+	}
+
+	// the 128-bit lanes gather the vectors v and v + 1 of the block, pshufb does not cross the lanes
+	template<int L, int D> IPX_TARGET_AVX2 IPX_FORCE_INLINE
+	void Gather2( __m256i &r, __m256i &mul, const uint8_t *block, const Tables<L, D> &t, int v )
+	{
+		const __m256i w = _mm256_inserti128_si256(_mm256_castsi128_si256(
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + t.offset[v]))),
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + t.offset[v + 1])), 1);
+		const __m256i s = _mm256_loadu2_m128i(reinterpret_cast<const __m128i*>(t.shuffle[v + 1]), reinterpret_cast<const __m128i*>(t.shuffle[v]));
+		mul = _mm256_loadu2_m128i(reinterpret_cast<const __m128i*>(t.mul[v + 1]), reinterpret_cast<const __m128i*>(t.mul[v]));
+		r = _mm256_shuffle_epi8(w, s);
+	}
+
+	template<int L, int D> IPX_TARGET_AVX2
+	void Unpack16Avx2( const uint8_t *src, uint16_t *dst, int width )
+	{
+		typedef Block<L, D> B;
+		const Tables<L, D> &t = Tables<L, D>::Get();
+		const size_t bytes = B::RowBytes(width);
+		const __m256i highMask = _mm256_set1_epi16(static_cast<short>(0xFF << (D - 8)));
+		const __m256i lowMask = _mm256_set1_epi16((1 << (D - 8)) - 1);
+		int x = 0;
+		for (size_t off = 0; x + B::Pixels <= width && off + t.loadEnd <= bytes; x += B::Pixels, off += B::Bytes)
+		{
+			for (int v = 0; v < B::Vectors; v += 2)
+			{
+				__m256i g, m, r;
+				Gather2<L, D>(g, m, src + off, t, v);
+				if (L == LayoutGev)
+					r = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi16(g, 16 - D), highMask),
+						_mm256_and_si256(_mm256_srli_epi16(_mm256_mullo_epi16(g, m), 4), lowMask));
+				else
+					r = _mm256_srli_epi16(_mm256_mullo_epi16(g, m), 16 - D);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x + 8 * v), r);
+			}
+		}
+		Unpack16From<L, D>(src, dst, x, width);
+	}
+
+	template<int L, int D> IPX_TARGET_AVX2
+	void Unpack8Avx2( const uint8_t *src, uint8_t *dst, int width )
+	{
+		typedef Block<L, D> B;
+		const Tables<L, D> &t = Tables<L, D>::Get();
+		const size_t bytes = B::RowBytes(width);
+		int x = 0;
+		for (size_t off = 0; x + B::Pixels <= width && off + t.loadEnd <= bytes; x += B::Pixels, off += B::Bytes)
+		{
+			for (int v = 0; v < B::Vectors; v += 2)
+			{
+				__m256i g, m;
+				Gather2<L, D>(g, m, src + off, t, v);
+				const __m256i r = L == LayoutGev ? _mm256_srli_epi16(g, 8) : _mm256_srli_epi16(_mm256_mullo_epi16(g, m), 8);
+				// packus packs within the lanes, the 64-bit quarters 0 and 2 keep the 16 pixels
+				const __m256i p = _mm256_permute4x64_epi64(_mm256_packus_epi16(r, r), 0x08);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x + 8 * v), _mm256_castsi256_si128(p));
+			}
+		}
+		Unpack8From<L, D>(src, dst, x, width);
+	}
+#endif
+
+	template<int L, int D>
+	inline void SetUnpacker( Unpacker *u, int isa )
+	{
+		u->to16 = &Unpack16Scalar<L, D>;
+		u->to8 = &Unpack8Scalar<L, D>;
+		u->depth = D;
+		u->layout = L;
+#if IPX_TOOLS_X86_DISPATCH
+		if (isa >= IpxToolsImpl::IsaAvx2)
+		{
+			u->to16 = &Unpack16Avx2<L, D>;
+			u->to8 = &Unpack8Avx2<L, D>;
+		}
+		else if (isa >= IpxToolsImpl::IsaSse41)
+		{
+			u->to16 = &Unpack16Sse<L, D>;
+			u->to8 = &Unpack8Sse<L, D>;
+		}
+#else
+		(void)isa;
+#endif
+	}
+
+	//! Returns the layout and the depth of the packed mono or Bayer type
+	/*!
+	\param[in] pixelType the packed pixel type
+	\param[in] taps the taps of the FLEX camera, the 10-bit 8-tap and the 12-bit 2, 4 and more tap rows are the bit stream,
+	the 12-bit 3-tap rows are the 64-bit words like the single tap ones
+	\param[out] layout Layout
+	\param[out] depth bits of the pixel
+	*/
+	inline bool GetLayout( uint32_t pixelType, int taps, int *layout, int *depth )
+	{
+		if ((pixelType & II_PIXEL_COLOR_MASK) != II_PIX_MONO && (pixelType & II_PIXEL_COLOR_MASK) != II_PIX_BAYER_CFA)
+			return false;
+		switch (II_GET_PIXEL_ALIGNMENT(pixelType))
+		{
+		case II_ALIGN_10_PACKED_GEV: *layout = LayoutGev; *depth = 10; return true;
+		case II_ALIGN_12_PACKED_GEV: *layout = LayoutGev; *depth = 12; return true;
+		case II_ALIGN_10_PACKED_PFNC: *layout = LayoutStream; *depth = 10; return true;
+		case II_ALIGN_12_PACKED_PFNC: *layout = LayoutStream; *depth = 12; return true;
+		case II_ALIGN_8_PACKED_FLEX: *layout = LayoutPlain8; *depth = 8; return true;
+		case II_ALIGN_10_PACKED_FLEX: *layout = taps == 8 ? LayoutStream : LayoutWord; *depth = 10; return true;
+		case II_ALIGN_12_PACKED_FLEX: *layout = taps > 1 && taps != 3 ? LayoutStream : LayoutWord; *depth = 12; return true;
+		default: return false;
+		}
+	}
+
+	//! Returns the unpackers of the packed mono or Bayer type for the instruction set level
+	/*!
+	\param[in] pixelType the packed pixel type
+	\param[in] isa IpxToolsImpl::CpuIsa, 0 - the level of the CPU
+	\param[out] unpacker the unpackers
+	\param[in] taps the taps of the FLEX camera
+	*/
+	inline bool GetUnpacker( uint32_t pixelType, int isa, Unpacker *unpacker, int taps = 1 )
+	{
+		int layout = 0, depth = 0;
+		if (!unpacker || !GetLayout(pixelType, taps, &layout, &depth))
+			return false;
+		if (isa <= 0 || isa > IpxToolsImpl::GetCpuIsa())
+			isa = IpxToolsImpl::GetCpuIsa();
+		switch (layout * 100 + depth)
+		{
+		case LayoutGev * 100 + 10: SetUnpacker<LayoutGev, 10>(unpacker, isa); break;
+		case LayoutGev * 100 + 12: SetUnpacker<LayoutGev, 12>(unpacker, isa); break;
+		case LayoutStream * 100 + 10: SetUnpacker<LayoutStream, 10>(unpacker, isa); break;
+		case LayoutStream * 100 + 12: SetUnpacker<LayoutStream, 12>(unpacker, isa); break;
+		case LayoutWord * 100 + 10: SetUnpacker<LayoutWord, 10>(unpacker, isa); break;
+		case LayoutWord * 100 + 12: SetUnpacker<LayoutWord, 12>(unpacker, isa); break;
+		default:
+			unpacker->to16 = &Plain8To16;
+			unpacker->to8 = &Plain8To8;
+			unpacker->depth = 8;
+			unpacker->layout = LayoutPlain8;
+			break;
+		}
+		return true;
+	}
+
+	//! Returns the bytes of the packed row, the partial byte or word is counted, 0 - not a packed mono or Bayer type
+	inline size_t GetPackedRowBytes( uint32_t pixelType, uint32_t width, int taps = 1 )
+	{
+		int layout = 0, depth = 0;
+		if (!GetLayout(pixelType, taps, &layout, &depth))
+			return 0;
+		switch (layout * 100 + depth)
+		{
+		case LayoutGev * 100 + 10: case LayoutGev * 100 + 12: return Block<LayoutGev, 12>::RowBytes(width);
+		case LayoutStream * 100 + 10: return Block<LayoutStream, 10>::RowBytes(width);
+		case LayoutStream * 100 + 12: return Block<LayoutStream, 12>::RowBytes(width);
+		case LayoutWord * 100 + 10: return Block<LayoutWord, 10>::RowBytes(width);
+		case LayoutWord * 100 + 12: return Block<LayoutWord, 12>::RowBytes(width);
+		default: return width;
+		}
+	}
+
+	//! Returns the unpacked type of the packed mono or Bayer type, 0 - not a packed mono or Bayer type
+	/*!
+	\param[in] pixelType the packed pixel type
+	\param[in] to8 true - the 8-bit type, false - the 16-bit type of the packed depth
+	*/
+	inline uint32_t GetUnpackedType( uint32_t pixelType, bool to8 )
+	{
+		int layout = 0, depth = 0;
+		if (!GetLayout(pixelType, 1, &layout, &depth))
+			return 0;
+		const bool ten = depth == 10;
+		switch (pixelType)
+		{
+		case II_PIX_MONO8_PACKED_FLEX:
+			return II_PIX_MONO8;
+		case II_PIX_MONO10_PACKED_PFNC: case II_PIX_MONO10_PACKED_GEV: case II_PIX_MONO10_PACKED_FLEX:
+		case II_PIX_MONO12_PACKED_PFNC: case II_PIX_MONO12_PACKED_GEV: case II_PIX_MONO12_PACKED_FLEX:
+			return to8 ? II_PIX_MONO8 : (ten ? II_PIX_MONO10 : II_PIX_MONO12);
+		case II_PIX_BAYGR10_PACKED_PFNC: case II_PIX_BAYGR10_PACKED_GEV: case II_PIX_BAYGR12_PACKED_PFNC: case II_PIX_BAYGR12_PACKED_GEV:
+			return to8 ? II_PIX_BAYGR8 : (ten ? II_PIX_BAYGR10 : II_PIX_BAYGR12);
+		case II_PIX_BAYRG10_PACKED_PFNC: case II_PIX_BAYRG10_PACKED_GEV: case II_PIX_BAYRG12_PACKED_PFNC: case II_PIX_BAYRG12_PACKED_GEV:
+			return to8 ? II_PIX_BAYRG8 : (ten ? II_PIX_BAYRG10 : II_PIX_BAYRG12);
+		case II_PIX_BAYGB10_PACKED_PFNC: case II_PIX_BAYGB10_PACKED_GEV: case II_PIX_BAYGB12_PACKED_PFNC: case II_PIX_BAYGB12_PACKED_GEV:
+			return to8 ? II_PIX_BAYGB8 : (ten ? II_PIX_BAYGB10 : II_PIX_BAYGB12);
+		case II_PIX_BAYBG10_PACKED_PFNC: case II_PIX_BAYBG10_PACKED_GEV: case II_PIX_BAYBG12_PACKED_PFNC: case II_PIX_BAYBG12_PACKED_GEV:
+			return to8 ? II_PIX_BAYBG8 : (ten ? II_PIX_BAYBG10 : II_PIX_BAYBG12);
+		default:
+			return 0;
+		}
+	}
+
+	//! Unpacks the image to the image allocated by the caller
+	/*!
+	\param[in] src the packed mono or Bayer image, the rows start at the multiples of rowSize
+	\param[in,out] dst the image of the type returned by GetUnpackedType and of the same size
+	\param[in] isa IpxToolsImpl::CpuIsa, 0 - the level of the CPU
+	\param[in] taps the taps of the FLEX camera
+	\return IPX_ERR_UNP_INVALID_ARGUMENT for the unsupported types or the images too small
+	*/
+	inline IpxError UnpackImage( const IpxImage *src, IpxImage *dst, int isa = 0, int taps = 1 )
+	{
+		Unpacker u;
+		if (!src || !dst || !src->imageData || !dst->imageData || !GetUnpacker(src->pixelTypeDescr.pixelType, isa, &u, taps))
+			return IPX_ERR_UNP_INVALID_ARGUMENT;
+		const uint32_t dstType = dst->pixelTypeDescr.pixelType;
+		const bool to8 = dstType == GetUnpackedType(src->pixelTypeDescr.pixelType, true);
+		if (!to8 && dstType != GetUnpackedType(src->pixelTypeDescr.pixelType, false))
+			return IPX_ERR_UNP_INVALID_ARGUMENT;
+		if (dst->width != src->width || dst->height != src->height || src->width > INT_MAX
+			|| src->rowSize < GetPackedRowBytes(src->pixelTypeDescr.pixelType, src->width, taps)
+			|| dst->rowSize < src->width * (to8 ? 1u : 2u))
+			return IPX_ERR_UNP_INVALID_ARGUMENT;
+
+		const int width = static_cast<int>(src->width);
+		for (uint32_t y = 0; y < src->height; ++y)
+		{
+			const uint8_t *s = reinterpret_cast<const uint8_t*>(src->imageData) + size_t(y) * src->rowSize;
+			char *d = dst->imageData + size_t(y) * dst->rowSize;
+			if (to8)
+				u.to8(s, reinterpret_cast<uint8_t*>(d), width);
+			else
+				u.to16(s, reinterpret_cast<uint16_t*>(d), width);
+		}
+		dst->timestamp = src->timestamp;
+		dst->imageID = src->imageID;
+		return IPX_ERR_OK;
+	}
+
+} // end of namespace IpxUnpackKernels
+
+#endif // __cplusplus
+
+#endif // _IPX_UNPACK_CPU_H_
@@ -0,0 +1,2209 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Camera SDK
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// File: IpxVirtualCamera.h
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Software-simulated camera producer for hardware-free streaming
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Created:	17-OCT-2026
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2013-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IPX_VIRTUAL_CAMERA_H
+#define IPX_VIRTUAL_CAMERA_H
+
+#include <string.h>
+
+#include "IpxCameraApi.h"
+#include "IpxGenParamImpl.h"
+#include "IpxBufferAllocator.h"
+#include "IpxThreadControl.h"
+#include "IpxStreamStats.h"
+#include "IpxImage.h"
+
+#ifdef __cplusplus
+
+#include <cmath>
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <algorithm>
+#include <condition_variable>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+/*! \namespace IpxCamSim
+    \brief A namespace provides the software-simulated (virtual) camera.
+
+    \details The virtual camera implements IpxCam::Interface, IpxCam::DeviceInfo, IpxCam::Device, IpxCam::Stream and IpxCam::Buffer
+    in the application process. It generates frames of configurable size, pixel format and frame rate, and can inject
+    dropped frames, incomplete frames and timestamp jitter. All the settings are exposed as the GenICam-like camera parameters,
+    so the code written for the real cameras runs against the virtual one without changes.
+
+    The virtual interface is added to the interface list by the System wrapper:
+    \code
+    auto system = IpxCamSim::GetSystem(IpxCam::IpxCam_GetSystem());   // real interfaces + virtual one
+    ...
+    auto device = IpxCamSim::CreateDevice(deviceInfo);                  // virtual or real device
+    \endcode
+    Pass nullptr instead of the real system to get the virtual interface only (no camera library calls are made in this case).
+*/
+namespace IpxCamSim
+{
+    //! Interface type reported by the virtual interface
+    const IpxCam::InterfaceType VirtualInterface = static_cast<IpxCam::InterfaceType>(0x80);
+
+    /*! \brief Stream event type of the push mode frame delivery, the value of GenTL EVENT_NEW_BUFFER.
+
+        \details When at least one callback of this type is registered by Stream::RegisterEvent2 (or RegisterEvent),
+        the filled buffers are not put to the output queue. Instead, the callback is called directly on the acquisition thread,
+        eventData is the IpxCam::Buffer* of the new frame and eventSize is the size of the image data in the buffer.
+
+        Buffer ownership contract:
+        - the buffer belongs to the application from the moment the callback is called;
+        - it must be returned to the input pool by Stream::QueueBuffer, either from the callback (the lowest latency path)
+          or later from any thread. Until then the buffer is not used by the stream;
+        - the acquisition thread waits for the callback to return, so the next frame is filled only after that. A callback which
+          takes longer than the frame period leads to the lost frames (GetNumUnderrun) if no other buffer is queued;
+        - StopAcquisition and Release must not be called from the callback, they return/do nothing in this case.
+        GetBuffer is still served in the push mode, but it receives no frames.
+    */
+    const uint32_t EventNewBuffer = 1;
+
+    /*! \brief Stream::StartAcquisition flag of the busy-poll delivery mode.
+
+        \details The acquisition thread puts the filled buffers to a lock-free ring and GetBuffer/GetBuffers spin on the ring
+        instead of sleeping on the stream lock. The spinning lasts StreamBusyPollSpinTime microseconds (0 - the whole timeout),
+        after that the call falls back to the blocking wait. The mode is intended for the consumer threads pinned to isolated cores.
+    */
+    const uint32_t AcqStartBusyPoll = 0x00010000;
+
+    //! Hints the processor that the thread is in the spin-wait loop
+    inline void CpuRelax()
+    {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+#endif
+    }
+
+    //! Maximum number of virtual devices on the virtual interface
+    const size_t MaxDevices = 16;
+
+    //! An enumeration of the colour layout of pixel formats supported by the virtual camera
+    enum PixelLayout : uint32_t
+    {
+        LayoutMono = 0,
+        LayoutBayerGR,
+        LayoutBayerRG,
+        LayoutBayerGB,
+        LayoutBayerBG,
+        LayoutRGB,
+        LayoutBGR
+    };
+
+    //! Description of the pixel format supported by the virtual camera
+    struct PixelFormatInfo
+    {
+        const char *name;       /*!< GenICam PFNC name */
+        int64_t     pfnc;       /*!< PFNC code, value of PixelFormat parameter and Buffer::GetPixelFormat */
+        uint32_t    pixelType;  /*!< II_PIX_* pixel type of the IpxImage */
+        uint32_t    depth;      /*!< Number of significant bits per sample */
+        PixelLayout layout;     /*!< Colour layout */
+    };
+
+    //! Returns the table of pixel formats supported by the virtual camera
+    inline const PixelFormatInfo* GetPixelFormats( size_t *count )
+    {
+        static const PixelFormatInfo formats[] =
+        {
+            { "Mono8",           0x01080001, II_PIX_MONO8,               8,  LayoutMono },
+            { "Mono10",          0x01100003, II_PIX_MONO10,              10, LayoutMono },
+            { "Mono10p",         0x010A0046, II_PIX_MONO10_PACKED_PFNC,  10, LayoutMono },
+            { "Mono10Packed",    0x010C0004, II_PIX_MONO10_PACKED_GEV,   10, LayoutMono },
+            { "Mono12",          0x01100005, II_PIX_MONO12,              12, LayoutMono },
+            { "Mono12p",         0x010C0047, II_PIX_MONO12_PACKED_PFNC,  12, LayoutMono },
+            { "Mono12Packed",    0x010C0006, II_PIX_MONO12_PACKED_GEV,   12, LayoutMono },
+            { "Mono14",          0x01100025, II_PIX_MONO14,              14, LayoutMono },
+            { "Mono16",          0x01100007, II_PIX_MONO16,              16, LayoutMono },
+            { "BayerGR8",        0x01080008, II_PIX_BAYGR8,              8,  LayoutBayerGR },
+            { "BayerRG8",        0x01080009, II_PIX_BAYRG8,              8,  LayoutBayerRG },
+            { "BayerGB8",        0x0108000A, II_PIX_BAYGB8,              8,  LayoutBayerGB },
+            { "BayerBG8",        0x0108000B, II_PIX_BAYBG8,              8,  LayoutBayerBG },
+            { "BayerGR10",       0x0110000C, II_PIX_BAYGR10,             10, LayoutBayerGR },
+            { "BayerRG10",       0x0110000D, II_PIX_BAYRG10,             10, LayoutBayerRG },
+            { "BayerGB10",       0x0110000E, II_PIX_BAYGB10,             10, LayoutBayerGB },
+            { "BayerBG10",       0x0110000F, II_PIX_BAYBG10,             10, LayoutBayerBG },
+            { "BayerGR10p",      0x010A0056, II_PIX_BAYGR10_PACKED_PFNC, 10, LayoutBayerGR },
+            { "BayerRG10p",      0x010A0058, II_PIX_BAYRG10_PACKED_PFNC, 10, LayoutBayerRG },
+            { "BayerGB10p",      0x010A0054, II_PIX_BAYGB10_PACKED_PFNC, 10, LayoutBayerGB },
+            { "BayerBG10p",      0x010A0052, II_PIX_BAYBG10_PACKED_PFNC, 10, LayoutBayerBG },
+            { "BayerGR10Packed", 0x010C0026, II_PIX_BAYGR10_PACKED_GEV,  10, LayoutBayerGR },
+            { "BayerRG10Packed", 0x010C0027, II_PIX_BAYRG10_PACKED_GEV,  10, LayoutBayerRG },
+            { "BayerGB10Packed", 0x010C0028, II_PIX_BAYGB10_PACKED_GEV,  10, LayoutBayerGB },
+            { "BayerBG10Packed", 0x010C0029, II_PIX_BAYBG10_PACKED_GEV,  10, LayoutBayerBG },
+            { "BayerGR12",       0x01100010, II_PIX_BAYGR12,             12, LayoutBayerGR },
+            { "BayerRG12",       0x01100011, II_PIX_BAYRG12,             12, LayoutBayerRG },
+            { "BayerGB12",       0x01100012, II_PIX_BAYGB12,             12, LayoutBayerGB },
+            { "BayerBG12",       0x01100013, II_PIX_BAYBG12,             12, LayoutBayerBG },
+            { "BayerGR12p",      0x010C0057, II_PIX_BAYGR12_PACKED_PFNC, 12, LayoutBayerGR },
+            { "BayerRG12p",      0x010C0059, II_PIX_BAYRG12_PACKED_PFNC, 12, LayoutBayerRG },
+            { "BayerGB12p",      0x010C0055, II_PIX_BAYGB12_PACKED_PFNC, 12, LayoutBayerGB },
+            { "BayerBG12p",      0x010C0053, II_PIX_BAYBG12_PACKED_PFNC, 12, LayoutBayerBG },
+            { "BayerGR12Packed", 0x010C002A, II_PIX_BAYGR12_PACKED_GEV,  12, LayoutBayerGR },
+            { "BayerRG12Packed", 0x010C002B, II_PIX_BAYRG12_PACKED_GEV,  12, LayoutBayerRG },
+            { "BayerGB12Packed", 0x010C002C, II_PIX_BAYGB12_PACKED_GEV,  12, LayoutBayerGB },
+            { "BayerBG12Packed", 0x010C002D, II_PIX_BAYBG12_PACKED_GEV,  12, LayoutBayerBG },
+            { "BayerGR16",       0x0110002E, II_PIX_BAYGR16,             16, LayoutBayerGR },
+            { "BayerRG16",       0x0110002F, II_PIX_BAYRG16,             16, LayoutBayerRG },
+            { "BayerGB16",       0x01100030, II_PIX_BAYGB16,             16, LayoutBayerGB },
+            { "BayerBG16",       0x01100031, II_PIX_BAYBG16,             16, LayoutBayerBG },
+            { "RGB8",            0x02180014, II_PIX_RGB8,                8,  LayoutRGB },
+            { "BGR8",            0x02180015, II_PIX_BGR8,                8,  LayoutBGR },
+        };
+        *count = sizeof(formats) / sizeof(formats[0]);
+        return formats;
+    }
+
+    //! Returns the pixel format description by PFNC code or nullptr if the format is not supported
+    inline const PixelFormatInfo* FindPixelFormat( int64_t pfnc )
+    {
+        size_t count = 0;
+        auto formats = GetPixelFormats(&count);
+        for (size_t i = 0; i < count; ++i)
+            if (formats[i].pfnc == pfnc)
+                return &formats[i];
+        return nullptr;
+    }
+
+    //! Allocates memory aligned to the power of two boundary
+    inline void* AlignedAlloc( size_t size, size_t alignment )
+    {
+#ifdef _WIN32
+        return _aligned_malloc(size, alignment);
+#else
+        void *ptr = nullptr;
+        if (posix_memalign(&ptr, std::max(alignment, sizeof(void*)), size) != 0)
+            return nullptr;
+        return ptr;
+#endif
+    }
+
+    //! Frees memory allocated by AlignedAlloc
+    inline void AlignedFree( void *ptr )
+    {
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        free(ptr);
+#endif
+    }
+
+    /**
+    \brief Implementation of IpxCam::List over the snapshot of the elements
+    */
+    template<class T>
+    class List : public IpxCam::List<T>
+    {
+    public:
+        explicit List( const std::vector<T*> &items ) : m_items(items), m_pos(0) {}
+
+        virtual void Release() { delete this; }
+        virtual size_t GetCount() { return m_items.size(); }
+        virtual T* GetFirst() { m_pos = 0; return GetNext(); }
+        virtual T* GetNext() { return m_pos < m_items.size() ? m_items[m_pos++] : nullptr; }
+
+    private:
+        std::vector<T*> m_items;
+        size_t m_pos;
+    };
+
+    /**
+    \brief Registered event callbacks, the same storage is used by interface, device and stream.
+    \details The entries are copied on write: Register and Unregister replace the list, Fire takes the current one
+    under the lock and calls the callbacks without copying the entries.
+    */
+    class EventRegistry
+    {
+    public:
+        EventRegistry() : m_entries(std::make_shared<const std::vector<Entry>>()) {}
+
+        IpxCamErr Register( uint32_t eventType, IpxCam::EventCallback2 *cb2, IpxCam::EventCallback *cb, void *pPrivate )
+        {
+            if (!cb2 && !cb)
+                return IPX_CAM_ERR_INVALID_ARGUMENT;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto entries = std::make_shared<std::vector<Entry>>(*m_entries);
+            entries->push_back({ eventType, cb2, cb, pPrivate });
+            m_entries = std::move(entries);
+            return IPX_CAM_ERR_OK;
+        }
+
+        IpxCamErr Unregister( uint32_t eventType, IpxCam::EventCallback2 *cb2, IpxCam::EventCallback *cb, void *pPrivate )
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = std::find_if(m_entries->begin(), m_entries->end(), [&](const Entry &e)
+                { return e.eventType == eventType && e.cb2 == cb2 && e.cb == cb && e.pPrivate == pPrivate; });
+            if (it == m_entries->end())
+                return IPX_CAM_ERR_INVALID_ARGUMENT;
+            auto entries = std::make_shared<std::vector<Entry>>(m_entries->begin(), it);
+            entries->insert(entries->end(), it + 1, m_entries->end());
+            m_entries = std::move(entries);
+            return IPX_CAM_ERR_OK;
+        }
+
+        //! Calls all the callbacks registered for the event type and returns the number of the called callbacks
+        size_t Fire( uint32_t eventType, const void *eventData, size_t eventSize )
+        {
+            std::shared_ptr<const std::vector<Entry>> entries;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                entries = m_entries;
+            }
+            size_t count = 0;
+            for (auto &e : *entries)
+            {
+                if (e.eventType != eventType)
+                    continue;
+                if (e.cb2)
+                    e.cb2(eventType, eventData, eventSize, e.pPrivate);
+                else
+                    e.cb(eventData, eventSize, e.pPrivate);
+                ++count;
+            }
+            return count;
+        }
+
+    private:
+        struct Entry
+        {
+            uint32_t eventType;
+            IpxCam::EventCallback2 *cb2;
+            IpxCam::EventCallback *cb;
+            void *pPrivate;
+        };
+
+        std::mutex m_mutex;
+        std::shared_ptr<const std::vector<Entry>> m_entries;  // replaced, never modified in place
+    };
+
+    /**
+    \brief Generator of the test pattern frames.
+    \details The pattern (colour bars with vertical brightness ramp) is rendered once per configuration into
+    a buffer of twice the image height, so any frame, including the moving one, is a single memcpy.
+    */
+    class FrameSource
+    {
+    public:
+
+        //! An enumeration of test patterns, values of TestPattern parameter
+        enum Pattern : int64_t
+        {
+            PatternOff = 0,         /*!< Buffer memory is not touched, pure transport benchmark */
+            PatternColorBars = 1,   /*!< Static colour bars */
+            PatternColorBarsMoving = 2 /*!< Colour bars scrolling by two rows per frame */
+        };
+
+        FrameSource() : m_width(0), m_height(0), m_format(nullptr), m_pattern(-1), m_rowSize(0) {}
+
+        //! Prepares the pattern, does nothing if the configuration has not been changed
+        void Configure( uint32_t width, uint32_t height, const PixelFormatInfo *format, int64_t pattern )
+        {
+            if (width == m_width && height == m_height && format == m_format && pattern == m_pattern)
+                return;
+
+            m_width = width;
+            m_height = height;
+            m_format = format;
+            m_pattern = pattern;
+            m_rowSize = IpxGetRowSizeUnaligned(format->pixelType, width);
+
+            m_data.clear();
+            if (pattern == PatternOff)
+                return;
+
+            m_data.resize(m_rowSize * height * 2);
+            std::vector<uint16_t> samples(width * 3);
+            for (uint32_t y = 0; y < height * 2; ++y)
+            {
+                RenderRow(y, samples.data());
+                PackRow(samples.data(), &m_data[y * m_rowSize]);
+            }
+        }
+
+        size_t GetRowSize() const { return m_rowSize; }
+        size_t GetPayloadSize() const { return m_rowSize * m_height; }
+
+        //! Writes 'rows' rows of the frame to the destination
+        void Fill( void *dst, uint64_t frameId, size_t rows ) const
+        {
+            if (m_data.empty() || !rows)
+                return;
+
+            size_t firstRow = 0;
+            if (m_pattern == PatternColorBarsMoving)
+                firstRow = static_cast<size_t>((frameId * 2) % m_height);
+            memcpy(dst, &m_data[firstRow * m_rowSize], rows * m_rowSize);
+        }
+
+    private:
+
+        // renders samples of the row: one sample per pixel for mono and Bayer, three for RGB/BGR
+        void RenderRow( uint32_t y, uint16_t *samples ) const
+        {
+            static const float bars[8][3] = { {1,1,1}, {1,1,0}, {0,1,1}, {0,1,0}, {1,0,1}, {1,0,0}, {0,0,1}, {0,0,0} };
+
+            const float maxValue = static_cast<float>((1u << m_format->depth) - 1);
+            const uint32_t sceneY = y % m_height;
+            const float brightness = 0.1f + 0.9f * (1.0f - static_cast<float>(sceneY) / m_height);
+
+            for (uint32_t x = 0; x < m_width; ++x)
+            {
+                uint32_t bar = x * 8 / m_width;
+                float rgb[3] = { bars[bar][0], bars[bar][1], bars[bar][2] };
+
+                // the last bar is the fine grey ramp
+                if (bar == 7)
+                    rgb[0] = rgb[1] = rgb[2] = static_cast<float>(x - m_width * 7 / 8) / (m_width - m_width * 7 / 8);
+
+                for (auto &c : rgb)
+                    c *= brightness;
+
+                switch (m_format->layout)
+                {
+                case LayoutMono:
+                    samples[x] = Quantize(0.299f * rgb[0] + 0.587f * rgb[1] + 0.114f * rgb[2], maxValue);
+                    break;
+                case LayoutRGB:
+                case LayoutBGR:
+                    for (int c = 0; c < 3; ++c)
+                        samples[x * 3 + c] = Quantize(rgb[m_format->layout == LayoutRGB ? c : 2 - c], maxValue);
+                    break;
+                default:
+                    samples[x] = Quantize(rgb[CfaChannel(m_format->layout, x, y)], maxValue);
+                    break;
+                }
+            }
+        }
+
+        // packs samples of the row according to the pixel type
+        void PackRow( const uint16_t *samples, uint8_t *dst ) const
+        {
+            const uint32_t pixelType = m_format->pixelType;
+            const uint32_t align = II_GET_PIXEL_ALIGNMENT(pixelType);
+
+            if (II_IS_PACKED_PIXEL_PFNC(pixelType))
+            {
+                // PFNC: continuous little-endian bit stream, LSB first
+                const uint32_t depth = m_format->depth;
+                uint64_t acc = 0;
+                uint32_t bits = 0;
+                for (uint32_t x = 0; x < m_width; ++x)
+                {
+                    acc |= static_cast<uint64_t>(samples[x]) << bits;
+                    bits += depth;
+                    while (bits >= 8)
+                    {
+                        *dst++ = static_cast<uint8_t>(acc);
+                        acc >>= 8;
+                        bits -= 8;
+                    }
+                }
+                if (bits)
+                    *dst = static_cast<uint8_t>(acc);
+            }
+            else if (II_IS_PACKED_PIXEL_GEV(pixelType))
+            {
+                // GEV: two pixels in three bytes, MSBs in the first and the last byte, LSBs in the middle
+                const uint32_t lsbBits = (align == II_ALIGN_10_PACKED_GEV) ? 2 : 4;
+                const uint16_t lsbMask = static_cast<uint16_t>((1u << lsbBits) - 1);
+                for (uint32_t x = 0; x + 1 < m_width; x += 2, dst += 3)
+                {
+                    dst[0] = static_cast<uint8_t>(samples[x] >> lsbBits);
+                    dst[1] = static_cast<uint8_t>((samples[x] & lsbMask) | ((samples[x + 1] & lsbMask) << 4));
+                    dst[2] = static_cast<uint8_t>(samples[x + 1] >> lsbBits);
+                }
+            }
+            else if (m_format->depth == 8)
+            {
+                const uint32_t count = (m_format->layout == LayoutRGB || m_format->layout == LayoutBGR) ? m_width * 3 : m_width;
+                for (uint32_t i = 0; i < count; ++i)
+                    dst[i] = static_cast<uint8_t>(samples[i]);
+            }
+            else
+            {
+                // unpacked high bit depth: LSB aligned little-endian 16-bit words
+                for (uint32_t x = 0; x < m_width; ++x)
+                {
+                    dst[x * 2] = static_cast<uint8_t>(samples[x]);
+                    dst[x * 2 + 1] = static_cast<uint8_t>(samples[x] >> 8);
+                }
+            }
+        }
+
+        static uint16_t Quantize( float value, float maxValue )
+        {
+            return static_cast<uint16_t>(value * maxValue + 0.5f);
+        }
+
+        // returns colour channel index (0 - R, 1 - G, 2 - B) of the Bayer CFA pixel
+        static int CfaChannel( PixelLayout layout, uint32_t x, uint32_t y )
+        {
+            static const int cfa[4][4] =
+            {
+                { 1, 0, 2, 1 }, // GR: G R / B G
+                { 0, 1, 1, 2 }, // RG: R G / G B
+                { 1, 2, 0, 1 }, // GB: G B / R G
+                { 2, 1, 1, 0 }, // BG: B G / G R
+            };
+            return cfa[layout - LayoutBayerGR][(y & 1) * 2 + (x & 1)];
+        }
+
+        uint32_t m_width, m_height;
+        const PixelFormatInfo *m_format;
+        int64_t m_pattern;
+        size_t m_rowSize;
+        std::vector<uint8_t> m_data;
+    };
+
+    class System;
+    class Interface;
+    class DeviceInfo;
+    class Device;
+    class Stream;
+
+    /**
+    \brief Buffer of the virtual stream
+    */
+    class Buffer : public IpxCam::Buffer
+    {
+    public:
+
+        //! An enumeration of buffer states in the acquisition engine
+        enum State
+        {
+            Announced,  /*!< Announced, owned by the application */
+            Queued,     /*!< In the input pool */
+            Filling,    /*!< Being filled by the producer */
+            Delivered   /*!< In the output queue */
+        };
+
+        Buffer( void *ptr, size_t size, void *pPrivate, bool owned, IpxCamMem::BufferAllocator *allocator = nullptr )
+            : m_state(Announced)
+            , m_ptr(ptr)
+            , m_size(size)
+            , m_private(pPrivate)
+            , m_owned(owned)
+            , m_allocator(allocator)
+            , m_pixelFormat(0)
+            , m_timestamp(0)
+            , m_frameId(0)
+            , m_incomplete(false)
+            , m_width(0)
+            , m_height(0)
+            , m_deliveredHeight(0)
+        {}
+
+        ~Buffer()
+        {
+            if (m_owned && m_allocator)
+                m_allocator->Free(m_ptr);
+            else if (m_owned)
+                AlignedFree(m_ptr);
+        }
+
+        virtual IpxImage* GetImage() { return &m_image; }
+        virtual void* GetBufferPtr() { return m_ptr; }
+        virtual size_t GetImageOffset() { return 0; }
+        virtual size_t GetBufferSize() { return m_size; }
+        virtual uint64_t GetPixelFormat() { return m_pixelFormat; }
+        virtual void* GetUserPtr() { return m_private; }
+        virtual uint64_t GetTimestamp() { return m_timestamp; }
+        virtual uint64_t GetFrameID() { return m_frameId; }
+        virtual bool IsIncomplete() { return m_incomplete; }
+        virtual size_t GetWidth() { return m_width; }
+        virtual size_t GetHeight() { return m_height; }
+        virtual size_t GetXOffset() { return 0; }
+        virtual size_t GetYOffset() { return 0; }
+        virtual size_t GetXPadding() { return 0; }
+        virtual size_t GetYPadding() { return 0; }
+        virtual size_t GetDeliveredHeight() { return m_deliveredHeight; }
+        virtual bool IsKacFrameB() { return false; }
+
+        //! Sets the frame information, called by the producer when the buffer is filled
+        void SetFrame( const PixelFormatInfo *format, const IpxPixelTypeDescr &descr, uint32_t width, uint32_t height,
+                       size_t rowSize, size_t deliveredHeight, uint64_t frameId, uint64_t timestamp )
+        {
+            m_pixelFormat = static_cast<uint64_t>(format->pfnc);
+            m_width = width;
+            m_height = height;
+            m_deliveredHeight = deliveredHeight;
+            m_incomplete = deliveredHeight < height;
+            m_frameId = frameId;
+            m_timestamp = timestamp;
+
+            m_image.pixelTypeDescr = descr;
+            m_image.width = width;
+            m_image.height = height;
+            m_image.rowSize = static_cast<uint32_t>(rowSize);
+            m_image.imageSize = static_cast<uint32_t>(rowSize * height);
+            m_image.timestamp = timestamp;
+            m_image.imageID = frameId;
+            m_image.imageData = static_cast<char*>(m_ptr);
+            m_image.imageDataOrigin = nullptr; // memory belongs to the stream
+        }
+
+        std::atomic<State> m_state;
+
+    private:
+        void *m_ptr;
+        size_t m_size;
+        void *m_private;
+        bool m_owned;
+        IpxCamMem::BufferAllocator *m_allocator;
+
+        uint64_t m_pixelFormat;
+        uint64_t m_timestamp;
+        uint64_t m_frameId;
+        bool m_incomplete;
+        size_t m_width, m_height, m_deliveredHeight;
+        IpxImage m_image;
+    };
+
+    /**
+    \brief Bounded lock-free multi-producer/multi-consumer ring of buffers, the output queue of the busy-poll mode.
+    \details Each cell carries a sequence number, which tells the producers and the consumers whether the cell is free
+    or filled for the current lap, so Push and Pop never take a lock.
+    */
+    class BufferRing
+    {
+    public:
+
+        //! Number of cells, the buffers beyond it go to the locked output queue until it is emptied
+        static const size_t Capacity = 1024;
+
+        BufferRing() : m_cells(new Cell[Capacity]), m_tail(0), m_head(0)
+        {
+            for (size_t i = 0; i < Capacity; ++i)
+                m_cells[i].seq.store(i, std::memory_order_relaxed);
+        }
+
+        //! Adds the buffer, returns false if the ring is full
+        bool Push( Buffer *buffer )
+        {
+            size_t pos = m_tail.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell &cell = m_cells[pos & (Capacity - 1)];
+                auto dif = static_cast<intptr_t>(cell.seq.load(std::memory_order_acquire)) - static_cast<intptr_t>(pos);
+                if (dif == 0)
+                {
+                    if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.buffer = buffer;
+                        cell.seq.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (dif < 0)
+                    return false;
+                else
+                    pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        //! Removes the oldest buffer, returns nullptr if the ring is empty
+        Buffer* Pop()
+        {
+            size_t pos = m_head.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell &cell = m_cells[pos & (Capacity - 1)];
+                auto dif = static_cast<intptr_t>(cell.seq.load(std::memory_order_acquire)) - static_cast<intptr_t>(pos + 1);
+                if (dif == 0)
+                {
+                    if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        auto buffer = cell.buffer;
+                        cell.seq.store(pos + Capacity, std::memory_order_release);
+                        return buffer;
+                    }
+                }
+                else if (dif < 0)
+                    return nullptr;
+                else
+                    pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+
+        //! Returns the approximate number of buffers in the ring
+        size_t Size() const
+        {
+            auto tail = m_tail.load(std::memory_order_acquire);
+            auto head = m_head.load(std::memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> seq;
+            Buffer *buffer;
+        };
+
+        std::unique_ptr<Cell[]> m_cells;
+        char m_pad0[64];
+        std::atomic<size_t> m_tail;
+        char m_pad1[64];
+        std::atomic<size_t> m_head;
+        char m_pad2[64];
+    };
+
+    /**
+    \brief Camera parameters of the virtual device. The stream reads them every frame without locking.
+    */
+    struct CameraParams
+    {
+        IpxGenParamImpl::Int     *width;
+        IpxGenParamImpl::Int     *height;
+        IpxGenParamImpl::Enum    *pixelFormat;
+        IpxGenParamImpl::Enum    *testPattern;
+        IpxGenParamImpl::Enum    *acquisitionMode;
+        IpxGenParamImpl::Int     *acquisitionFrameCount;
+        IpxGenParamImpl::Float   *frameRate;
+        IpxGenParamImpl::Boolean *frameRateEnable;
+        IpxGenParamImpl::Enum    *triggerMode;
+        IpxGenParamImpl::Int     *tlParamsLocked;
+        IpxGenParamImpl::Int     *timestampValue;
+        IpxGenParamImpl::Float   *dropProbability;
+        IpxGenParamImpl::Float   *incompleteProbability;
+        IpxGenParamImpl::Float   *timestampJitter;
+        IpxGenParamImpl::Int     *timestampOffset;
+        IpxGenParamImpl::Int     *randomSeed;
+    };
+
+    /**
+    \brief Data stream of the virtual camera.
+    \details The acquisition engine thread plays the role of the camera sensor and of the receive thread at once:
+    it takes the buffer from the input pool, fills it and puts it to the output queue or passes it to the EventNewBuffer callbacks.
+    */
+    class Stream : public IpxCam::Stream
+    {
+    public:
+
+        explicit Stream( Device *device );
+        ~Stream();
+
+        virtual void Release()
+        {
+            if (IsAcquisitionThread())
+                return;
+
+            // closing the stream stops the acquisition engine and revokes all the buffers
+            StopAcquisition(1);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_input.clear();
+            m_output.clear();
+            m_numOutput = 0;
+            m_buffers.clear();
+        }
+
+        virtual IpxCam::Buffer* CreateBuffer( size_t iSize, void *pPrivate, IpxCamErr *err )
+        {
+            if (m_allocator)
+            {
+                void *ptr = m_allocator->Allocate(iSize, GetBufferAlignment(), err);
+                return ptr ? Announce(new Buffer(ptr, iSize, pPrivate, true, m_allocator), err) : nullptr;
+            }
+
+            void *ptr = iSize ? AlignedAlloc(iSize, GetBufferAlignment()) : nullptr;
+            if (!ptr)
+            {
+                IpxGenParamImpl::SetErr(err, IPX_CAM_ERR_INVALID_ARGUMENT);
+                return nullptr;
+            }
+            return Announce(new Buffer(ptr, iSize, pPrivate, true), err);
+        }
+
+        //! Sets the allocator of the memory of CreateBuffer and AllocBufferQueue, nullptr - the default heap allocation
+        /*!
+        The allocator is used for the buffers created after the call and must outlive them.
+        */
+        void SetAllocator( IpxCamMem::BufferAllocator *allocator ) { m_allocator = allocator; }
+
+        virtual IpxCam::Buffer* SetBuffer( void *pBuffer, size_t iSize, void *pPrivate, IpxCamErr *err )
+        {
+            if (!pBuffer || !iSize)
+            {
+                IpxGenParamImpl::SetErr(err, IPX_CAM_ERR_INVALID_ARGUMENT);
+                return nullptr;
+            }
+            return Announce(new Buffer(pBuffer, iSize, pPrivate, false), err);
+        }
+
+        virtual IpxCamErr RevokeBuffer( IpxCam::Buffer *buff )
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            DrainRing();
+            auto it = Find(buff);
+            if (it == m_buffers.end())
+                return IPX_CAM_ERR_INVALID_ARGUMENT;
+            if ((*it)->m_state == Buffer::Filling)
+                return IPX_CAM_ERR_INVALID_STATE;
+
+            Remove(m_input, it->get());
+            Remove(m_output, it->get());
+            m_numOutput = m_output.size();
+            m_buffers.erase(it);
+            return IPX_CAM_ERR_OK;
+        }
+
+        virtual IpxCamErr QueueBuffer( IpxCam::Buffer *buff )
+        {
+            return QueueBuffers(&buff, 1);
+        }
+
+        virtual IpxCam::Buffer* GetBuffer( uint64_t iTimeout, IpxCamErr *err = nullptr )
+        {
+            IpxCam::Buffer *buffer = nullptr;
+            GetBuffers(&buffer, 1, iTimeout, err);
+            return buffer;
+        }
+
+        //! Retrieves up to maxCount buffers from the output queue under a single lock
+        /*!
+        Waits for the first buffer the same way as GetBuffer does, then takes all the ready buffers without waiting.
+        \param[out] buffers array of at least maxCount elements, receives the buffers in the order of delivery
+        \param[in] maxCount maximum number of buffers to retrieve
+        \param[in] iTimeout timeout in milliseconds to wait for the first buffer, UINT64_MAX - infinite
+        \param[out] err returns IPX_CAM_ERR_TIMEOUT, IPX_CAM_ERR_ABORT (CancelBuffer) or IPX_CAM_ERR_OK
+        \return Returns the number of retrieved buffers
+        */
+        size_t GetBuffers( IpxCam::Buffer **buffers, size_t maxCount, uint64_t iTimeout, IpxCamErr *err = nullptr )
+        {
+            typedef std::chrono::steady_clock clock;
+
+            if (!buffers || !maxCount)
+            {
+                IpxGenParamImpl::SetErr(err, IPX_CAM_ERR_INVALID_ARGUMENT);
+                return 0;
+            }
+
+            const uint64_t cancelGen = m_cancelGen;
+            const auto start = clock::now();
+            const bool infinite = iTimeout == UINT64_MAX;
+            const auto timeout = std::chrono::milliseconds(infinite ? 0 : iTimeout);
+            size_t count = 0;
+            ++m_waiters;
+
+            // busy-poll mode: spin on the ring without touching the stream lock
+            if (m_busyPoll)
+            {
+                const auto spinTime = std::chrono::microseconds(m_spinTime->Value());
+                for (uint32_t i = 1; ; ++i)
+                {
+                    count = PopReady(buffers, maxCount);
+                    if (count || m_cancelGen != cancelGen)
+                        break;
+                    if (!(i & 0xff))
+                    {
+                        auto elapsed = clock::now() - start;
+                        if ((!infinite && elapsed >= timeout) || (spinTime.count() && elapsed >= spinTime))
+                            break;
+                    }
+                    CpuRelax();
+                }
+            }
+
+            if (!count)
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                auto ready = [&]{ return !m_output.empty() || m_ring.Size() || m_cancelGen != cancelGen; };
+                if (infinite)
+                    m_cvConsumer.wait(lock, ready);
+                else
+                    m_cvConsumer.wait_until(lock, start + timeout, ready);
+                count = TakeReady(buffers, maxCount);
+            }
+            --m_waiters;
+
+            if (!count)
+            {
+                IpxGenParamImpl::SetErr(err, m_cancelGen != cancelGen ? IPX_CAM_ERR_ABORT : IPX_CAM_ERR_TIMEOUT);
+                return 0;
+            }
+            IpxGenParamImpl::SetErr(err, IPX_CAM_ERR_OK);
+            return count;
+        }
+
+        //! Queues the batch of buffers to the input pool under a single lock
+        /*!
+        \param[in] buffers array of the buffers retrieved by GetBuffer/GetBuffers
+        \param[in] count number of the buffers in the array
+        \return Returns the error code of the first buffer, which could not be queued. The other buffers are queued anyway.
+        */
+        IpxCamErr QueueBuffers( IpxCam::Buffer *const *buffers, size_t count )
+        {
+            if (!buffers && count)
+                return IPX_CAM_ERR_INVALID_ARGUMENT;
+
+            IpxCamErr result = IPX_CAM_ERR_OK;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    IpxCamErr err = IPX_CAM_ERR_OK;
+                    auto it = Find(buffers[i]);
+                    if (it == m_buffers.end())
+                        err = IPX_CAM_ERR_INVALID_ARGUMENT;
+                    // the buffer passed to EventNewBuffer callback can be queued once before the callback returns
+                    else if ((*it)->m_state != Buffer::Announced && !((*it)->m_state == Buffer::Filling && it->get() == m_dispatched))
+                        err = IPX_CAM_ERR_INVALID_STATE;
+
+                    if (err != IPX_CAM_ERR_OK)
+                    {
+                        if (result == IPX_CAM_ERR_OK)
+                            result = err;
+                        continue;
+                    }
+                    (*it)->m_state = Buffer::Queued;
+                    m_input.push_back(it->get());
+                }
+            }
+            m_cvProducer.notify_one();
+            return result;
+        }
+
+        virtual IpxCamErr CancelBuffer()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_waiters)
+                    return IPX_CAM_ERR_OK;
+                ++m_cancelGen; // also stops the spinning waiters
+            }
+            m_cvConsumer.notify_all();
+            return IPX_CAM_ERR_OK;
+        }
+
+        virtual IpxCamErr FlushBuffers( IpxCam::FlushOperation operation )
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            DrainRing();
+            switch (operation)
+            {
+            case IpxCam::Flush_OutputDiscard:
+                SetState(m_output, Buffer::Announced);
+                m_output.clear();
+                break;
+            case IpxCam::Flush_AllToInput:
+            case IpxCam::Flush_UnqueuedToInput:
+                if (operation == IpxCam::Flush_AllToInput)
+                {
+                    SetState(m_output, Buffer::Announced);
+                    m_output.clear();
+                }
+                for (auto &buffer : m_buffers)
+                {
+                    if (buffer->m_state == Buffer::Announced)
+                    {
+                        buffer->m_state = Buffer::Queued;
+                        m_input.push_back(buffer.get());
+                    }
+                }
+                break;
+            case IpxCam::Flush_AllDiscard:
+                SetState(m_input, Buffer::Announced);
+                SetState(m_output, Buffer::Announced);
+                m_input.clear();
+                m_output.clear();
+                break;
+            default:
+                return IPX_CAM_ERR_INVALID_ARGUMENT;
+            }
+            m_numOutput = m_output.size();
+            m_cvProducer.notify_one();
+            return IPX_CAM_ERR_OK;
+        }
+
+        virtual IpxCamErr StartAcquisition( uint64_t iNumFramesToAcquire = UINT64_MAX, uint32_t flags = 0 );
+
+        virtual IpxCamErr StopAcquisition( uint32_t flags = 0 )
+        {
+            (void)flags; // the buffer is filled synchronously, there is nothing to abort
+            if (IsAcquisitionThread())
+                return IPX_CAM_ERR_INVALID_STATE;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_grabbing)
+                    return IPX_CAM_ERR_OK;
+                m_stop = true;
+            }
+            m_cvProducer.notify_all();
+            if (m_thread.joinable())
+                m_thread.join();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_threadId = 0;
+            m_grabbing = false;
+            m_busyPoll = false;
+            DrainRing();
+            return IPX_CAM_ERR_OK;
+        }
+
+        virtual IpxCamErr AllocBufferQueue( void *pPrivate, size_t iNum )
+        {
+            auto size = GetBufferSize();
+            for (size_t i = 0; i < iNum; ++i)
+            {
+                IpxCamErr err = IPX_CAM_ERR_OK;
+                auto buffer = static_cast<Buffer*>(CreateBuffer(size, pPrivate, &err));
+                if (!buffer)
+                    return err;
+                m_queueBuffers.push_back(buffer);
+            }
+            return IPX_CAM_ERR_OK;
+        }
+
+        virtual IpxCamErr ReleaseBufferQueue()
+        {
+            for (auto buffer : m_queueBuffers)
+                RevokeBuffer(buffer);
+            m_queueBuffers.clear();
+            return IPX_CAM_ERR_OK;
+        }
+
+        virtual size_t GetBufferQueueSize() { return m_queueBuffers.size(); }
+
+        virtual IpxCamErr RegisterEvent( uint32_t eventType, IpxCam::EventCallback *eventCallback, void *pPrivate )
+        {
+            return m_events.Register(eventType, nullptr, eventCallback, pPrivate);
+        }
+
+        virtual IpxCamErr RegisterEvent2( uint32_t eventType, IpxCam::EventCallback2 *eventCallback, void *pPrivate )
+        {
+            return m_events.Register(eventType, eventCallback, nullptr, pPrivate);
+        }
+
+        virtual IpxCamErr UnRegisterEvent( uint32_t eventType, IpxCam::EventCallback *eventCallback, void *pPrivate )
+        {
+            return m_events.Unregister(eventType, nullptr, eventCallback, pPrivate);
+        }
+
+        virtual IpxCamErr UnRegisterEvent2( uint32_t eventType, IpxCam::EventCallback2 *eventCallback, void *pPrivate )
+        {
+            return m_events.Unregister(eventType, eventCallback, nullptr, pPrivate);
+        }
+
+        virtual IpxGenParam::Array* GetParameters( IpxCamErr *err = nullptr )
+        {
+            IpxGenParamImpl::SetErr(err, IPX_CAM_ERR_OK);
+            return &m_params;
+        }
+
+        virtual uint64_t GetNumDelivered() { return m_numDelivered; }
+        virtual uint64_t GetNumUnderrun() { return m_numUnderrun; }
+        virtual size_t GetNumAnnounced() { std::lock_guard<std::mutex> lock(m_mutex); return m_buffers.size(); }
+        virtual size_t GetNumQueued() { std::lock_guard<std::mutex> lock(m_mutex); return m_input.size(); }
+        //! Returns the number of the buffers in the output queue. It does not take the stream lock and can be polled at any rate.
+        virtual size_t GetNumAwaitDelivery() { return m_numOutput.load(std::memory_order_relaxed) + m_ring.Size(); }
+        virtual size_t GetBufferSize();
+        virtual bool IsGrabbing() { std::lock_guard<std::mutex> lock(m_mutex); return m_grabbing; }
+        virtual size_t GetMinNumBuffers() { return 4; }
+        virtual size_t GetBufferAlignment() { return 64; }
+
+        //! Returns the statistics of the delivered frames, updated by the acquisition thread and reset by StartAcquisition
+        const IpxCamStats::StreamStats& GetStatistics() const { return m_stats; }
+
+        //! Wakes up the acquisition engine, called by the device when the camera state is changed
+        void Notify()
+        {
+            { std::lock_guard<std::mutex> lock(m_mutex); }
+            m_cvProducer.notify_all();
+        }
+
+    private:
+
+        typedef std::vector<std::unique_ptr<Buffer>> BufferVector;
+
+        IpxCam::Buffer* Announce( Buffer *buffer, IpxCamErr *err )
+        {
+            // announced buffers go directly to the input pool, as they do in the camera library
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_buffers.emplace_back(buffer);
+                buffer->m_state = Buffer::Queued;
+                m_input.push_back(buffer);
+            }
+            m_cvProducer.notify_one();
+            IpxGenParamImpl::SetErr(err, IPX_CAM_ERR_OK);
+            return buffer;
+        }
+
+        BufferVector::iterator Find( IpxCam::Buffer *buff )
+        {
+            return std::find_if(m_buffers.begin(), m_buffers.end(),
+                [buff](const std::unique_ptr<Buffer> &b){ return b.get() == buff; });
+        }
+
+        static void Remove( std::deque<Buffer*> &queue, Buffer *buffer )
+        {
+            queue.erase(std::remove(queue.begin(), queue.end(), buffer), queue.end());
+        }
+
+        static void SetState( std::deque<Buffer*> &queue, Buffer::State state )
+        {
+            for (auto buffer : queue)
+                buffer->m_state = state;
+        }
+
+        // takes the ready buffers from the ring, and from the output queue if the ring has overflowed
+        size_t PopReady( IpxCam::Buffer **buffers, size_t maxCount )
+        {
+            size_t count = 0;
+            for (Buffer *buffer; count < maxCount && (buffer = m_ring.Pop()) != nullptr; )
+            {
+                buffer->m_state = Buffer::Announced;
+                buffers[count++] = buffer;
+            }
+            if (count < maxCount && m_numOutput.load(std::memory_order_relaxed))
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                count += TakeReady(buffers + count, maxCount - count);
+            }
+            return count;
+        }
+
+        // takes the ready buffers from the ring and the output queue, the lock must be held. The producer fills the ring
+        // only while the output queue is empty, so the buffers in the ring are older than the ones in the queue.
+        size_t TakeReady( IpxCam::Buffer **buffers, size_t maxCount )
+        {
+            size_t count = 0;
+            for (Buffer *buffer; count < maxCount && (buffer = m_ring.Pop()) != nullptr; )
+            {
+                buffer->m_state = Buffer::Announced;
+                buffers[count++] = buffer;
+            }
+            while (count < maxCount && !m_output.empty())
+            {
+                auto buffer = m_output.front();
+                m_output.pop_front();
+                buffer->m_state = Buffer::Announced;
+                buffers[count++] = buffer;
+            }
+            m_numOutput = m_output.size();
+            return count;
+        }
+
+        // moves the buffers from the ring to the front of the output queue, the lock must be held
+        void DrainRing()
+        {
+            size_t count = 0;
+            for (Buffer *buffer; (buffer = m_ring.Pop()) != nullptr; ++count)
+                m_output.push_back(buffer);
+            std::rotate(m_output.begin(), m_output.end() - count, m_output.end());
+            m_numOutput = m_output.size();
+        }
+
+        IpxCamErr ApplyThreadAffinity( const std::vector<int> &cpus );
+        IpxCamErr ApplyThreadScheduling( int64_t policy, int64_t priority );
+
+        bool IsAcquisitionThread() const { return std::this_thread::get_id() == m_thread.get_id(); }
+
+        void Run();
+
+        Device *m_device;
+        IpxGenParamImpl::Array m_params;
+        EventRegistry m_events;
+
+        std::mutex m_mutex;
+        std::condition_variable m_cvProducer;
+        std::condition_variable m_cvConsumer;
+        std::thread m_thread;
+
+        BufferVector m_buffers;
+        std::deque<Buffer*> m_input;
+        std::deque<Buffer*> m_output;
+        std::vector<Buffer*> m_queueBuffers;
+        BufferRing m_ring;
+        IpxCamMem::BufferAllocator *m_allocator;
+        IpxGenParamImpl::Int *m_spinTime;
+        IpxGenParamImpl::String *m_threadAffinity;
+        IpxGenParamImpl::Enum *m_threadPolicy;
+        IpxGenParamImpl::Int *m_threadPriority;
+        IpxGenParamImpl::String *m_threadStatus;
+        IpxGenParamImpl::String *m_threadCpus;
+        IpxCamStats::StreamStats m_stats;
+
+        bool m_grabbing;
+        bool m_stop;
+        std::atomic<bool> m_busyPoll;
+        uint64_t m_framesToAcquire;
+        std::atomic<uint64_t> m_cancelGen;
+        std::atomic<uint32_t> m_waiters;
+        Buffer *m_dispatched;
+        std::atomic<uint64_t> m_numDelivered;
+        std::atomic<uint64_t> m_numUnderrun;
+        std::atomic<size_t> m_numOutput;
+        std::atomic<int64_t> m_threadId;
+    };
+
+    /**
+    \brief Virtual camera device
+    */
+    class Device : public IpxCam::Device
+    {
+    public:
+
+        explicit Device( DeviceInfo *info );
+        ~Device();
+
+        virtual void Release() { delete this; }
+        virtual uint32_t GetNumStreams() { return 1; }
+        virtual IpxCam::Stream* GetStreamByIndex( uint32_t idx = 0 ) { return idx == 0 ? m_stream.get() : nullptr; }
+        virtual IpxCam::Stream* GetStreamById( const char *id ) { return (id && !strcmp(id, "Stream0")) ? m_stream.get() : nullptr; }
+        virtual IpxCam::DeviceInfo* GetInfo();
+
+        virtual IpxCamErr ReadMem( uint64_t addr, void *data, size_t len )
+        {
+            std::lock_guard<std::mutex> lock(m_memMutex);
+            if (!data || addr + len > m_memory.size() || addr + len < addr)
+                return IPX_CAM_ERR_INVALID_ARGUMENT;
+            memcpy(data, &m_memory[static_cast<size_t>(addr)], len);
+            return IPX_CAM_ERR_OK;
+        }
+
+        virtual IpxCamErr WriteMem( uint64_t addr, const void *data, size_t len, size_t *written )
+        {
+            std::lock_guard<std::mutex> lock(m_memMutex);
+            if (!data || addr + len > m_memory.size() || addr + len < addr)
+                return IPX_CAM_ERR_INVALID_ARGUMENT;
+            memcpy(&m_memory[static_cast<size_t>(addr)], data, len);
+            if (written)
+                *written = len;
+            return IPX_CAM_ERR_OK;
+        }
+
+        virtual IpxCamErr RegisterEvent2( uint32_t eventType, IpxCam::EventCallback2 *eventCallback, void *pPrivate )
+        {
+            return m_events.Register(eventType, eventCallback, nullptr, pPrivate);
+        }
+
+        virtual IpxCamErr RegisterEvent( uint32_t eventType, IpxCam::EventCallback *eventCallback, void *pPrivate )
+        {
+            return m_events.Register(eventType, nullptr, eventCallback, pPrivate);
+        }
+
+        virtual IpxCamErr UnRegisterEvent2( uint32_t eventType, IpxCam::EventCallback2 *eventCallback, void *pPrivate )
+        {
+            return m_events.Unregister(eventType, eventCallback, nullptr, pPrivate);
+        }
+
+        virtual IpxCamErr UnRegisterEvent( uint32_t eventType, IpxCam::EventCallback *eventCallback, void *pPrivate )
+        {
+            return m_events.Unregister(eventType, nullptr, eventCallback, pPrivate);
+        }
+
+        virtual IpxGenParam::Array* GetTransportParameters( IpxCamErr *err = nullptr )
+        {
+            IpxGenParamImpl::SetErr(err, IPX_CAM_ERR_OK);
+            return &m_tlParams;
+        }
+
+        virtual IpxGenParam::Array* GetCameraParameters( IpxCamErr *err = nullptr )
+        {
+            IpxGenParamImpl::SetErr(err, IPX_CAM_ERR_OK);
+            return &m_params;
+        }
+
+        virtual IpxCamErr SaveConfiguration( const char *fileName );
+        virtual IpxCamErr LoadConfiguration( const char *fileName );
+
+        virtual Endianness GetEndianness() const { return LittleEndian; }
+
+        //! Returns the camera parameters used by the stream
+        const CameraParams& Params() const { return m_cp; }
+
+        //! Returns current value of the camera timestamp counter in ticks (nanoseconds)
+        uint64_t GetTimestamp() const
+        {
+            return static_cast<uint64_t>(GetSteadyTime() - m_epoch.load(std::memory_order_relaxed) + m_cp.timestampOffset->Value());
+        }
+
+        //! Returns the host steady clock in nanoseconds
+        static int64_t GetSteadyTime()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        //! Returns true if the camera is streaming (AcquisitionStart executed)
+        bool IsAcquiring() const { return m_acquiring; }
+
+        //! Called by the stream when a frame is sent, returns false if no more frames should be sent
+        bool OnFrameSent()
+        {
+            int64_t left = m_framesLeft;
+            if (left > 0 && --m_framesLeft == 0)
+                m_acquiring = false;
+            return m_acquiring;
+        }
+
+        //! Takes one pending trigger, returns false if there is no trigger
+        bool TakeTrigger()
+        {
+            int64_t pending = m_pendingTriggers;
+            while (pending > 0)
+                if (m_pendingTriggers.compare_exchange_weak(pending, pending - 1))
+                    return true;
+            return false;
+        }
+
+    private:
+
+        void CreateParameters();
+
+        DeviceInfo *m_info;
+        CameraParams m_cp;
+        IpxGenParamImpl::Array m_params;
+        IpxGenParamImpl::Array m_tlParams;
+        EventRegistry m_events;
+        std::unique_ptr<Stream> m_stream;
+
+        std::atomic<int64_t> m_epoch;   // GetSteadyTime of the timestamp 0, GevTimestampControlReset moves it
+        std::atomic<bool> m_acquiring;
+        std::atomic<int64_t> m_framesLeft;
+        std::atomic<int64_t> m_pendingTriggers;
+
+        std::mutex m_memMutex;
+        std::vector<uint8_t> m_memory;
+    };
+
+    /**
+    \brief Information about the virtual device
+    */
+    class DeviceInfo : public IpxCam::DeviceInfo
+    {
+    public:
+
+        DeviceInfo( Interface *iface, uint32_t index )
+            : m_iface(iface)
+            , m_index(index)
+            , m_open(false)
+        {
+            char buf[64];
+            snprintf(buf, sizeof(buf), "VirtualCamera%u", index);
+            m_id = buf;
+            snprintf(buf, sizeof(buf), "VC%06u", index + 1);
+            m_serial = buf;
+            m_displayName = "Imperx Virtual Camera (" + m_serial + ")";
+        }
+
+        virtual IpxCam::Interface* GetInterface();
+        virtual const char* GetID() { return m_id.c_str(); }
+        virtual const char* GetVendor() { return "Imperx"; }
+        virtual const char* GetModel() { return "Virtual Camera"; }
+        virtual const char* GetDisplayName() { return m_displayName.c_str(); }
+        virtual const char* GetUserDefinedName() { return ""; }
+        virtual const char* GetSerialNumber() { return m_serial.c_str(); }
+        virtual const char* GetVersion() { return "1.0.0"; }
+
+        virtual int32_t GetAccessStatus()
+        {
+            return m_open ? AccessStatusNoAccess : AccessStatusReadWrite;
+        }
+
+        virtual const char* GetUSB3HostInfo() { return ""; }
+
+        // the virtual device has no network configuration
+        virtual const char* GetIPAddress( IpxCamErr *err ) { IpxGenParamImpl::SetErr(err, IPX_CAM_ERR_INVALID_STATE); return ""; }
+        virtual const char* GetIPMask( IpxCamErr *err ) { IpxGenParamImpl::SetErr(err, IPX_CAM_ERR_INVALID_STATE); return ""; }
+        virtual const char* GetIPGateway( IpxCamErr *err ) { IpxGenParamImpl::SetErr(err, IPX_CAM_ERR_INVALID_STATE); return ""; }
+        virtual IpxCamErr GetIP( uint32_t*, uint32_t*, uint32_t* ) { return IPX_CAM_ERR_INVALID_STATE; }
+        virtual IpxCamErr ForceIP( const char*, const char*, const char* ) { return IPX_CAM_ERR_INVALID_STATE; }
+        virtual IpxCamErr ForceIP( uint32_t, uint32_t, uint32_t ) { return IPX_CAM_ERR_INVALID_STATE; }
+
+        //! Opens the virtual device. Only one device object can exist for the device info at a time.
+        IpxCam::Device* CreateDevice( IpxCamErr *err = nullptr )
+        {
+            bool expected = false;
+            if (!m_open.compare_exchange_strong(expected, true))
+            {
+                IpxGenParamImpl::SetErr(err, IPX_CAM_ERR_INVALID_STATE);
+                return nullptr;
+            }
+            IpxGenParamImpl::SetErr(err, IPX_CAM_ERR_OK);
+            return new Device(this);
+        }
+
+        uint32_t GetIndex() const { return m_index; }
+
+    private:
+        friend class Device;
+
+        Interface *m_iface;
+        uint32_t m_index;
+        std::atomic<bool> m_open;
+        std::string m_id;
+        std::string m_serial;
+        std::string m_displayName;
+    };
+
+    /**
+    \brief Virtual interface, enumerates the virtual devices
+    */
+    class Interface : public IpxCam::Interface
+    {
+    public:
+
+        explicit Interface( size_t numDevices )
+            : m_numDevices(std::min(std::max<size_t>(numDevices, 1), MaxDevices))
+        {
+            m_deviceCount = m_params.Add(new IpxGenParamImpl::Int("VirtualDeviceCount", static_cast<int64_t>(m_numDevices), 1,
+                static_cast<int64_t>(MaxDevices), 1, "Number of virtual devices enumerated after ReEnumerateDevices"));
+            for (size_t i = 0; i < MaxDevices; ++i)
+                m_devices.emplace_back(new DeviceInfo(this, static_cast<uint32_t>(i)));
+        }
+
+        virtual IpxCam::DeviceInfoList* GetDeviceInfoList()
+        {
+            std::vector<IpxCam::DeviceInfo*> items;
+            for (size_t i = 0; i < m_numDevices; ++i)
+                items.push_back(m_devices[i].get());
+            return new List<IpxCam::DeviceInfo>(items);
+        }
+
+        virtual IpxCam::DeviceInfo* GetFirstDeviceInfo() { return m_devices[0].get(); }
+
+        virtual IpxCam::DeviceInfo* GetDeviceInfoById( const char *deviceId )
+        {
+            for (size_t i = 0; deviceId && i < m_numDevices; ++i)
+                if (!strcmp(m_devices[i]->GetID(), deviceId))
+                    return m_devices[i].get();
+            return nullptr;
+        }
+
+        virtual IpxCamErr ReEnumerateDevices( bool *pChanged, uint64_t /*iTimeout*/ )
+        {
+            auto count = static_cast<size_t>(m_deviceCount->Value());
+            if (pChanged)
+                *pChanged = count != m_numDevices;
+            m_numDevices = count;
+            return IPX_CAM_ERR_OK;
+        }
+
+        virtual const char* GetDescription() { return "Imperx Virtual Camera Interface"; }
+        virtual IpxCam::InterfaceType GetType() { return VirtualInterface; }
+        virtual const char* GetId() { return "VirtualInterface"; }
+        virtual const char* GetVersion() { return "1.0"; }
+
+        virtual IpxCamErr RegisterEvent2( uint32_t eventType, IpxCam::EventCallback2 *eventCallback, void *pPrivate )
+        {
+            return m_events.Register(eventType, eventCallback, nullptr, pPrivate);
+        }
+
+        virtual IpxCamErr RegisterEvent( uint32_t eventType, IpxCam::EventCallback *eventCallback, void *pPrivate )
+        {
+            return m_events.Register(eventType, nullptr, eventCallback, pPrivate);
+        }
+
+        virtual IpxCamErr UnRegisterEvent2( uint32_t eventType, IpxCam::EventCallback2 *eventCallback, void *pPrivate )
+        {
+            return m_events.Unregister(eventType, eventCallback, nullptr, pPrivate);
+        }
+
+        virtual IpxCamErr UnRegisterEvent( uint32_t eventType, IpxCam::EventCallback *eventCallback, void *pPrivate )
+        {
+            return m_events.Unregister(eventType, nullptr, eventCallback, pPrivate);
+        }
+
+        virtual IpxGenParam::Array* GetParameters( IpxCamErr *err = nullptr )
+        {
+            IpxGenParamImpl::SetErr(err, IPX_CAM_ERR_OK);
+            return &m_params;
+        }
+
+        //! Opens the first free virtual device and loads the configuration saved by Device::SaveConfiguration
+        virtual IpxCam::Device* CreateDeviceFromConfig( const char *fileName, IpxCamErr *err = nullptr )
+        {
+            for (size_t i = 0; i < m_numDevices; ++i)
+            {
+                if (m_devices[i]->GetAccessStatus() != IpxCam::DeviceInfo::AccessStatusReadWrite)
+                    continue;
+
+                auto device = m_devices[i]->CreateDevice(err);
+                if (!device)
+                    continue;
+
+                auto res = device->LoadConfiguration(fileName);
+                if (res != IPX_CAM_ERR_OK)
+                {
+                    device->Release();
+                    IpxGenParamImpl::SetErr(err, res);
+                    return nullptr;
+                }
+                return device;
+            }
+            IpxGenParamImpl::SetErr(err, IPX_CAM_ERR_NO_DEVICE);
+            return nullptr;
+        }
+
+    private:
+        size_t m_numDevices;
+        IpxGenParamImpl::Array m_params;
+        IpxGenParamImpl::Int *m_deviceCount;
+        EventRegistry m_events;
+        std::vector<std::unique_ptr<DeviceInfo>> m_devices;
+    };
+
+    /**
+    \brief System wrapper, adds the virtual interface to the interfaces of the wrapped system
+    */
+    class System : public IpxCam::System
+    {
+    public:
+
+        System( IpxCam::System *system, size_t numDevices )
+            : m_system(system)
+            , m_iface(numDevices)
+        {}
+
+        virtual void Release()
+        {
+            if (m_system)
+                m_system->Release();
+            delete this;
+        }
+
+        virtual IpxCam::InterfaceList* GetInterfaceList( IpxCam::InterfaceType type = IpxCam::AllInterfaces )
+        {
+            std::vector<IpxCam::Interface*> items;
+            if (m_system && type != VirtualInterface)
+            {
+                auto list = m_system->GetInterfaceList(type);
+                if (list)
+                {
+                    for (auto iface = list->GetFirst(); iface; iface = list->GetNext())
+                        items.push_back(iface);
+                    list->Release();
+                }
+            }
+            if (type == IpxCam::AllInterfaces || type == VirtualInterface)
+                items.push_back(&m_iface);
+            return new List<IpxCam::Interface>(items);
+        }
+
+        virtual IpxCam::Interface* GetInterfaceById( const char *ifaceId )
+        {
+            if (ifaceId && !strcmp(ifaceId, m_iface.GetId()))
+                return &m_iface;
+            return m_system ? m_system->GetInterfaceById(ifaceId) : nullptr;
+        }
+
+        virtual const char* GetDisplayName() { return m_system ? m_system->GetDisplayName() : "Imperx Virtual Camera System"; }
+        virtual const char* GetVersion() { return m_system ? m_system->GetVersion() : "1.0"; }
+
+        virtual IpxCam::Device* CreateDeviceFromConfig( const char *fileName, IpxCamErr *err = nullptr )
+        {
+            if (IsVirtualConfig(fileName) || !m_system)
+                return m_iface.CreateDeviceFromConfig(fileName, err);
+            return m_system->CreateDeviceFromConfig(fileName, err);
+        }
+
+        virtual IpxCamErr RegisterGenTLProvider( const char *fileName )
+        {
+            return m_system ? m_system->RegisterGenTLProvider(fileName) : IPX_CAM_ERR_INVALID_STATE;
+        }
+
+        //! Returns true if the file has been written by SaveConfiguration of the virtual device
+        static bool IsVirtualConfig( const char *fileName )
+        {
+            std::ifstream file(fileName ? fileName : "");
+            std::string line;
+            return std::getline(file, line) && line == ConfigHeader();
+        }
+
+        static const char* ConfigHeader() { return "# Imperx Virtual Camera configuration"; }
+
+    private:
+        IpxCam::System *m_system;
+        Interface m_iface;
+    };
+
+    //! Returns the number of virtual devices set by IPX_VIRTUAL_CAMERAS environment variable, 1 by default
+    inline size_t DefaultDeviceCount()
+    {
+        const char *env = getenv("IPX_VIRTUAL_CAMERAS");
+        long count = env ? strtol(env, nullptr, 10) : 1;
+        return count > 0 ? static_cast<size_t>(count) : 1;
+    }
+
+    //! Returns the system, which enumerates the interfaces of 'system' and the virtual interface
+    /*!
+    \param[in] system System object returned by IpxCam_GetSystem or nullptr for the virtual interface only. The wrapper takes the ownership.
+    \param[in] numDevices Number of virtual devices on the virtual interface
+    \return Returns the pointer to the System, which must be released by System::Release
+    */
+    inline IpxCam::System* GetSystem( IpxCam::System *system, size_t numDevices = DefaultDeviceCount() )
+    {
+        return new System(system, numDevices);
+    }
+
+    //! Creates the device. Virtual devices are created in process, all others are passed to IpxCam_CreateDevice.
+    /*!
+    \param[in] info Device info obtained from the interface
+    \param[in] access Device access mode, ignored for the virtual devices
+    \param[out] err returns the error code
+    \return Returns the pointer to Device
+    */
+    inline IpxCam::Device* CreateDevice( IpxCam::DeviceInfo *info, IpxCam::DeviceAccess access = IpxCam::Exclusive, IpxCamErr *err = nullptr )
+    {
+        if (auto virtualInfo = dynamic_cast<DeviceInfo*>(info))
+            return virtualInfo->CreateDevice(err);
+        return IpxCam::IpxCam_CreateDevice(info, access, err);
+    }
+
+    //! Retrieves up to maxCount ready buffers from any stream
+    /*!
+    The virtual stream drains its output queue under a single lock. For other streams the first buffer is waited by GetBuffer
+    and the rest are taken while GetNumAwaitDelivery reports the ready buffers.
+    \param[in] stream the data stream
+    \param[out] buffers array of at least maxCount elements
+    \param[in] maxCount maximum number of buffers to retrieve
+    \param[in] iTimeout timeout in milliseconds to wait for the first buffer
+    \param[out] err returns the error code of the first GetBuffer
+    \return Returns the number of retrieved buffers
+    */
+    inline size_t GetBuffers( IpxCam::Stream *stream, IpxCam::Buffer **buffers, size_t maxCount, uint64_t iTimeout, IpxCamErr *err = nullptr )
+    {
+        if (auto virtualStream = dynamic_cast<Stream*>(stream))
+            return virtualStream->GetBuffers(buffers, maxCount, iTimeout, err);
+
+        if (!stream || !buffers || !maxCount)
+        {
+            IpxGenParamImpl::SetErr(err, IPX_CAM_ERR_INVALID_ARGUMENT);
+            return 0;
+        }
+
+        size_t count = 0;
+        buffers[count] = stream->GetBuffer(iTimeout, err);
+        if (!buffers[count])
+            return 0;
+
+        for (++count; count < maxCount && stream->GetNumAwaitDelivery(); ++count)
+        {
+            buffers[count] = stream->GetBuffer(0);
+            if (!buffers[count])
+                break;
+        }
+        return count;
+    }
+
+    //! Queues the batch of buffers to any stream
+    /*!
+    \return Returns the error code of the first buffer, which could not be queued. The other buffers are queued anyway.
+    */
+    inline IpxCamErr QueueBuffers( IpxCam::Stream *stream, IpxCam::Buffer *const *buffers, size_t count )
+    {
+        if (auto virtualStream = dynamic_cast<Stream*>(stream))
+            return virtualStream->QueueBuffers(buffers, count);
+
+        if (!stream || (!buffers && count))
+            return IPX_CAM_ERR_INVALID_ARGUMENT;
+
+        IpxCamErr result = IPX_CAM_ERR_OK;
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto err = stream->QueueBuffer(buffers[i]);
+            if (result == IPX_CAM_ERR_OK)
+                result = err;
+        }
+        return result;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // Implementation
+
+    inline IpxCam::Interface* DeviceInfo::GetInterface() { return m_iface; }
+
+    inline Device::Device( DeviceInfo *info )
+        : m_info(info)
+        , m_epoch(GetSteadyTime())
+        , m_acquiring(false)
+        , m_framesLeft(0)
+        , m_pendingTriggers(0)
+        , m_memory(0x10000, 0)
+    {
+        CreateParameters();
+        m_stream.reset(new Stream(this));
+    }
+
+    inline Device::~Device()
+    {
+        m_stream.reset();
+        m_info->m_open = false;
+    }
+
+    inline IpxCam::DeviceInfo* Device::GetInfo() { return m_info; }
+
+    inline void Device::CreateParameters()
+    {
+        using namespace IpxGenParamImpl;
+
+        auto locked = [this]{ return m_cp.tlParamsLocked->Value() == 0; };
+        auto notify = [this]{ if (m_stream) m_stream->Notify(); return IPX_CAM_ERR_OK; };
+
+        // DeviceControl
+        auto cat = m_params.AddCategory("DeviceControl");
+        auto str = m_params.Add(new String("DeviceVendorName", m_info->GetVendor()), cat);
+        str->SetWritable(false);
+        str = m_params.Add(new String("DeviceModelName", m_info->GetModel()), cat);
+        str->SetWritable(false);
+        str = m_params.Add(new String("DeviceVersion", m_info->GetVersion()), cat);
+        str->SetWritable(false);
+        str = m_params.Add(new String("DeviceSerialNumber", m_info->GetSerialNumber()), cat);
+        str->SetWritable(false);
+        m_params.Add(new String("DeviceUserID", ""), cat);
+
+        // ImageFormatControl
+        cat = m_params.AddCategory("ImageFormatControl");
+        auto intParam = m_params.Add(new Int("WidthMax", 8192, 8192, 8192), cat);
+        intParam->SetWritable(false);
+        intParam = m_params.Add(new Int("HeightMax", 8192, 8192, 8192), cat);
+        intParam->SetWritable(false);
+        m_cp.width = m_params.Add(new Int("Width", 1920, 16, 8192, 8, "Width of the image in pixels"), cat);
+        m_cp.width->SetAccess(locked);
+        m_cp.height = m_params.Add(new Int("Height", 1080, 2, 8192, 2, "Height of the image in pixels"), cat);
+        m_cp.height->SetAccess(locked);
+
+        m_cp.pixelFormat = m_params.Add(new Enum("PixelFormat", "Format of the pixels provided by the device"), cat);
+        size_t count = 0;
+        auto formats = GetPixelFormats(&count);
+        for (size_t i = 0; i < count; ++i)
+            m_cp.pixelFormat->AddEntry(formats[i].name, formats[i].pfnc);
+        m_cp.pixelFormat->SetAccess(locked);
+
+        m_cp.testPattern = m_params.Add(new Enum("TestPattern", "Test pattern generated by the virtual sensor"), cat);
+        m_cp.testPattern->AddEntry("ColorBarsMoving", FrameSource::PatternColorBarsMoving);
+        m_cp.testPattern->AddEntry("ColorBars", FrameSource::PatternColorBars);
+        m_cp.testPattern->AddEntry("Off", FrameSource::PatternOff);
+
+        // AcquisitionControl
+        cat = m_params.AddCategory("AcquisitionControl");
+        m_cp.acquisitionMode = m_params.Add(new Enum("AcquisitionMode"), cat);
+        m_cp.acquisitionMode->AddEntry("Continuous", 0);
+        m_cp.acquisitionMode->AddEntry("SingleFrame", 1);
+        m_cp.acquisitionMode->AddEntry("MultiFrame", 2);
+        m_cp.acquisitionFrameCount = m_params.Add(new Int("AcquisitionFrameCount", 1, 1, 65535), cat);
+
+        m_params.Add(new Command("AcquisitionStart", [this]
+        {
+            auto mode = m_cp.acquisitionMode->Value();
+            m_framesLeft = mode == 1 ? 1 : (mode == 2 ? m_cp.acquisitionFrameCount->Value() : 0);
+            m_pendingTriggers = 0;
+            m_acquiring = true;
+            m_stream->Notify();
+            return IPX_CAM_ERR_OK;
+        }), cat);
+        m_params.Add(new Command("AcquisitionStop", [this]
+        {
+            m_acquiring = false;
+            m_stream->Notify();
+            return IPX_CAM_ERR_OK;
+        }), cat);
+        m_params.Add(new Command("AcquisitionAbort", [this]
+        {
+            m_acquiring = false;
+            m_stream->Notify();
+            return IPX_CAM_ERR_OK;
+        }), cat);
+
+        m_cp.frameRateEnable = m_params.Add(new Boolean("AcquisitionFrameRateEnable", true,
+            "If false, frames are generated as fast as the buffers are queued"), cat);
+        m_cp.frameRate = m_params.Add(new Float("AcquisitionFrameRate", 30.0, 0.1, 1000000.0, "Hz"), cat);
+        m_cp.frameRate->OnSet([notify](double){ return notify(); });
+
+        m_cp.triggerMode = m_params.Add(new Enum("TriggerMode"), cat);
+        m_cp.triggerMode->AddEntry("Off", 0);
+        m_cp.triggerMode->AddEntry("On", 1);
+        m_cp.triggerMode->OnSet([notify](int64_t){ return notify(); });
+        auto triggerSource = m_params.Add(new Enum("TriggerSource"), cat);
+        triggerSource->AddEntry("Software", 0);
+        m_params.Add(new Command("TriggerSoftware", [this]
+        {
+            if (m_acquiring)
+            {
+                ++m_pendingTriggers;
+                m_stream->Notify();
+            }
+            return IPX_CAM_ERR_OK;
+        }), cat);
+
+        // TransportLayerControl
+        cat = m_params.AddCategory("TransportLayerControl");
+        intParam = m_params.Add(new Int("PayloadSize", 0, 0, INT64_MAX), cat);
+        intParam->SetWritable(false);
+        intParam->SetGetter([this]
+        {
+            auto format = FindPixelFormat(m_cp.pixelFormat->Value());
+            return static_cast<int64_t>(IpxGetRowSizeUnaligned(format->pixelType, static_cast<uint32_t>(m_cp.width->Value())))
+                * m_cp.height->Value();
+        });
+        m_cp.tlParamsLocked = m_params.Add(new Int("TLParamsLocked", 0, 0, 1), cat);
+        m_cp.tlParamsLocked->SetVisibility(IpxGenParam::VisInvisible);
+
+        intParam = m_params.Add(new Int("GevTimestampTickFrequency", 1000000000, 1000000000, 1000000000), cat);
+        intParam->SetWritable(false);
+        m_cp.timestampValue = m_params.Add(new Int("GevTimestampValue", 0, 0, INT64_MAX), cat);
+        m_cp.timestampValue->SetWritable(false);
+        m_params.Add(new Command("GevTimestampControlLatch", [this]
+        {
+            m_cp.timestampValue->Store(static_cast<int64_t>(GetTimestamp()));
+            return IPX_CAM_ERR_OK;
+        }), cat);
+        m_params.Add(new Command("GevTimestampControlReset", [this]
+        {
+            m_epoch.store(GetSteadyTime(), std::memory_order_relaxed);
+            return IPX_CAM_ERR_OK;
+        }), cat);
+
+        // VirtualCameraControl, simulation of the transport errors
+        cat = m_params.AddCategory("VirtualCameraControl");
+        m_cp.dropProbability = m_params.Add(new Float("SimFrameDropProbability", 0.0, 0.0, 1.0, "",
+            "Probability of the frame to be lost before it reaches the host"), cat);
+        m_cp.incompleteProbability = m_params.Add(new Float("SimIncompleteFrameProbability", 0.0, 0.0, 1.0, "",
+            "Probability of the frame to be delivered incomplete"), cat);
+        m_cp.timestampJitter = m_params.Add(new Float("SimTimestampJitter", 0.0, 0.0, 1000000.0, "us",
+            "Maximum deviation of the frame timestamp from the ideal one"), cat);
+        m_cp.timestampOffset = m_params.Add(new Int("SimTimestampOffset", 0, 0, INT64_MAX / 2, 1,
+            "Offset of the device clock in ticks, to simulate unsynchronized cameras"), cat);
+        m_cp.randomSeed = m_params.Add(new Int("SimRandomSeed", 0, 0, INT64_MAX, 1,
+            "Seed of the error generator applied at StartAcquisition, 0 - random seed"), cat);
+
+        // transport layer parameters
+        str = m_tlParams.Add(new String("DeviceID", m_info->GetID()));
+        str->SetWritable(false);
+        str = m_tlParams.Add(new String("DeviceVendorName", m_info->GetVendor()));
+        str->SetWritable(false);
+        str = m_tlParams.Add(new String("DeviceModelName", m_info->GetModel()));
+        str->SetWritable(false);
+    }
+
+    inline IpxCamErr Device::SaveConfiguration( const char *fileName )
+    {
+        std::ofstream file(fileName ? fileName : "");
+        if (!file)
+            return IPX_CAM_ERR_FILE_NOT_FOUND;
+
+        file << System::ConfigHeader() << "\n";
+        for (uint32_t i = 0; i < m_params.GetCount(); ++i)
+        {
+            auto param = m_params.GetParamByIndex(i, nullptr);
+            if (!param->IsWritable() && param != m_cp.width && param != m_cp.height && param != m_cp.pixelFormat)
+                continue;
+
+            switch (param->GetType())
+            {
+            case IpxGenParam::ParamInt:
+                if (param != m_cp.tlParamsLocked)
+                    file << param->GetName() << "=" << param->ToInt()->GetValue() << "\n";
+                break;
+            case IpxGenParam::ParamFloat:
+                file << param->GetName() << "=" << param->ToFloat()->GetValue() << "\n";
+                break;
+            case IpxGenParam::ParamBoolean:
+                file << param->GetName() << "=" << (param->ToBoolean()->GetValue() ? 1 : 0) << "\n";
+                break;
+            case IpxGenParam::ParamEnum:
+                file << param->GetName() << "=" << param->ToEnum()->GetValueStr() << "\n";
+                break;
+            case IpxGenParam::ParamString:
+                file << param->GetName() << "=" << param->ToString()->GetValue() << "\n";
+                break;
+            default:
+                break;
+            }
+        }
+        return file ? IPX_CAM_ERR_OK : IPX_CAM_ERR_FILE_READ;
+    }
+
+    inline IpxCamErr Device::LoadConfiguration( const char *fileName )
+    {
+        if (!System::IsVirtualConfig(fileName))
+            return IPX_CAM_ERR_WRONG_CONFIGURATION;
+
+        std::ifstream file(fileName);
+        std::string line;
+        IpxCamErr result = IPX_CAM_ERR_OK;
+        while (std::getline(file, line))
+        {
+            auto pos = line.find('=');
+            if (line.empty() || line[0] == '#' || pos == std::string::npos)
+                continue;
+
+            auto name = line.substr(0, pos);
+            auto value = line.substr(pos + 1);
+            auto param = m_params.GetParam(name.c_str(), nullptr);
+            if (!param)
+            {
+                result = IPX_CAM_ERR_WRONG_CONFIGURATION;
+                continue;
+            }
+
+            IpxCamErr err = IPX_CAM_ERR_OK;
+            switch (param->GetType())
+            {
+            case IpxGenParam::ParamInt:
+                err = param->ToInt()->SetValue(strtoll(value.c_str(), nullptr, 10));
+                break;
+            case IpxGenParam::ParamFloat:
+                err = param->ToFloat()->SetValue(strtod(value.c_str(), nullptr));
+                break;
+            case IpxGenParam::ParamBoolean:
+                err = param->ToBoolean()->SetValue(value == "1");
+                break;
+            case IpxGenParam::ParamEnum:
+                err = param->ToEnum()->SetValueStr(value.c_str());
+                break;
+            case IpxGenParam::ParamString:
+                err = param->ToString()->SetValue(value.c_str());
+                break;
+            default:
+                break;
+            }
+            if (err != IPX_CAM_ERR_OK)
+                result = IPX_CAM_ERR_WRONG_CONFIGURATION;
+        }
+        return result;
+    }
+
+    inline Stream::Stream( Device *device )
+        : m_device(device)
+        , m_allocator(nullptr)
+        , m_grabbing(false)
+        , m_stop(false)
+        , m_busyPoll(false)
+        , m_framesToAcquire(0)
+        , m_cancelGen(0)
+        , m_waiters(0)
+        , m_dispatched(nullptr)
+        , m_numDelivered(0)
+        , m_numUnderrun(0)
+        , m_numOutput(0)
+        , m_threadId(0)
+    {
+        using namespace IpxGenParamImpl;
+
+        auto str = m_params.Add(new String("StreamID", "Stream0"));
+        str->SetWritable(false);
+
+        auto addCounter = [this](const char *name, std::function<int64_t()> getter)
+        {
+            auto param = m_params.Add(new Int(name, 0, 0, INT64_MAX));
+            param->SetWritable(false);
+            param->SetGetter(getter);
+        };
+        addCounter("StreamAnnouncedBufferCount", [this]{ return static_cast<int64_t>(GetNumAnnounced()); });
+        addCounter("StreamDeliveredFrameCount", [this]{ return static_cast<int64_t>(GetNumDelivered()); });
+        addCounter("StreamLostFrameCount", [this]{ return static_cast<int64_t>(GetNumUnderrun()); });
+        addCounter("StreamInputBufferCount", [this]{ return static_cast<int64_t>(GetNumQueued()); });
+        addCounter("StreamOutputBufferCount", [this]{ return static_cast<int64_t>(GetNumAwaitDelivery()); });
+        addCounter("StreamIncompleteFrameCount", [this]{ return static_cast<int64_t>(m_stats.GetSnapshot().incomplete); });
+        addCounter("StreamMissingFrameCount", [this]{ return static_cast<int64_t>(m_stats.GetSnapshot().dropped); });
+        auto rate = m_params.Add(new Float("StreamFrameRate", 0.0, 0.0, 1000000.0, "Hz",
+            "Frame rate by the timestamps of the last delivered frames"));
+        rate->SetWritable(false);
+        rate->SetGetter([this]{ return m_stats.GetSnapshot().fps; });
+        rate = m_params.Add(new Float("StreamBandwidth", 0.0, 0.0, 1000000.0, "MiB/s",
+            "Bandwidth of the last delivered frames"));
+        rate->SetWritable(false);
+        rate->SetGetter([this]{ return m_stats.GetSnapshot().bandwidth; });
+
+        m_spinTime = m_params.Add(new Int("StreamBusyPollSpinTime", 0, 0, INT64_MAX, 1,
+            "Time in microseconds GetBuffer spins in the busy-poll mode before it blocks, 0 - the whole timeout"));
+
+        // placement of the acquisition (receive) thread, applied at StartAcquisition and immediately while grabbing
+        auto cat = m_params.AddCategory("StreamThreadControl");
+        m_threadAffinity = m_params.Add(new String("StreamThreadAffinity", "", 256,
+            "CPUs the acquisition thread runs on, for example 2-3,6. Empty - all CPUs"), cat);
+        m_threadAffinity->OnSet([this](const char *val)
+        {
+            std::vector<int> cpus;
+            if (!IpxCamThread::ParseCpuList(val, &cpus))
+                return IPX_CAM_GENICAM_INVALID_ARGUMENT;
+            return ApplyThreadAffinity(cpus);
+        });
+
+        m_threadPolicy = m_params.Add(new Enum("StreamThreadPolicy", "Scheduling policy of the acquisition thread"), cat);
+        m_threadPolicy->AddEntry("Other", IpxCamThread::PolicyOther);
+        m_threadPolicy->AddEntry("FIFO", IpxCamThread::PolicyFifo);
+        m_threadPolicy->AddEntry("RoundRobin", IpxCamThread::PolicyRoundRobin);
+        m_threadPolicy->OnSet([this](int64_t val)
+        {
+            // switching the policy resets the priority to the lowest valid one
+            int64_t priority, maxPriority;
+            IpxCamThread::GetPriorityRange(static_cast<IpxCamThread::Policy>(val), &priority, &maxPriority);
+            if (val == IpxCamThread::PolicyOther)
+                priority = 0;
+            auto err = ApplyThreadScheduling(val, priority);
+            if (err == IPX_CAM_ERR_OK)
+                m_threadPriority->Store(priority);
+            return err;
+        });
+
+        m_threadPriority = m_params.Add(new Int("StreamThreadPriority", 0, -20, 99, 1,
+            "Nice value -20..19 for Other policy, real-time priority 1..99 for FIFO and RoundRobin"), cat);
+        m_threadPriority->OnSet([this](int64_t val)
+        {
+            // checked also before the acquisition starts, the thread gets the stored value
+            int64_t minPriority, maxPriority;
+            IpxCamThread::GetPriorityRange(static_cast<IpxCamThread::Policy>(m_threadPolicy->Value()), &minPriority, &maxPriority);
+            if (val < minPriority || val > maxPriority)
+                return IPX_CAM_ERR_INVALID_ARGUMENT;
+            return ApplyThreadScheduling(m_threadPolicy->Value(), val);
+        });
+
+        auto threadId = m_params.Add(new Int("StreamThreadId", 0, 0, INT64_MAX, 1,
+            "System ID of the acquisition thread, 0 if the acquisition is not started"), cat);
+        threadId->SetWritable(false);
+        threadId->SetGetter([this]{ return m_threadId.load(); });
+
+        m_threadCpus = m_params.Add(new String("StreamThreadCurrentAffinity", "", 256,
+            "CPUs the acquisition thread is allowed to run on, as reported by the system"), cat);
+        m_threadCpus->SetWritable(false);
+
+        m_threadStatus = m_params.Add(new String("StreamThreadStatus", "OK", 256,
+            "Result of the last attempt to apply the thread settings"), cat);
+        m_threadStatus->SetWritable(false);
+    }
+
+    inline IpxCamErr Stream::ApplyThreadAffinity( const std::vector<int> &cpus )
+    {
+        const int64_t threadId = m_threadId;
+        if (!threadId)
+            return IPX_CAM_ERR_OK;
+
+        std::string error;
+        auto err = IpxCamThread::SetAffinity(threadId, cpus, &error);
+        m_threadStatus->Store(err == IPX_CAM_ERR_OK ? "OK" : error);
+        m_threadCpus->Store(IpxCamThread::GetAffinity(threadId));
+        return err;
+    }
+
+    inline IpxCamErr Stream::ApplyThreadScheduling( int64_t policy, int64_t priority )
+    {
+        const int64_t threadId = m_threadId;
+        if (!threadId)
+            return IPX_CAM_ERR_OK;
+
+        std::string error;
+        auto err = IpxCamThread::SetScheduling(threadId, static_cast<IpxCamThread::Policy>(policy), priority, &error);
+        m_threadStatus->Store(err == IPX_CAM_ERR_OK ? "OK" : error);
+        return err;
+    }
+
+    inline Stream::~Stream()
+    {
+        StopAcquisition(1);
+    }
+
+    inline size_t Stream::GetBufferSize()
+    {
+        auto &cp = m_device->Params();
+        auto format = FindPixelFormat(cp.pixelFormat->Value());
+        return IpxGetRowSizeUnaligned(format->pixelType, static_cast<uint32_t>(cp.width->Value()))
+            * static_cast<size_t>(cp.height->Value());
+    }
+
+    inline IpxCamErr Stream::StartAcquisition( uint64_t iNumFramesToAcquire, uint32_t flags )
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_grabbing)
+            return IPX_CAM_ERR_INVALID_STATE;
+
+        m_busyPoll = (flags & AcqStartBusyPoll) != 0;
+        m_stats.Reset();
+        m_grabbing = true;
+        m_stop = false;
+        m_framesToAcquire = iNumFramesToAcquire;
+        m_thread = std::thread(&Stream::Run, this);
+        return IPX_CAM_ERR_OK;
+    }
+
+    inline void Stream::Run()
+    {
+        typedef std::chrono::steady_clock clock;
+
+        // the thread settings made before the start are applied by the thread itself, the failure is reported by StreamThreadStatus
+        m_threadId = IpxCamThread::GetCurrentThreadId();
+        std::vector<int> cpus;
+        if (IpxCamThread::ParseCpuList(m_threadAffinity->Value().c_str(), &cpus) && !cpus.empty())
+            ApplyThreadAffinity(cpus);
+        else
+            m_threadCpus->Store(IpxCamThread::GetAffinity(m_threadId));
+        if (m_threadPolicy->Value() != IpxCamThread::PolicyOther || m_threadPriority->Value() != 0)
+            ApplyThreadScheduling(m_threadPolicy->Value(), m_threadPriority->Value());
+
+        auto &cp = m_device->Params();
+        auto seed = cp.randomSeed->Value();
+        std::mt19937_64 rng(seed ? static_cast<uint64_t>(seed) : std::random_device()());
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+        FrameSource source;
+        IpxPixelTypeDescr descr;
+        const PixelFormatInfo *descrFormat = nullptr;
+        uint64_t frameId = 0, lastTimestamp = 0, lastCounter = 0;
+        auto nextFrame = clock::now();
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_stop)
+        {
+            // wait for the camera to start streaming
+            if (!m_device->IsAcquiring() || !m_framesToAcquire)
+            {
+                m_cvProducer.wait(lock);
+                nextFrame = clock::now();
+                continue;
+            }
+
+            const bool triggered = cp.triggerMode->Value() != 0;
+            const bool freeRun = !triggered && !cp.frameRateEnable->Value();
+            if (triggered)
+            {
+                // frame is exposed on the trigger only
+                if (!m_device->TakeTrigger())
+                {
+                    m_cvProducer.wait(lock);
+                    continue;
+                }
+            }
+            else if (freeRun)
+            {
+                // unlimited frame rate is throttled by the consumer, the sensor waits for a free buffer
+                if (m_input.empty())
+                {
+                    m_cvProducer.wait(lock);
+                    continue;
+                }
+            }
+            else
+            {
+                auto now = clock::now();
+                if (now < nextFrame)
+                {
+                    m_cvProducer.wait_until(lock, nextFrame);
+                    continue;
+                }
+
+                auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / cp.frameRate->Value()));
+                nextFrame += period;
+                // the sensor does not catch up, frames missed by a slow host are simply not generated
+                if (nextFrame < now)
+                    nextFrame = now + period;
+            }
+
+            // the frame is exposed, it gets the next block ID whether it reaches the host or not
+            ++frameId;
+            uint64_t timestamp = m_device->GetTimestamp();
+            // the counter restarts after GevTimestampControlReset, the timestamps increase from the restart
+            if (timestamp < lastCounter)
+                lastTimestamp = 0;
+            lastCounter = timestamp;
+            const double jitter = cp.timestampJitter->Value();
+            if (jitter > 0.0)
+            {
+                // the early frame does not go below the start of the counter
+                const int64_t offset = static_cast<int64_t>((uniform(rng) * 2.0 - 1.0) * jitter * 1000.0);
+                timestamp = offset < 0 && static_cast<uint64_t>(-offset) > timestamp ? 0 : timestamp + offset;
+            }
+            if (timestamp <= lastTimestamp)
+                timestamp = lastTimestamp + 1;
+            lastTimestamp = timestamp;
+
+            m_device->OnFrameSent();
+            if (m_framesToAcquire != UINT64_MAX)
+                --m_framesToAcquire;
+
+            if (cp.dropProbability->Value() > 0.0 && uniform(rng) < cp.dropProbability->Value())
+                continue;
+
+            if (m_input.empty())
+            {
+                ++m_numUnderrun;
+                continue;
+            }
+
+            auto buffer = m_input.front();
+            m_input.pop_front();
+            buffer->m_state = Buffer::Filling;
+
+            // configuration and rendering are done without the lock
+            const uint32_t width = static_cast<uint32_t>(cp.width->Value());
+            const uint32_t height = static_cast<uint32_t>(cp.height->Value());
+            const double incompleteProbability = cp.incompleteProbability->Value();
+            const bool incomplete = incompleteProbability > 0.0 && uniform(rng) < incompleteProbability;
+            lock.unlock();
+
+            auto format = FindPixelFormat(cp.pixelFormat->Value());
+            source.Configure(width, height, format, cp.testPattern->Value());
+            if (format != descrFormat)
+            {
+                IpxInitPixelTypeDescr(format->pixelType, &descr);
+                descrFormat = format;
+            }
+
+            const size_t rowSize = source.GetRowSize();
+            size_t rows = std::min<size_t>(height, buffer->GetBufferSize() / rowSize);
+            if (incomplete && rows)
+                rows = static_cast<size_t>(uniform(rng) * rows);
+
+            source.Fill(buffer->GetBufferPtr(), frameId, rows);
+            buffer->SetFrame(format, descr, width, height, rowSize, rows, frameId, timestamp);
+            m_stats.Update(frameId, timestamp, rows * rowSize, incomplete);
+
+            lock.lock();
+            ++m_numDelivered;
+
+            // push mode: the buffer is handed over to the callbacks, which return it by QueueBuffer
+            m_dispatched = buffer;
+            lock.unlock();
+            const size_t delivered = m_events.Fire(EventNewBuffer, buffer, rows * rowSize);
+            lock.lock();
+            m_dispatched = nullptr;
+            if (delivered)
+            {
+                if (buffer->m_state == Buffer::Filling)
+                    buffer->m_state = Buffer::Announced;
+                continue;
+            }
+
+            // the ring is filled under the lock, so the consumer falling back to the blocking wait never misses the buffer.
+            // After the ring overflowed, the buffers go to the output queue until the consumers empty it, to keep the order.
+            buffer->m_state = Buffer::Delivered;
+            if (!m_busyPoll || !m_output.empty() || !m_ring.Push(buffer))
+            {
+                m_output.push_back(buffer);
+                m_numOutput = m_output.size();
+            }
+            m_cvConsumer.notify_one();
+        }
+    }
+
+} // end of namespace IpxCamSim
+
+#endif // __cplusplus
+
+#endif // IPX_VIRTUAL_CAMERA_H
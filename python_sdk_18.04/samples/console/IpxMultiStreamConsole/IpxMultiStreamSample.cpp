@@ -11,9 +11,13 @@
 // Shows how to use IpxCam::Stream class object to acquire images.
 //
 #include "IpxCameraApi.h"
+#include "IpxFrameSync.h"
+#include "IpxStreamStats.h"
+#ifdef IPX_VIRTUAL_CAMERA
+#include "IpxVirtualCamera.h"
+#endif
 
 #include <set>
-#include <list>
 #include <ctime>
 #include <chrono>
 #include <cctype>
@@ -118,6 +122,7 @@ private:
 // Sync Values
 //////////////
 bool g_result = false;
+uint64_t g_syncTolerance = 0; // ns, 0 - independent streams
 std::atomic_bool g_isStop = ATOMIC_VAR_INIT(false);
 MutexFreeLock g_printLock;
 
@@ -156,8 +161,10 @@ std::vector<Camera> ConnectDevices( const std::vector<IpxCam::DeviceInfo*> &devi
 void SwitchOnTriggerMode( const std::vector<Camera> &cameras, IPrint *myPrint );
 void StartStreaming( std::vector<Camera> &cameras, IPrint *myPrint );
 void StopStreaming( const std::vector<Camera> &cameras, IPrint *myPrint );
+uint64_t SelectFrameSets();
 void GetSetParams( IpxCam::Device *device );
 bool AcquireImages( const Camera &camera, IPrint *myPrint );
+bool AcquireFrameSets( const std::vector<Camera> &cameras, IPrint *myPrint );
 std::string GetInterfaceTypeStr( IpxCam::Interface *iface );
 std::string GetAccessStatusStr( int32_t status );
 std::vector<std::string> split(const std::string& s, char delimiter);
@@ -169,7 +176,11 @@ uint32_t ValidateIpAddress( const std::string &ipAddress );
 int main()
 {
     // Get System
+#ifdef IPX_VIRTUAL_CAMERA
+    auto system = IpxCamSim::GetSystem(IpxCam::IpxCam_GetSystem());
+#else
     auto system = IpxCam::IpxCam_GetSystem();
+#endif
     if (system)
     {
         while (true)
@@ -197,6 +208,9 @@ int main()
                         SwitchOnTriggerMode(cameras, &myPrint);
                         std::cout << std::endl;
 
+                        // assemble synchronized frame sets if needed
+                        g_syncTolerance = cameras.size() > 1 ? SelectFrameSets() : 0;
+
                         // set default values for threads
                         g_isStop = false;
                         std::vector<std::thread> acqThreads;
@@ -208,8 +222,13 @@ int main()
                         std::cout << std::endl;
 
                         // start of acquisition threads
-                        for (auto &camera: cameras) // std::ref - so not to copy Camera object
-                            acqThreads.push_back(std::thread(AcquireImages, std::ref(camera), &myPrint));
+                        if (g_syncTolerance)
+                            acqThreads.push_back(std::thread(AcquireFrameSets, std::cref(cameras), &myPrint));
+                        else
+                        {
+                            for (auto &camera: cameras) // std::ref - so not to copy Camera object
+                                acqThreads.push_back(std::thread(AcquireImages, std::ref(camera), &myPrint));
+                        }
 
                         // wait for stop signal
                         // and stop acquisition threads
@@ -361,7 +380,11 @@ std::vector<Camera> ConnectDevices( const std::vector<IpxCam::DeviceInfo*> &devi
             continue;
         }
 
+#ifdef IPX_VIRTUAL_CAMERA
+        auto device = IpxCamSim::CreateDevice(deviceInfos[i]);
+#else
         auto device = IpxCam_CreateDevice(deviceInfos[i]);
+#endif
         if (device)
         {
             IpxCam::Stream *stream = nullptr;
@@ -578,6 +601,25 @@ void StopStreaming( const std::vector<Camera> &cameras, IPrint *myPrint )
     }
 }
 
+uint64_t SelectFrameSets()
+{
+    // ask if user wants to correlate frames of the cameras by their timestamps
+    std::cout << "\nWould you like to assemble synchronized frame sets?";
+    std::cout << "\nPress enter to leave as is or type [yn]: ";
+    std::string str;
+    std::getline(std::cin, str, '\n');
+    if (str.empty() || (str[0] != 'y' && str[0] != 'Y'))
+        return 0;
+
+    uint64_t tolerance = 1000; // us
+    std::cout << "Enter maximum spread of timestamps in the set in microseconds (default [1000]): ";
+    std::getline(std::cin, str, '\n');
+    if (!str.empty() && std::atoll(str.c_str()) > 0)
+        tolerance = (uint64_t)std::atoll(str.c_str());
+
+    return tolerance * 1000;
+}
+
 void GetSetParams( IpxCam::Device *device )
 {
     const char *indent = "    ";
@@ -803,7 +845,6 @@ void GetSetParams( IpxCam::Device *device )
 
 bool AcquireImages( const Camera &camera, IPrint *myPrint )
 {
-    auto timePoint = std::chrono::system_clock::now();
     auto id = camera.id;
     myPrint->print(id, "Acquisition thread has started\n");
 
@@ -815,34 +856,24 @@ bool AcquireImages( const Camera &camera, IPrint *myPrint )
     // determine how many ticks in one second
     // used to calculate FPS
     IpxCamErr err;
-    double timestampFreq = 1000000000.0; // second in nanoseconds
-    auto genParams = device->GetCameraParameters();
-    IpxGenParam::Int *tsFreqParam = genParams->GetInt("GevTimestampTickFrequency", &err);
-    if (tsFreqParam && err == IPX_CAM_ERR_OK)
-    {
-        timestampFreq = (double)tsFreqParam->GetValue(&err);
-        if (err != IPX_CAM_ERR_OK)
-            timestampFreq = 1000000000.0;
-    }
+    double timestampFreq = IpxCamStats::GetTickFrequency(device);
 
     // check if camera is in Trigger Mode
+    auto genParams = device->GetCameraParameters();
     auto valStr = genParams->GetEnumValueStr("TriggerMode");
     bool isInTrigger = valStr && std::string("On") == valStr;
 
     // calculate how many ticks should be between consecutive triggers
-    uint64_t ticksTrigFreq = isInTrigger ? (uint64_t)(timestampFreq * camera.trigFreq) : 0;
-    ticksTrigFreq += (ticksTrigFreq >> 1); // increase by half
+    // the statistics reports the intervals longer by half as lost trigger pulses
+    uint64_t ticksTrigPeriod = isInTrigger && camera.trigFreq > 0 ? (uint64_t)(timestampFreq / camera.trigFreq) : 0;
 
     // results
-    // just to have statistics and dump it at the end
-    std::list<uint64_t> drops;
-    std::list<uint64_t> trigLosts;
-    std::list<uint64_t> incompletes;
+    // drops, trigger losses and incompletes are detected while receiving, FPS and bandwidth are rolling
+    IpxCamStats::StreamStats stats(timestampFreq, ticksTrigPeriod);
 
     // real acquisition
     g_result = true;
-    uint64_t timestamp = 0, frameId = 0, frameIdPrev = 0, droped = 0, diff = 0, incomp = 0;
-    double bandwidth = .0, fps = .0;
+    auto timePoint = std::chrono::system_clock::now();
     for (decltype(images) i = 0; i < images; ++i)
     {
         if (g_isStop)
@@ -853,70 +884,34 @@ bool AcquireImages( const Camera &camera, IPrint *myPrint )
         {
             //auto imagePtr = static_cast<char*>(buffer->GetBufferPtr()) + buffer->GetImageOffset();
 
-            frameId = buffer->GetFrameID();
-            if (frameIdPrev < frameId)
-            {
-                diff = frameId - frameIdPrev - 1;
-                if (diff)
-                {
-                    droped += diff;
-                    drops.push_back(frameId);
-                }
-            }
-
-            std::string trigLost;
-
-            // timestamp of the first frame
-            if (timestamp)
-            {
-                // FPS and bandwidth as provided by camera
-                // not how many frames have been processed
-                diff = timestamp;
-                timestamp = buffer->GetTimestamp();
-                diff = timestamp - diff;
-
-                fps = diff ? timestampFreq / diff : .0; // camera provides
-                // (buffer->GetBufferSize() << 3) - in bits
-                bandwidth = fps * (buffer->GetBufferSize() << 3) / 1048576.0; // 1073741824
+            stats.Update(buffer);
+            auto width = buffer->GetWidth();
+            auto height = buffer->GetHeight();
 
-                if (isInTrigger && diff > ticksTrigFreq)
-                {
-                    trigLost = " ER";
-                    trigLosts.push_back(frameId);
-                }
-            }
-            else
-            {
-                timestamp = buffer->GetTimestamp();
-            }
-
-            if (buffer->IsIncomplete())
-            {
-                ++incomp;
-                incompletes.push_back(frameId);
-            }
-
-            frameIdPrev = frameId;
+            // re-queue the buffer in the stream object
+            stream->QueueBuffer(buffer);
 
+            // print the status 10 times per second, so that the console does not limit the frame rate
             auto curTimePoint = std::chrono::system_clock::now();
+            if (curTimePoint - timePoint < std::chrono::milliseconds(100))
+                continue;
+
             auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(curTimePoint - timePoint).count();
             timePoint = curTimePoint;
 
+            auto s = stats.GetSnapshot();
             std::ostringstream buf;
-            buf << "FID:"  << std::uppercase << std::hex << std::setfill('0') << std::setw(8) << (frameId&0xFFFFFFFF) << " "
-                << std::dec << std::setfill(' ') << std::setw(4) << buffer->GetWidth()<< "W "
-                << std::dec << std::setfill(' ') << std::setw(4) << buffer->GetHeight()<< "H "
-                << std::setfill(' ') << std::setw(7) << std::setprecision(2) << std::fixed << fps << "FPS "
-                << std::setfill(' ') << std::setw(7) << bandwidth << "MiB/s"
-                << " inc:" << incomp << " dr:" << droped << " dur:" << duration
-                << trigLost << "\n" << std::flush;
+            buf << "FID:"  << std::uppercase << std::hex << std::setfill('0') << std::setw(8) << (s.lastFrameId&0xFFFFFFFF) << " "
+                << std::dec << std::setfill(' ') << std::setw(4) << width << "W "
+                << std::dec << std::setfill(' ') << std::setw(4) << height << "H "
+                << std::setfill(' ') << std::setw(7) << std::setprecision(2) << std::fixed << s.fps << "FPS "
+                << std::setfill(' ') << std::setw(7) << s.bandwidth << "MiB/s"
+                << " inc:" << s.incomplete << " dr:" << s.dropped << " dur:" << duration
+                << (s.triggerLost ? " ER:" + std::to_string(s.triggerLost) : "") << "\n" << std::flush;
 
             myPrint->print(id, std::chrono::system_clock::to_time_t(timePoint),
                 std::chrono::duration_cast<std::chrono::milliseconds>(timePoint.time_since_epoch()).count() % 1000,
                 buf.str());
-
-            // re-queue the buffer in the stream object
-            stream->QueueBuffer(buffer);
         }
         else
         {
@@ -931,31 +926,120 @@ bool AcquireImages( const Camera &camera, IPrint *myPrint )
     }
 
     // dump statistics here
-    for (auto& drop: drops)
+    uint64_t lost = 0;
+    auto events = stats.GetEvents(&lost);
+    if (lost)
+        myPrint->print(id, "---" + std::to_string(lost) + " EARLIER EVENTS ARE NOT SHOWN\n");
+    for (auto& event: events)
     {
         std::ostringstream buf;
-        buf << "---DROPED FRAMES AFTER: " << std::uppercase << std::hex
-            << std::setfill('0') << std::setw(16) << drop << std::endl;
+        switch (event.type)
+        {
+        case IpxCamStats::EventGap:
+            buf << "---DROPED FRAMES(" << std::dec << event.count << ") BEFORE: ";
+            break;
+        case IpxCamStats::EventTriggerLost:
+            buf << "---LOOKS LIKE TRIGGER PULSE LOST/IGNORED BEFORE: ";
+            break;
+        default:
+            buf << "---INCOMPLETE FRAME ID: ";
+            break;
+        }
+        buf << std::uppercase << std::hex << std::setfill('0') << std::setw(16) << event.frameId << std::endl;
         myPrint->print(id, buf.str());
     }
-    for (auto& trigLost: trigLosts)
+
+    auto s = stats.GetSnapshot();
+    std::ostringstream buf;
+    buf << "---FRAMES: " << s.frames << " DROPED: " << s.dropped << " INCOMPLETE: " << s.incomplete
+        << " INTERVAL(us) min:" << s.minInterval / 1000 << " mean:" << s.meanInterval / 1000
+        << " p99:" << stats.GetIntervalPercentile(99.0) / 1000 << " max:" << s.maxInterval / 1000 << std::endl;
+    myPrint->print(id, buf.str());
+
+    myPrint->print(id, "Acquisition thread has stoped\n");
+
+    return g_result;
+}
+
+bool AcquireFrameSets( const std::vector<Camera> &cameras, IPrint *myPrint )
+{
+    myPrint->print("Frame set thread has started\n");
+
+    // only streaming cameras take part in the sets, the order of the frames is the order of the devices
+    std::vector<IpxCam::Device*> devices;
+    std::vector<uint32_t> ids;
+    for (auto &camera: cameras)
     {
-        std::ostringstream buf;
-        buf << "---LOOKS LIKE TRIGGER PULSE LOST/IGNORED BEFORE: " << std::uppercase
-            << std::hex << std::setfill('0') << std::setw(16) << trigLost << std::endl;
-        myPrint->print(id, buf.str());
+        if (!camera.isStreaming)
+            continue;
+        devices.push_back(camera.device);
+        ids.push_back(camera.id);
+    }
+
+    if (devices.size() < 2)
+    {
+        myPrint->print("At least two streaming cameras are needed for frame sets!\n");
+        return false;
+    }
+
+    // the timestamps are converted to the host clock by periodic latch of the camera clocks
+    IpxCamSync::SyncParams params;
+    params.tolerance = g_syncTolerance;
+    params.policy = IpxCamSync::StragglerFlag;
+    IpxCamSync::FrameSync sync(devices, params);
+    IpxCamErr err = sync.Start();
+    if (err != IPX_CAM_ERR_OK)
+    {
+        myPrint->print("Cannot latch camera timestamps, ERR = " + std::to_string(err) + "\n");
+        return false;
     }
-    for (auto& incomplete: incompletes)
+
+    uint64_t incomplete = 0;
+    while (!g_isStop)
     {
+        auto set = sync.GetFrameSet(1000, &err);
+        if (set.IsEmpty())
+        {
+            if (err != IPX_CAM_ERR_TIMEOUT)
+                break;
+            myPrint->print("No frame sets within 1 s\n");
+            continue;
+        }
+
+        if (!set.IsComplete())
+            ++incomplete;
+
+        // frame IDs of the cameras, '--------' - the camera has no frame in the set
         std::ostringstream buf;
-        buf << "---INCOMPLETE FRAME ID: " << std::uppercase
-            << std::hex << std::setfill('0') << std::setw(16) << incomplete << std::endl;
-        myPrint->print(id, buf.str());
+        buf << "SET:" << std::uppercase << std::hex << std::setfill('0') << std::setw(8) << (set.GetSetID()&0xFFFFFFFF)
+            << std::dec << std::setfill(' ') << " spread:" << std::setw(6) << set.GetSpread() / 1000 << "us FID:";
+        for (size_t i = 0; i < set.GetSize(); ++i)
+        {
+            if (set[i])
+                buf << " " << std::hex << std::setfill('0') << std::setw(8) << (set[i].GetFrameID()&0xFFFFFFFF);
+            else
+                buf << " --------";
+        }
+        buf << std::dec << (set.IsComplete() ? "" : " INCOMPLETE") << " inc:" << incomplete << "\n";
+        myPrint->print(buf.str());
+    }   // the buffers of the set are re-queued when the set is destroyed
+
+    sync.Stop();
+
+    // dump statistics here
+    for (size_t i = 0; i < sync.GetNumCameras(); ++i)
+    {
+        auto stats = sync.GetStats(i);
+        std::ostringstream buf;
+        buf << "---FRAMES: " << stats.received << " MATCHED: " << stats.matched << " STRAGGLERS: " << stats.stragglers
+            << " OVERFLOWS: " << stats.overflows << " CLOCK DRIFT: " << std::setprecision(3) << std::fixed
+            << stats.driftPpm << "ppm" << std::endl;
+        myPrint->print(ids[i], buf.str());
     }
 
-    myPrint->print(id, "Acquisition thread has stoped\n");
+    myPrint->print("Frame set thread has stoped\n");
 
-    return g_result;
+    return true;
 }
 
 std::string GetInterfaceTypeStr( IpxCam::Interface *iface )
@@ -1,3 +1,3 @@
 TEMPLATE = subdirs
 
-SUBDIRS = IpxStreamConsole IpxMultiStreamConsole IpxTriggerStreamWritingConsole
+SUBDIRS = IpxStreamConsole IpxMultiStreamConsole IpxTriggerStreamWritingConsole IpxUnpackBenchConsole
@@ -11,6 +11,9 @@
 // Shows how to use IpxCam::Stream class object to acquire images.
 //
 #include "IpxCameraApi.h"
+#ifdef IPX_VIRTUAL_CAMERA
+#include "IpxVirtualCamera.h"
+#endif
 
 #include <vector>
 #include <string>
@@ -43,7 +46,11 @@ bool g_result = false;
 int main()
 {
     // Get System
+#ifdef IPX_VIRTUAL_CAMERA
+	auto system = IpxCamSim::GetSystem(IpxCam::IpxCam_GetSystem());
+#else
 	auto system = IpxCam::IpxCam_GetSystem();
+#endif
     if (system)
     {
         while (true)
@@ -68,7 +75,11 @@ int main()
 
                     if (deviceInfo->GetAccessStatus() == IpxCam::DeviceInfo::AccessStatusReadWrite)
                     {
+#ifdef IPX_VIRTUAL_CAMERA
+                        auto device = IpxCamSim::CreateDevice(deviceInfo);
+#else
                         auto device = IpxCam_CreateDevice(deviceInfo);
+#endif
                         if (device)
                         {
                             std::cout << "Connecting to " << deviceName << " DONE\n\n";
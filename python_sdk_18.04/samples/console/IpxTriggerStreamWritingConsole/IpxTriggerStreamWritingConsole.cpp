@@ -14,7 +14,8 @@
 #include "IpxImage.h"
 #include "IpxImageApi.h"
 #include "IpxBayer.h"
-#include "IpxImageSerializer.h"
+#include "IpxImageSerializerAsync.h"
+#include "IpxFrame.h"
 
 #include <vector>
 #include <string>
@@ -37,15 +38,17 @@ void FreeDataStreamBuffers( IpxCam::Stream *stream, std::vector<IpxCam::Buffer *
 const char* GetAccessStatusStr( int32_t status );
 std::vector<std::string> split(const std::string& s, char delimiter);
 void ConfigureTrigger(IpxCam::Device *device);
-void WriteImage(IpxCam::Buffer *buff, uint64_t file_idx, int file_ext);
+void WriteImage(const IpxCamFrame::Frame &frame, uint64_t file_idx, int file_ext);
 IpxImage* CreateRgbImage(IpxImage *img);
 
 // sync values
 std::atomic_bool g_isStop(false);
 bool g_result = false;
 
-// Serializer
-IpxHandle g_Serializer = nullptr;
+// Serializer, writes the images on its own thread
+IpxImageSerializerAsync *g_Serializer = nullptr;
+// Number of the images waiting for the write, the stream gets as many extra buffers
+const int64_t g_writeQueueDepth = 8;
 
 // Bayer
 IpxHandle g_Bayer = nullptr;
@@ -104,7 +107,8 @@ int main()
                             g_imgFormIdx = (g_imgFormIdx>4) ? 0 : g_imgFormIdx;
 
 	                    // Create IpxImageSerializer and IpxBayer components
-                            g_Serializer = IpxImageSerializer_CreateComponent(false);
+                            g_Serializer = IpxImageSerializerAsync::CreateComponent(false);
+                            g_Serializer->GetComponent()->SetParamInt(ISP_ASYNC_QUEUE_DEPTH, g_writeQueueDepth);
                             g_Bayer = IpxBayer_CreateComponent();
 
                             IpxCam::Stream *stream = nullptr;
@@ -112,7 +116,7 @@ int main()
                             {
                                 std::vector<IpxCam::Buffer*> bufferList;
                                 auto bufSize = stream->GetBufferSize();
-                                auto minNumBuffers = stream->GetMinNumBuffers();
+                                auto minNumBuffers = stream->GetMinNumBuffers() + g_writeQueueDepth;
                                 for (size_t i = 0; i < minNumBuffers; ++i)
                                     bufferList.push_back(stream->CreateBuffer(bufSize, nullptr, nullptr));
 
@@ -146,7 +150,7 @@ int main()
                                 std::cout << "Unable to create a stream on" << deviceName << std::endl;
 
                             // Delete IpxImageSerializer and IpxBayer components
-                            IpxImageSerializer_DeleteComponent(g_Serializer);
+                            IpxImageSerializerAsync::DeleteComponent(g_Serializer);
                             IpxBayer_DeleteComponent(g_Bayer);
                         }
                         else
@@ -570,6 +574,8 @@ bool AcquireImages( IpxCam::Device *device, IpxCam::Stream *stream )
                 std::cout << "'AcquisitionStart' command sent\n";
 
                 g_result = true;
+                // the saved buffers are requeued by the frames after the write
+                IpxCamFrame::FrameQueue frames(stream);
                 uint64_t timestamp = 0, frameId = 0, frameIdPrev = 0, droped = 0, incomplete = 0;
                 double bandwidth = .0, fps = .0;
                 for (decltype(images) i = 0; i < images; ++i)
@@ -617,11 +623,13 @@ bool AcquireImages( IpxCam::Device *device, IpxCam::Stream *stream )
                         // save each i(th) file
                         if (every && (i % every) == 0)
                         {
-                            WriteImage(buffer, i, g_imgFormIdx);
+                            WriteImage(frames.Wrap(buffer), i, g_imgFormIdx);
+                        }
+                        else
+                        {
+                            // re-queue the buffer in the stream object
+                            stream->QueueBuffer(buffer);
                         }
-
-                        // re-queue the buffer in the stream object
-                        stream->QueueBuffer(buffer);
                     }
                     else
                     {
@@ -635,6 +643,19 @@ bool AcquireImages( IpxCam::Device *device, IpxCam::Stream *stream )
 
                 std::cout << std::endl;
 
+                // write the queued images, their buffers go back to the stream
+                g_Serializer->WaitWritten(UINT64_MAX);
+                int64_t written = 0, dropped = 0, queueHigh = 0, writeMax = 0;
+                g_Serializer->GetComponent()->GetParamInt(ISP_ASYNC_WRITTEN, &written);
+                g_Serializer->GetComponent()->GetParamInt(ISP_ASYNC_DROPPED, &dropped);
+                g_Serializer->GetComponent()->GetParamInt(ISP_ASYNC_QUEUE_HIGH, &queueHigh);
+                g_Serializer->GetComponent()->GetParamInt(ISP_ASYNC_WRITE_MAX, &writeMax);
+                std::cout << "Written: " << written << " dropped: " << dropped << " queue high: " << queueHigh
+                    << " max write: " << writeMax << "us" << std::endl;
+                auto writeErr = g_Serializer->GetWriteError();
+                if (writeErr != IPX_ERR_OK)
+                    std::cout << "Image writing failed, error code: " << writeErr << std::endl;
+
                 if (genParams->ExecuteCommand("AcquisitionStop") == IPX_CAM_ERR_OK)
                 {
                     std::cout << "'AcquisitionStop' command sent\n";
@@ -700,12 +721,12 @@ std::vector<std::string> split(const std::string& s, char delimiter)
    return tokens;
 }
 
-void WriteImage(IpxCam::Buffer *buff, uint64_t file_idx, int file_ext)
+void WriteImage(const IpxCamFrame::Frame &frame, uint64_t file_idx, int file_ext)
 {
 	IpxError err =IPX_CAM_ERR_OK;
 	
 	// Get IpxImage pointer
-	IpxImage *img = buff->GetImage();
+	IpxImage *img = frame.GetImage();
 
 	// Get extention string
 	const char* extention = g_FileExt[file_ext];
@@ -713,25 +734,12 @@ void WriteImage(IpxCam::Buffer *buff, uint64_t file_idx, int file_ext)
 	char filename[0x100];
 	snprintf(filename, 0x100, "Frame%" PRIu64 "%s", file_idx, extention);
 	
-	// RAW file saving 
-	if(file_ext == 0)
-	{
-		FILE *fp = fopen(filename, "wb");
-		if (fp)
-		{
-                        auto imagePtr = static_cast<char*>(buff->GetBufferPtr()) + buff->GetImageOffset();
-			fwrite(imagePtr, sizeof(char), buff->GetBufferSize(), fp);
-			fclose(fp);
-		}
-		return; // OK
-	}
-	
-	// Check if we have Mono format
-	if(img->pixelTypeDescr.pixelType == II_PIX_MONO8)
+	// RAW file and Mono images are written from the buffer, it is requeued after the write
+	if(file_ext == 0 || img->pixelTypeDescr.pixelType == II_PIX_MONO8)
 	{
-		err = IpxImageSerializer_Save(g_Serializer, img, filename);
+		err = g_Serializer->SaveFrame(frame, filename);
 		if (err != IPX_CAM_ERR_OK)
-			std::cout << "IpxImageSerializer_Save failed, error code: " << err << std::endl;
+			std::cout << "IpxImageSerializerAsync::SaveFrame failed, error code: " << err << std::endl;
 		return; // OK
 	}
 	
@@ -749,8 +757,8 @@ void WriteImage(IpxCam::Buffer *buff, uint64_t file_idx, int file_ext)
                         if (err != IPX_CAM_ERR_OK)
 				std::cout << "IpxBayer_ConvertImage failed, error code: " << err << std::endl;
 			
-			// Write converted image
-			err = IpxImageSerializer_Save(g_Serializer, imgRgb, filename);
+			// Write converted image, the image is copied to the queue
+			err = g_Serializer->Save(imgRgb, filename);
 			if (err != IPX_CAM_ERR_OK)
 				std::cout << "IpxImageSerializer_Save failed, filename: " << filename << " error code: " << err << std::endl;
 			
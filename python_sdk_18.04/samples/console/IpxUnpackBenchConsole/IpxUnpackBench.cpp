@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+// Imperx Camera SDK C++ Sample Code
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Imperx packed pixel unpacking benchmark (Console)
+// File: IpxUnpackBench.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Copyright (C) 2015-2026 Imperx Inc. All rights reserved.
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// Measures the throughput of the IpxUnpackKernels unpackers for every packed
+// mono format and every instruction set level supported by the CPU.
+// Usage: IpxUnpackBenchConsole [width] [height] [repeats]
+//
+#include "IpxUnpackCpu.h"
+
+#include <chrono>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+
+// Type Prototypes
+//////////////////
+struct PackedFormat
+{
+	uint32_t pixelType;
+	int taps;
+	const char *name;
+};
+
+// the Bayer types share the kernels of the mono types of the same layout
+static const PackedFormat s_formats[] =
+{
+	{ II_PIX_MONO10_PACKED_GEV, 1, "Mono10Packed (GEV)" },
+	{ II_PIX_MONO12_PACKED_GEV, 1, "Mono12Packed (GEV)" },
+	{ II_PIX_MONO10_PACKED_PFNC, 1, "Mono10p (PFNC)" },
+	{ II_PIX_MONO12_PACKED_PFNC, 1, "Mono12p (PFNC)" },
+	{ II_PIX_MONO8_PACKED_FLEX, 1, "Mono8 FLEX" },
+	{ II_PIX_MONO10_PACKED_FLEX, 1, "Mono10 FLEX" },
+	{ II_PIX_MONO12_PACKED_FLEX, 1, "Mono12 FLEX" },
+	{ II_PIX_MONO10_PACKED_FLEX, 8, "Mono10 FLEX 8-tap" },
+	{ II_PIX_MONO12_PACKED_FLEX, 2, "Mono12 FLEX 2-tap" },
+};
+
+// Function Prototypes
+//////////////////////
+template<typename T, typename Fn>
+double MeasureGBps( Fn fn, const std::vector<uint8_t> &src, size_t rowBytes, std::vector<T> &dst, int width, int height, int repeats )
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int r = 0; r < repeats; ++r)
+		for (int y = 0; y < height; ++y)
+			fn(&src[size_t(y) * rowBytes], &dst[size_t(y) * width], width);
+	const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return sec > 0.0 ? double(rowBytes) * height * repeats / sec / 1e9 : 0.0;
+}
+
+int main( int argc, char* argv[] )
+{
+	const int width = argc > 1 ? std::atoi(argv[1]) : 5120;
+	const int height = argc > 2 ? std::atoi(argv[2]) : 5120;
+	const int repeats = argc > 3 ? std::atoi(argv[3]) : 10;
+	if (width <= 0 || height <= 0 || repeats <= 0)
+	{
+		std::printf("Usage: %s [width] [height] [repeats]\n", argv[0]);
+		return 1;
+	}
+
+	std::printf("Image %dx%d, %d repeats, GB/s of the packed source\n", width, height, repeats);
+	std::printf("%-20s %-8s %10s %10s\n", "Format", "ISA", "to 16-bit", "to 8-bit");
+
+	std::vector<uint16_t> dst16(size_t(width) * height);
+	std::vector<uint8_t> dst8(size_t(width) * height);
+	for (const PackedFormat &format : s_formats)
+	{
+		const size_t rowBytes = IpxUnpackKernels::GetPackedRowBytes(format.pixelType, width, format.taps);
+		std::vector<uint8_t> src(rowBytes * height);
+		for (size_t i = 0; i < src.size(); ++i)
+			src[i] = static_cast<uint8_t>(i * 131 + (i >> 7));
+
+		for (int isa = IpxToolsImpl::IsaScalar; isa <= IpxToolsImpl::GetCpuIsa(); ++isa)
+		{
+			IpxUnpackKernels::Unpacker u;
+			if (!IpxUnpackKernels::GetUnpacker(format.pixelType, isa, &u, format.taps))
+				continue;
+			const double gb16 = MeasureGBps(u.to16, src, rowBytes, dst16, width, height, repeats);
+			const double gb8 = MeasureGBps(u.to8, src, rowBytes, dst8, width, height, repeats);
+			std::printf("%-20s %-8s %10.2f %10.2f\n", format.name, IpxToolsImpl::GetIsaName(isa), gb16, gb8);
+		}
+	}
+	return 0;
+}